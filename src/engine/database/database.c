@@ -47,6 +47,7 @@
 #include "os.h"
 #include "enginetask.h"
 #include "diag.h"
+#include "mcu.h"
 #include "string.h"
 
 /*================== Macros and Definitions ===============================*/
@@ -55,21 +56,188 @@
  */
 #define DATA_QUEUE_TIMEOUT_MS   10
 
+/**
+ * Maximum number of copy attempts of a reader before DB_ReadBlock() gives up.
+ * A retry is only needed if the database task published the block while the
+ * reader was copying it.
+ */
+#define DATA_READ_MAX_RETRIES   5
+
+/**
+ * Maximum time in milliseconds DB_ReadBlock() waits until the database task has
+ * published the writes of the block that were queued before the read.
+ * Can be overridden in database_cfg.h.
+ */
+#ifndef DATA_READ_TIMEOUT_MS
+#define DATA_READ_TIMEOUT_MS    10
+#endif
+
+/**
+ * Maximum number of readers that can borrow the same data block at the same time
+ */
+#define DATA_MAX_READ_BORROWS   255
+
+/**
+ * Maximum number of queue messages processed by one call of DATA_Task().
+ * Can be overridden in database_cfg.h.
+ */
+#ifndef DATA_QUEUE_DRAIN_BUDGET
+#define DATA_QUEUE_DRAIN_BUDGET     16
+#endif
+
+/**
+ * Maximum number of subscriptions registered with DB_Subscribe().
+ * Can be overridden in database_cfg.h.
+ */
+#ifndef DATA_MAX_SUBSCRIBERS
+#define DATA_MAX_SUBSCRIBERS        8
+#endif
+
+/**
+ * Memory barrier between the data of a block and its sequence counter.
+ * Can be defined in database_cfg.h for builds that do not run on the target.
+ */
+#ifndef DATA_MEMORY_BARRIER
+#define DATA_MEMORY_BARRIER()   __DMB()
+#endif
+
+/**
+ * Size in bytes of the arena in internal SRAM from which data blocks without
+ * buffer in their block header are allocated, 0 to disable the arena.
+ * Can be overridden in database_cfg.h.
+ */
+#ifndef DATA_INTERNAL_ARENA_SIZE
+#define DATA_INTERNAL_ARENA_SIZE    0
+#endif
+
+/**
+ * Minimum size in bytes of all buffers of a data block with DATA_PLACEMENT_AUTO
+ * to be allocated in external SDRAM. Can be overridden in database_cfg.h.
+ *
+ * External SDRAM is only used if DATA_EXTSDRAM_REGION_START and
+ * DATA_EXTSDRAM_REGION_SIZE are defined in database_cfg.h. SDRAM_Init() has to
+ * be called before the database task starts. The region has to be configured as
+ * normal memory (MPU or FMC bank swap), since unaligned accesses of memcpy()
+ * fault in the default device memory attributes of the FMC SDRAM banks.
+ */
+#ifndef DATA_EXTSDRAM_MIN_BLOCK_SIZE
+#define DATA_EXTSDRAM_MIN_BLOCK_SIZE    1024
+#endif
+
+/**
+ * Alignment in bytes of buffers allocated from the memory regions
+ */
+#define DATA_REGION_ALIGNMENT   8
+
+/**
+ * SysTick cycles per OS tick, see MCU_GetTimeBase() (downcounter, reload value 71999)
+ */
+#define DATA_TIMEBASE_CYCLES_PER_TICK   72000
+
+/**
+ * Period in milliseconds in which the statistics are written to the data block
+ * DATA_STATISTICS_BLOCK_ID, if it is defined in database_cfg.h
+ */
+#define DATA_STATISTICS_EXPORT_PERIOD_MS    1000
+
 /*================== Constant and Variable Definitions ====================*/
 // FIXME Some uninitialized variables
-static DATA_BASE_HEADER_DEV_s *data_block_devptr = (DATA_BASE_HEADER_DEV_s *)NULL_PTR;
 static DATA_BLOCK_ACCESS_s data_block_access[DATA_MAX_BLOCK_NR];
-static osMutexId data_base_mutex[DATA_MAX_BLOCK_NR];
+
+/**
+ * sequence counter over all data blocks, odd while the database task publishes
+ * one or more blocks. Used by DB_ReadBlockV() to get a consistent snapshot of
+ * several blocks. Only changed inside a critical section.
+ */
+static volatile uint32_t data_snapshot_seqcnt = 0;
+
+/**
+ * access statistics of the database, see DB_GetStatistics()
+ */
+static DATA_STATISTICS_s data_statistics;
+
+/**
+ * sum of the write latencies of each block, used to calculate the average
+ */
+static uint64_t data_latency_sum[DATA_MAX_BLOCK_NR];
+
+/**
+ * subscriptions registered with DB_Subscribe()
+ */
+static DATA_SUBSCRIBER_s data_subscribers[DATA_MAX_SUBSCRIBERS];
+
+/**
+ * number of used entries in data_subscribers
+ */
+static uint8_t data_nr_of_subscribers = 0;
+
+/**
+ * messages received by one call of DATA_Task()
+ */
+static DATA_QUEUE_MESSAGE_s data_batch[DATA_QUEUE_DRAIN_BUDGET];
+
+/**
+ * index of the last message in data_batch that writes a data block
+ */
+static uint8_t data_batch_lastwrite[DATA_MAX_BLOCK_NR];
+
+/**
+ * TRUE for the data blocks published by the current call of DATA_WriteBlocks()
+ */
+static uint8_t data_block_published[DATA_MAX_BLOCK_NR];
+
+#ifdef DATA_STATISTICS_BLOCK_ID
+/**
+ * time stamp of the last export of the statistics to DATA_STATISTICS_BLOCK_ID
+ */
+static uint32_t data_statistics_exporttime = 0;
+
+/**
+ * statistics published to DATA_STATISTICS_BLOCK_ID, including the average latencies
+ */
+static DATA_STATISTICS_s data_statistics_export;
+#endif
+
+#if DATA_INTERNAL_ARENA_SIZE > 0
+/**
+ * arena in internal SRAM for data blocks with DATA_PLACEMENT_INTERNAL
+ */
+static uint64_t data_internal_arena[(DATA_INTERNAL_ARENA_SIZE + 7) / 8];
+#endif
+
+/**
+ * memory regions for data blocks whose block header has no buffer
+ */
+static DATA_REGION_s data_region[DATA_REGION_NR];
 
 /**
  * state of database task: 0: not initialized,     1:  database ready
  */
 static uint8_t data_state = 0;
 
+/**
+ * task that runs DATA_Task(), it does not wait for queued writes in DB_ReadBlockAfterWrites()
+ */
+static TaskHandle_t data_taskhandle = NULL_PTR;
+
 
 
 /*================== Function Prototypes ==================================*/
-static void DATA_Init(DATA_BASE_HEADER_DEV_s* devptr);
+static void DATA_Init(void);
+static void DATA_BeginUpdate(DATA_BLOCK_ID_TYPE_e blockID);
+static void DATA_EndUpdate(DATA_BLOCK_ID_TYPE_e blockID);
+static uint8_t DATA_PublishBlock(DATA_BLOCK_ID_TYPE_e blockID);
+static void DATA_WriteBlocks(const DATA_BLOCK_VECTOR_s *vector, uint8_t nr_of_blocks, uint32_t timestamp);
+static uint32_t DATA_GetCycleCount(void);
+static void DATA_CountRead(DATA_BLOCK_ID_TYPE_e blockID, uint8_t retries, STD_RETURN_TYPE_e result);
+static void DATA_CountLatency(DATA_BLOCK_ID_TYPE_e blockID, uint32_t latency);
+static void DATA_NotifySubscribers(DATA_BLOCK_ID_TYPE_e blockID);
+static uint8_t DATA_IsWrittenLater(const DATA_BLOCK_VECTOR_s *vector, uint8_t index, uint8_t nr_of_blocks);
+static void DATA_InitRegions(void);
+static void DATA_CountQueuedWrite(DATA_BLOCK_ID_TYPE_e blockID, STD_RETURN_TYPE_e result);
+static void DATA_CountProcessedWrites(const DATA_QUEUE_MESSAGE_s *message);
+static STD_RETURN_TYPE_e DATA_WaitForQueuedWrites(DATA_BLOCK_ID_TYPE_e blockID);
+static void *DATA_AllocateBlock(DATA_BLOCK_ID_TYPE_e blockID, uint32_t size);
 
 /*================== Function Implementations =============================*/
 
@@ -99,94 +267,173 @@ void DB_WriteBlock(void *dataptrfromSender, DATA_BLOCK_ID_TYPE_e  blockID)
     data_send_msg.blockID = blockID;
     data_send_msg.value.voidptr = dataptrfromSender;
     data_send_msg.accesstype = WRITE_ACCESS;
+    data_send_msg.nr_of_blocks = 0;
+    data_send_msg.timestamp = DATA_GetCycleCount();
+    // reads of the block wait for this write from now on
+    DATA_CountQueuedWrite(blockID, E_OK);
     // Send a pointer to a message object and
     // maximum block time: queuetimeout
-    xQueueSend( data_queueID, (void *) &data_send_msg, queuetimeout);
+    if(xQueueSend( data_queueID, (void *) &data_send_msg, queuetimeout) != pdTRUE)
+    {
+        OS_TaskEnter_Critical();
+        data_statistics.nr_of_queue_timeouts++;
+        OS_TaskExit_Critical();
+        DATA_CountQueuedWrite(blockID, E_NOT_OK);
+    }
  }
 
 
+void DB_WriteBlockV(const DATA_BLOCK_VECTOR_s *vector, uint8_t nr_of_blocks)
+{
+    DATA_QUEUE_MESSAGE_s data_send_msg;
+    TickType_t queuetimeout;
+    uint8_t i;
+
+    if( vPortCheckCriticalSection() )
+    {
+        configASSERT(0);
+    }
+
+    if((vector == NULL_PTR) || (nr_of_blocks == 0))
+    {
+        return;
+    }
+
+    queuetimeout = DATA_QUEUE_TIMEOUT_MS / portTICK_RATE_MS;
+    if (queuetimeout  ==  0)
+    {
+        queuetimeout = 1;
+    }
+
+    // one message for all blocks, the database task publishes them together
+    data_send_msg.blockID = vector[0].blockID;
+    data_send_msg.value.voidptr = (void *)vector;
+    data_send_msg.accesstype = WRITE_ACCESS;
+    data_send_msg.nr_of_blocks = nr_of_blocks;
+    data_send_msg.timestamp = DATA_GetCycleCount();
+    for(i = 0; i < nr_of_blocks; i++)
+    {
+        DATA_CountQueuedWrite(vector[i].blockID, E_OK);
+    }
+    if(xQueueSend( data_queueID, (void *) &data_send_msg, queuetimeout) != pdTRUE)
+    {
+        OS_TaskEnter_Critical();
+        data_statistics.nr_of_queue_timeouts++;
+        OS_TaskExit_Critical();
+        for(i = 0; i < nr_of_blocks; i++)
+        {
+            DATA_CountQueuedWrite(vector[i].blockID, E_NOT_OK);
+        }
+    }
+}
+
+
 void DATA_Task(void) {
-    DATA_QUEUE_MESSAGE_s receive_msg;
-    void *srcdataptr;
-    void *dstdataptr;
-    DATA_BLOCK_ID_TYPE_e blockID;
-    DATA_BLOCK_ACCESS_TYPE_e    accesstype; /* read or write access type */
-    uint16_t datalength;
-    DATA_BLOCK_CONSISTENCY_TYPE_e buffertype;
+    DATA_BLOCK_VECTOR_s single_block;
+    const DATA_BLOCK_VECTOR_s *vector;
+    uint32_t queuelevel;
+    TickType_t blocktime;
+    uint8_t nr_of_messages;
+    uint8_t m;
+    uint8_t i;
 
     if(data_state == 0)
     {
-        DATA_Init(&data_base_dev);
+        data_taskhandle = xTaskGetCurrentTaskHandle();
+        DATA_Init();
+        /* make sure the access pointers are visible before readers are allowed to use them */
+        DATA_MEMORY_BARRIER();
         data_state=1;
     }
 
     if(data_queueID != NULL_PTR)
     {
-        if( xQueueReceive(data_queueID,(&receive_msg),(TickType_t ) 1) )  // scan queue and wait for a message up to a maximum amount of 1ms (block time)
+        queuelevel = uxQueueMessagesWaiting(data_queueID);
+        if(queuelevel > data_statistics.queue_highwatermark)
         {
-            // ptrrcvmessage now points to message of sender which contains data pointer and data block ID
-            blockID = receive_msg.blockID;
-            srcdataptr = receive_msg.value.voidptr;
-            accesstype = receive_msg.accesstype;
-            if((blockID < DATA_MAX_BLOCK_NR) && (srcdataptr != NULL_PTR))    // plausibility check
-            {    // get entries of blockheader and write pointer
-                if(accesstype == WRITE_ACCESS)
-                {   // write access to data blocks
-                    datalength = (data_block_devptr->blockheaderptr + blockID)->datalength;
-                    buffertype = (data_block_devptr->blockheaderptr + blockID)->buffertype;
-                    dstdataptr=data_block_access[blockID].WRptr;
-
-                    /* Check if there any read accesses taking place (in tasks with lower priorities)*/
-                    if(xSemaphoreTake(data_base_mutex[blockID], 0)  ==  TRUE)
-                    {
-                        memcpy(dstdataptr, srcdataptr, datalength);
-                        xSemaphoreGive(data_base_mutex[blockID]);
-                        if(buffertype  ==  DOUBLE_BUFFERING)
-                        {   /* swap the WR and RD pointers:
-                               WRptr always points to buffer to be written next time and changed afterwards
-                               RDptr always points to buffer to be read next time */
-                            data_block_access[blockID].WRptr=data_block_access[blockID].RDptr;
-                            data_block_access[blockID].RDptr=dstdataptr;
-                        }
-                    }
-                    else
+            data_statistics.queue_highwatermark = queuelevel;
+        }
+
+        /* receive all pending messages up to the budget, wait for the first
+           one up to a maximum amount of 1ms (block time) */
+        nr_of_messages = 0;
+        blocktime = 1;
+        while((nr_of_messages < DATA_QUEUE_DRAIN_BUDGET) &&
+                (xQueueReceive(data_queueID, &data_batch[nr_of_messages], blocktime) == pdTRUE))
+        {
+            nr_of_messages++;
+            blocktime = 0;
+        }
+
+        /* find the last write of each block, earlier writes of the same
+           block in this batch would be overwritten anyway */
+        for(m = 0; m < nr_of_messages; m++)
+        {
+            if(data_batch[m].accesstype == WRITE_ACCESS)
+            {
+                if(data_batch[m].nr_of_blocks == 0)
+                {
+                    if(data_batch[m].blockID < DATA_MAX_BLOCK_NR)
                     {
-                        dstdataptr=data_block_access[blockID].WRptr;
+                        data_batch_lastwrite[data_batch[m].blockID] = m;
                     }
                 }
-                else if(accesstype == READ_ACCESS)
-                {   // Read access to data blocks
-                    datalength = (data_block_devptr->blockheaderptr + blockID)->datalength;
-                    buffertype = (data_block_devptr->blockheaderptr + blockID)->buffertype;
-                    dstdataptr = srcdataptr;
-
-                    if(buffertype  ==  DOUBLE_BUFFERING)
+                else
+                {
+                    vector = (const DATA_BLOCK_VECTOR_s *)data_batch[m].value.voidptr;
+                    for(i = 0; i < data_batch[m].nr_of_blocks; i++)
                     {
-                        if(xSemaphoreTake(data_base_mutex[blockID], 0)  ==  TRUE)
+                        if(vector[i].blockID < DATA_MAX_BLOCK_NR)
                         {
-                            srcdataptr = data_block_access[blockID].RDptr;
-                            if(srcdataptr != NULL_PTR)
-                            {
-                                memcpy(dstdataptr, srcdataptr, datalength);
-                                xSemaphoreGive(data_base_mutex[blockID]);
-                            }
+                            data_batch_lastwrite[vector[i].blockID] = m;
                         }
                     }
-                    else if(buffertype  ==  SINGLE_BUFFERING)
+                }
+            }
+        }
+
+        for(m = 0; m < nr_of_messages; m++)
+        {
+            if(data_batch[m].accesstype == WRITE_ACCESS)
+            {
+                if(data_batch[m].nr_of_blocks == 0)
+                {   // single block: value contains the data pointer of the sender
+                    if((data_batch[m].blockID < DATA_MAX_BLOCK_NR) && (data_batch_lastwrite[data_batch[m].blockID] != m))
+                    {   // written again later in this batch
+                        data_statistics.block[data_batch[m].blockID].nr_of_coalesced_writes++;
+                    }
+                    else
                     {
-                            srcdataptr = data_block_access[blockID].RDptr;
-                            if(srcdataptr != NULL_PTR)
-                            {
-                                memcpy(dstdataptr, srcdataptr, datalength);
-                            }
+                        single_block.blockID = data_batch[m].blockID;
+                        single_block.dataptr = data_batch[m].value.voidptr;
+                        DATA_WriteBlocks(&single_block, 1, data_batch[m].timestamp);
                     }
                 }
                 else
-                {
-                    ;
+                {   /* several blocks: value points to the vector of the sender.
+                       Vectors are always written completely to keep them consistent. */
+                    DATA_WriteBlocks((const DATA_BLOCK_VECTOR_s *)data_batch[m].value.voidptr, data_batch[m].nr_of_blocks, data_batch[m].timestamp);
                 }
             }
         }
+
+        /* all writes of the batch are published, coalesced or dropped,
+           readers waiting for them can continue */
+        for(m = 0; m < nr_of_messages; m++)
+        {
+            DATA_CountProcessedWrites(&data_batch[m]);
+        }
+
+#ifdef DATA_STATISTICS_BLOCK_ID
+        if((uint32_t)(MCU_GetTimeStamp() - data_statistics_exporttime) >= DATA_STATISTICS_EXPORT_PERIOD_MS)
+        {   // publish the statistics directly, without passing through the queue
+            data_statistics_exporttime = MCU_GetTimeStamp();
+            DB_GetStatistics(&data_statistics_export);
+            single_block.blockID = DATA_STATISTICS_BLOCK_ID;
+            single_block.dataptr = &data_statistics_export;
+            DATA_WriteBlocks(&single_block, 1, DATA_GetCycleCount());
+        }
+#endif
         DIAG_SysMonNotify(DIAG_SYSMON_DATABASE_ID, 0);        // task is running, state = ok
     }
 }
@@ -194,40 +441,311 @@ void DATA_Task(void) {
 
 STD_RETURN_TYPE_e DB_ReadBlock(void *dataptrtoReceiver, DATA_BLOCK_ID_TYPE_e  blockID)
 {
-    DATA_QUEUE_MESSAGE_s data_send_msg;
-    TickType_t queuetimeout;
+    STD_RETURN_TYPE_e retVal = E_NOT_OK;
+    uint32_t seqcnt;
+    uint16_t datalength;
+    uint8_t retries;
 
-    if(vPortCheckCriticalSection())
+    if((data_state == 0) || (blockID >= DATA_MAX_BLOCK_NR) || (dataptrtoReceiver == NULL_PTR))
     {
-        configASSERT(0);
+        return E_NOT_OK;
     }
 
-    queuetimeout = DATA_QUEUE_TIMEOUT_MS / portTICK_RATE_MS;
-    if (queuetimeout  ==  0)
+    datalength = data_block_descriptor[blockID].datalength;
+
+    /* Copy the block in the context of the caller. The copy is only valid if
+     * no update was in progress when it started (even sequence counter) and
+     * no update was published while it was running (unchanged sequence counter). */
+    for(retries = 0; retries < DATA_READ_MAX_RETRIES; retries++)
     {
-        queuetimeout = 1;
+        seqcnt = data_block_access[blockID].seqcnt;
+        if((seqcnt & 1) == 0)
+        {
+            DATA_MEMORY_BARRIER();
+            memcpy(dataptrtoReceiver, data_block_access[blockID].RDptr, datalength);
+            DATA_MEMORY_BARRIER();
+            if(seqcnt == data_block_access[blockID].seqcnt)
+            {
+                retVal = E_OK;
+                break;
+            }
+        }
     }
 
-    // prepare send message with attributes of data block
-    data_send_msg.blockID = blockID;
-    data_send_msg.value.voidptr = dataptrtoReceiver;
-    data_send_msg.accesstype = READ_ACCESS;
+    DATA_CountRead(blockID, retries, retVal);
+    if(retries > 0)
+    {   /* each repeated copy overlapped a publish of the block, the former mutex
+           based implementation would have dropped the write */
+        OS_TaskEnter_Critical();
+        data_statistics.block[blockID].nr_of_collisions += retries;
+        OS_TaskExit_Critical();
+    }
 
+    return retVal;
+}
 
- 
-    // Send a pointer to a message object and
-    // maximum block time: queuetimeout
-    xQueueSend( data_queueID, (void *) &data_send_msg, queuetimeout);
 
+STD_RETURN_TYPE_e DB_ReadBlockAfterWrites(void *dataptrtoReceiver, DATA_BLOCK_ID_TYPE_e  blockID)
+{
+    if((data_state == 0) || (blockID >= DATA_MAX_BLOCK_NR) || (dataptrtoReceiver == NULL_PTR))
+    {
+        return E_NOT_OK;
+    }
+
+    if(DATA_WaitForQueuedWrites(blockID) != E_OK)
+    {
+        DATA_CountRead(blockID, 0, E_NOT_OK);
+        return E_NOT_OK;
+    }
+
+    return DB_ReadBlock(dataptrtoReceiver, blockID);
+}
 
 
-    return E_OK;
+STD_RETURN_TYPE_e DB_ReadBlockV(const DATA_BLOCK_VECTOR_s *vector, uint8_t nr_of_blocks)
+{
+    STD_RETURN_TYPE_e retVal = E_NOT_OK;
+    uint32_t seqcnt;
+    uint8_t retries;
+    uint8_t i;
+
+    if((data_state == 0) || (vector == NULL_PTR))
+    {
+        return E_NOT_OK;
+    }
+
+    for(i = 0; i < nr_of_blocks; i++)
+    {
+        if((vector[i].blockID >= DATA_MAX_BLOCK_NR) || (vector[i].dataptr == NULL_PTR))
+        {
+            return E_NOT_OK;
+        }
+    }
+
+    /* Same as DB_ReadBlock(), but the copies of all blocks are only valid if the
+     * database task published no block at all while they were made. */
+    for(retries = 0; retries < DATA_READ_MAX_RETRIES; retries++)
+    {
+        seqcnt = data_snapshot_seqcnt;
+        if((seqcnt & 1) == 0)
+        {
+            DATA_MEMORY_BARRIER();
+            for(i = 0; i < nr_of_blocks; i++)
+            {
+                memcpy(vector[i].dataptr, data_block_access[vector[i].blockID].RDptr,
+                        data_block_descriptor[vector[i].blockID].datalength);
+            }
+            DATA_MEMORY_BARRIER();
+            if(seqcnt == data_snapshot_seqcnt)
+            {
+                retVal = E_OK;
+                break;
+            }
+        }
+    }
+
+    for(i = 0; i < nr_of_blocks; i++)
+    {
+        DATA_CountRead(vector[i].blockID, retries, retVal);
+    }
+
+    return retVal;
+}
+
+
+void * DB_BorrowWrite(DATA_BLOCK_ID_TYPE_e  blockID)
+{
+    void *dataptr = NULL_PTR;
+
+    if((data_state == 0) || (blockID >= DATA_MAX_BLOCK_NR) ||
+            (data_block_descriptor[blockID].buffertype == SINGLE_BUFFERING))
+    {
+        return NULL_PTR;
+    }
+
+    OS_TaskEnter_Critical();
+    if((data_block_access[blockID].wrborrowed == FALSE) && (data_block_access[blockID].wrclaimed == FALSE))
+    {
+        data_block_access[blockID].wrborrowed = TRUE;
+        dataptr = data_block_access[blockID].WRptr;
+    }
+    OS_TaskExit_Critical();
+
+    return dataptr;
+}
+
+
+STD_RETURN_TYPE_e DB_Commit(DATA_BLOCK_ID_TYPE_e  blockID)
+{
+    STD_RETURN_TYPE_e retVal = E_NOT_OK;
+    uint8_t published = FALSE;
+
+    if((data_state == 0) || (blockID >= DATA_MAX_BLOCK_NR))
+    {
+        return E_NOT_OK;
+    }
+
+    OS_TaskEnter_Critical();
+    if(data_block_access[blockID].wrborrowed == TRUE)
+    {
+        data_block_access[blockID].wrborrowed = FALSE;
+        published = DATA_PublishBlock(blockID);
+        retVal = E_OK;
+    }
+    OS_TaskExit_Critical();
+
+    if(published == TRUE)
+    {
+        DATA_NotifySubscribers(blockID);
+    }
+
+    return retVal;
+}
+
+
+const void * DB_BorrowRead(DATA_BLOCK_ID_TYPE_e  blockID)
+{
+    const void *dataptr = NULL_PTR;
+
+    if((data_state == 0) || (blockID >= DATA_MAX_BLOCK_NR) ||
+            (data_block_descriptor[blockID].buffertype == SINGLE_BUFFERING))
+    {
+        return NULL_PTR;
+    }
+
+    OS_TaskEnter_Critical();
+    if(data_block_access[blockID].rdborrowcnt < DATA_MAX_READ_BORROWS)
+    {
+        if(data_block_access[blockID].rdborrowcnt == 0)
+        {
+            data_block_access[blockID].RDborrowptr = data_block_access[blockID].RDptr;
+        }
+        data_block_access[blockID].rdborrowcnt++;
+        dataptr = data_block_access[blockID].RDborrowptr;
+    }
+    OS_TaskExit_Critical();
+
+    return dataptr;
+}
+
+
+STD_RETURN_TYPE_e DB_Release(DATA_BLOCK_ID_TYPE_e  blockID)
+{
+    STD_RETURN_TYPE_e retVal = E_NOT_OK;
+    uint8_t published = FALSE;
+
+    if((data_state == 0) || (blockID >= DATA_MAX_BLOCK_NR))
+    {
+        return E_NOT_OK;
+    }
+
+    OS_TaskEnter_Critical();
+    if(data_block_access[blockID].rdborrowcnt > 0)
+    {
+        data_block_access[blockID].rdborrowcnt--;
+        if((data_block_access[blockID].rdborrowcnt == 0) && (data_block_access[blockID].publishpending == TRUE) &&
+                (data_block_access[blockID].wrclaimed == FALSE) && (data_block_access[blockID].wrborrowed == FALSE))
+        {   /* the last reader is gone, publish the data written in the meantime. If the
+               database task or a producer of DB_BorrowWrite() is writing newer data to
+               the same buffer, the block is published by DATA_WriteBlocks() or DB_Commit(). */
+            published = DATA_PublishBlock(blockID);
+        }
+        retVal = E_OK;
+    }
+    OS_TaskExit_Critical();
+
+    if(published == TRUE)
+    {
+        DATA_NotifySubscribers(blockID);
+    }
+
+    return retVal;
+}
+
+
+void DB_GetRegionUsage(DATA_REGION_e region, DATA_REGION_s *usage)
+{
+    if((region < DATA_REGION_NR) && (usage != NULL_PTR))
+    {
+        *usage = data_region[region];
+    }
+}
+
+
+uint32_t DB_GetBlockVersion(DATA_BLOCK_ID_TYPE_e  blockID)
+{
+    if(blockID >= DATA_MAX_BLOCK_NR)
+    {
+        return 0;
+    }
+    // the sequence counter is advanced by two for each published update
+    return data_block_access[blockID].seqcnt >> 1;
 }
 
-// FIXME not used  currently - delete?
-void * DATA_GetTablePtrBeginCritical(DATA_BLOCK_ID_TYPE_e  blockID) {
-    //FIXME block with semaphore
-    return data_block_access[blockID].RDptr;
+
+STD_RETURN_TYPE_e DB_Subscribe(DATA_BLOCK_ID_TYPE_e  blockID, DATA_SUBSCRIBER_CALLBACK_f callback, void *taskhandle)
+{
+    STD_RETURN_TYPE_e retVal = E_NOT_OK;
+
+    if((blockID >= DATA_MAX_BLOCK_NR) || ((callback == NULL_PTR) && (taskhandle == NULL_PTR)))
+    {
+        return E_NOT_OK;
+    }
+
+    OS_TaskEnter_Critical();
+    if(data_nr_of_subscribers < DATA_MAX_SUBSCRIBERS)
+    {
+        data_subscribers[data_nr_of_subscribers].blockID = blockID;
+        data_subscribers[data_nr_of_subscribers].callback = callback;
+        data_subscribers[data_nr_of_subscribers].taskhandle = taskhandle;
+        data_subscribers[data_nr_of_subscribers].version = DB_GetBlockVersion(blockID);
+        data_nr_of_subscribers++;
+        retVal = E_OK;
+    }
+    OS_TaskExit_Critical();
+
+    return retVal;
+}
+
+
+uint32_t DB_GetWriteCollisionCount(DATA_BLOCK_ID_TYPE_e  blockID)
+{
+    if(blockID >= DATA_MAX_BLOCK_NR)
+    {
+        return 0;
+    }
+    return data_statistics.block[blockID].nr_of_collisions;
+}
+
+
+void DB_GetStatistics(DATA_STATISTICS_s *statistics)
+{
+    uint8_t c;
+
+    if(statistics == NULL_PTR)
+    {
+        return;
+    }
+
+    OS_TaskEnter_Critical();
+    for(c = 0; c < DATA_MAX_BLOCK_NR; c++)
+    {
+        if(data_statistics.block[c].nr_of_writes > 0)
+        {
+            data_statistics.block[c].latency_avg = (uint32_t)(data_latency_sum[c] / data_statistics.block[c].nr_of_writes);
+        }
+    }
+    memcpy(statistics, &data_statistics, sizeof(DATA_STATISTICS_s));
+    OS_TaskExit_Critical();
+}
+
+
+void DB_ResetStatistics(void)
+{
+    OS_TaskEnter_Critical();
+    memset(&data_statistics, 0, sizeof(DATA_STATISTICS_s));
+    memset(data_latency_sum, 0, sizeof(data_latency_sum));
+    OS_TaskExit_Critical();
 }
 
 /*================== Static functions =====================================*/
@@ -235,47 +753,613 @@ void * DATA_GetTablePtrBeginCritical(DATA_BLOCK_ID_TYPE_e  blockID) {
 /**
  * @brief   Initialization of database manager
  *
- * @param   devptr (type: DATA_BASE_HEADER_DEV_s) pointer to device configuration
+ * Initialises the read and write pointers and the sequence counter of each
+ * data block. The buffers of a block are stored one after the other, each buffer
+ * is datalength bytes long. Blocks without buffer in data_block_descriptor are
+ * allocated from the memory regions, their buffers are aligned to DATA_REGION_ALIGNMENT.
  *
  * @return  void
  */
-static void DATA_Init(DATA_BASE_HEADER_DEV_s *devptr) {
+static void DATA_Init(void) {
+    const DATA_BASE_HEADER_s *header;
+    uint32_t stride;
     uint8_t c = 0;
-    if(devptr != NULL_PTR) {
-        data_block_devptr = devptr;
-    }
-    else {
-        // todo fatal error!
-    }
-    // FIXME What is mymessage structures?
-    /* Create a queue capable of containing 10 pointers to mymessage structures.
-//    These should be passed by pointer as they contain a lot of data. */
-//    data_queueID = xQueueCreate( devptr->nr_of_blockheader, sizeof( DATA_QUEUE_MESSAGE_s) );    // FIXME number of queues=1 should be enough
-//
-//    if(data_queueID  ==  NULL_PTR) {
-//        // Failed to create the queue
-//        ;            // @ TODO Error Handling
-//    }
-    // FIXME in comparison to the missing comments inside the for loop, the next comment is relatively trivial
-    /* for data block access control:
-     * initialise read and write pointers and
-     * create a Mutex for each block
-     */
-    // FIXME this is the only place where nr_of_blockheader is used so why not just use here the sizeof/sizeof and delete DATA_BASE_HEADER_DEV_s
-    for(c=0;c<devptr->nr_of_blockheader;c++)
-    {
-        // FIXME data_block_access has DATA_MAX_BLOCK_NR array elements, but for loop iterates over nr_of_blockheaders, why is this not the same?
-        data_block_access[c].WRptr = (void*)*(uint32_t*)(devptr->blockheaderptr + c);
-        if((devptr->blockheaderptr + c)->buffertype  ==  DOUBLE_BUFFERING)
+
+    DATA_InitRegions();
+    for(c=0;c<DATA_MAX_BLOCK_NR;c++)
+    {
+        header = &data_block_descriptor[c];
+        data_block_access[c].RDborrowptr = NULL_PTR;
+        data_block_access[c].seqcnt = 0;
+        data_block_access[c].wrborrowed = FALSE;
+        data_block_access[c].wrclaimed = FALSE;
+        data_block_access[c].rdborrowcnt = 0;
+        data_block_access[c].publishpending = FALSE;
+
+        data_block_access[c].WRptr = header->blockptr;
+        stride = header->datalength;
+        if(header->blockptr == NULL_PTR)
+        {
+            stride = (stride + (DATA_REGION_ALIGNMENT - 1)) & ~(uint32_t)(DATA_REGION_ALIGNMENT - 1);
+            // the consistency type is the number of buffers of the block
+            data_block_access[c].WRptr = DATA_AllocateBlock((DATA_BLOCK_ID_TYPE_e)c, stride * (uint32_t)header->buffertype);
+            configASSERT(data_block_access[c].WRptr != NULL_PTR);
+        }
+        if(header->buffertype  ==  DOUBLE_BUFFERING)
+        {
+            data_block_access[c].RDptr = (uint8_t *)data_block_access[c].WRptr + stride;
+            data_block_access[c].SPptr = NULL_PTR;
+        }
+        else if(header->buffertype  ==  TRIPLE_BUFFERING)
         {
-            // FIXME a comment would be good to understand the pointer magic here
-            data_block_access[c].RDptr = (void*)((uint32_t)data_block_access[c].WRptr + (devptr->blockheaderptr + c)->datalength);
+            data_block_access[c].RDptr = (uint8_t *)data_block_access[c].WRptr + stride;
+            data_block_access[c].SPptr = (uint8_t *)data_block_access[c].RDptr + stride;
         }
         else
         {
             data_block_access[c].RDptr = data_block_access[c].WRptr;
+            data_block_access[c].SPptr = NULL_PTR;
+        }
+    }
+}
+
+
+/**
+ * @brief   marks the start of an update of a data block
+ *
+ * Makes the sequence counter of the block odd. Readers do not use a copy
+ * that was started or finished while the counter was odd.
+ *
+ * @param   blockID (type: DATA_BLOCK_ID_TYPE_e) ID of the data block that is updated
+ *
+ * @return  void
+ */
+static void DATA_BeginUpdate(DATA_BLOCK_ID_TYPE_e blockID) {
+    data_block_access[blockID].seqcnt++;
+    DATA_MEMORY_BARRIER();
+}
+
+
+/**
+ * @brief   marks the end of an update of a data block
+ *
+ * Makes the sequence counter of the block even again, so that readers
+ * accept copies of the new data.
+ *
+ * @param   blockID (type: DATA_BLOCK_ID_TYPE_e) ID of the data block that was updated
+ *
+ * @return  void
+ */
+static void DATA_EndUpdate(DATA_BLOCK_ID_TYPE_e blockID) {
+    DATA_MEMORY_BARRIER();
+    data_block_access[blockID].seqcnt++;
+}
+
+
+/**
+ * @brief   writes one or more data blocks and publishes them together
+ *
+ * Double and triple buffered blocks are first written to their inactive buffer. Then all
+ * blocks are published in one step while the snapshot sequence counter is odd,
+ * so DB_ReadBlockV() never sees only a part of them. Entries with an invalid
+ * block ID or without data are ignored. If a block is contained more than once,
+ * only its last entry is written.
+ *
+ * @param   vector (type: DATA_BLOCK_VECTOR_s) pointer to the block IDs and data pointers of the sender
+ * @param   nr_of_blocks (type: uint8_t) number of entries in vector
+ * @param   timestamp (type: uint32_t) time the write was queued, see DATA_GetCycleCount()
+ *
+ * @return  void
+ */
+static void DATA_WriteBlocks(const DATA_BLOCK_VECTOR_s *vector, uint8_t nr_of_blocks, uint32_t timestamp) {
+    DATA_BLOCK_ID_TYPE_e blockID;
+    DATA_BLOCK_ACCESS_s *access;
+    const DATA_BASE_HEADER_s *descriptor;
+    uint32_t latency;
+    uint8_t i;
+
+    /* readers never copy from WRptr, so the new data of double and triple buffered
+       blocks can be written without changing the sequence counters. Readers that started
+       before the last swap and still copy from this buffer are caught by the
+       sequence counter. The buffer is claimed before it is written, so that neither
+       DB_BorrowWrite() lends it nor DB_Release() publishes it during the copy. */
+    for(i = 0; i < nr_of_blocks; i++)
+    {
+        blockID = vector[i].blockID;
+        if((blockID < DATA_MAX_BLOCK_NR) && (vector[i].dataptr != NULL_PTR) &&
+                (DATA_IsWrittenLater(vector, i, nr_of_blocks) == FALSE))
+        {
+            access = &data_block_access[blockID];
+            descriptor = &data_block_descriptor[blockID];
+            if(descriptor->buffertype  !=  SINGLE_BUFFERING)
+            {
+                OS_TaskEnter_Critical();
+                if(access->wrborrowed == FALSE)
+                {
+                    access->wrclaimed = TRUE;
+                }
+                OS_TaskExit_Critical();
+                if(access->wrclaimed == TRUE)
+                {
+                    memcpy(access->WRptr, vector[i].dataptr, descriptor->datalength);
+                }
+            }
+        }
+    }
+
+    /* DB_Commit() and DB_Release() advance the snapshot sequence counter from other
+       tasks, so it is only changed inside a critical section */
+    OS_TaskEnter_Critical();
+    data_snapshot_seqcnt++;
+    OS_TaskExit_Critical();
+    DATA_MEMORY_BARRIER();
+    for(i = 0; i < nr_of_blocks; i++)
+    {
+        blockID = vector[i].blockID;
+        if((blockID < DATA_MAX_BLOCK_NR) && (vector[i].dataptr != NULL_PTR) &&
+                (DATA_IsWrittenLater(vector, i, nr_of_blocks) == FALSE))
+        {
+            access = &data_block_access[blockID];
+            descriptor = &data_block_descriptor[blockID];
+            if(descriptor->buffertype  !=  SINGLE_BUFFERING)
+            {
+                OS_TaskEnter_Critical();
+                if(access->wrclaimed == TRUE)
+                {
+                    access->wrclaimed = FALSE;
+                    data_block_published[blockID] = DATA_PublishBlock(blockID);
+                }
+                else
+                {   // the inactive buffer is lent to a producer, the data is discarded
+                    data_statistics.block[blockID].nr_of_dropped_writes++;
+                }
+                OS_TaskExit_Critical();
+            }
+            else
+            {   /* single buffering: readers copy from the same buffer, the sequence
+                   counter stays odd until the copy is complete */
+                DATA_BeginUpdate(blockID);
+                memcpy(access->WRptr, vector[i].dataptr, descriptor->datalength);
+                DATA_EndUpdate(blockID);
+                data_block_published[blockID] = TRUE;
+            }
+        }
+    }
+    DATA_MEMORY_BARRIER();
+    OS_TaskEnter_Critical();
+    data_snapshot_seqcnt++;
+    OS_TaskExit_Critical();
+
+    latency = DATA_GetCycleCount() - timestamp;
+    for(i = 0; i < nr_of_blocks; i++)
+    {
+        if((vector[i].blockID < DATA_MAX_BLOCK_NR) && (vector[i].dataptr != NULL_PTR))
+        {
+            DATA_CountLatency(vector[i].blockID, latency);
+            if(data_block_published[vector[i].blockID] == TRUE)
+            {   // deferred or dropped writes are notified by whoever publishes the block later
+                data_block_published[vector[i].blockID] = FALSE;
+                DATA_NotifySubscribers(vector[i].blockID);
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief   checks if the block of an entry of a vector is contained again in a later entry
+ *
+ * @param   vector (type: DATA_BLOCK_VECTOR_s) pointer to the block IDs and data pointers of the sender
+ * @param   index (type: uint8_t) entry that is checked
+ * @param   nr_of_blocks (type: uint8_t) number of entries in vector
+ *
+ * @return  TRUE if the block is written again later in the vector, FALSE otherwise
+ */
+static uint8_t DATA_IsWrittenLater(const DATA_BLOCK_VECTOR_s *vector, uint8_t index, uint8_t nr_of_blocks) {
+    uint8_t i;
+
+    for(i = index + 1; i < nr_of_blocks; i++)
+    {
+        if(vector[i].blockID == vector[index].blockID)
+        {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+
+/**
+ * @brief   publishes the write buffer of a double or triple buffered data block
+ *
+ * WRptr always points to the buffer to be written next time, RDptr always
+ * points to the buffer to be read next time.
+ * Double buffering: WRptr and RDptr are swapped. This is not possible while
+ * readers borrow the active buffer, then it is done by the last DB_Release(),
+ * or by the next publish if WRptr is written again meanwhile.
+ * Triple buffering: the write buffer becomes the read buffer, and the next
+ * write buffer is the one of the two others that is not lent to readers. So
+ * writers always have a free buffer and publishing is never deferred.
+ *
+ * Must be called inside a critical section. The snapshot sequence counter is
+ * advanced by two, so that DB_ReadBlockV() copies made meanwhile are repeated.
+ *
+ * @param   blockID (type: DATA_BLOCK_ID_TYPE_e) ID of the data block
+ *
+ * @return  TRUE if the block was published, FALSE if publishing was deferred
+ */
+static uint8_t DATA_PublishBlock(DATA_BLOCK_ID_TYPE_e blockID) {
+    DATA_BLOCK_ACCESS_s *access = &data_block_access[blockID];
+    void *dataptr;
+
+    if(access->rdborrowcnt > 0)
+    {   // with the former mutex based implementation, this write would have been dropped (see DB_ReadBlock())
+        data_statistics.block[blockID].nr_of_collisions++;
+    }
+
+    if((access->rdborrowcnt > 0) &&
+            (data_block_descriptor[blockID].buffertype == DOUBLE_BUFFERING))
+    {   // the active buffer is lent to readers, publish with the last DB_Release()
+        access->publishpending = TRUE;
+        return FALSE;
+    }
+
+    DATA_BeginUpdate(blockID);
+    dataptr = access->WRptr;
+    if(data_block_descriptor[blockID].buffertype == TRIPLE_BUFFERING)
+    {
+        if((access->rdborrowcnt > 0) && (access->RDborrowptr == access->SPptr))
+        {   // spare buffer is lent to readers, continue with the former read buffer
+            access->WRptr = access->RDptr;
+        }
+        else
+        {
+            access->WRptr = access->SPptr;
+            access->SPptr = access->RDptr;
         }
-        data_base_mutex[c] = xSemaphoreCreateMutex();
     }
+    else
+    {
+        access->WRptr = access->RDptr;
+    }
+    access->RDptr = dataptr;
+    access->publishpending = FALSE;
+    DATA_EndUpdate(blockID);
+    data_snapshot_seqcnt += 2;
+    return TRUE;
+}
+
+
+/**
+ * @brief   gets a continuous time base in SysTick cycles
+ *
+ * Combines the OS tick counter and the SysTick downcounter (MCU_GetTimeBase()).
+ * The value overflows after 2^32 cycles, differences are valid as long as
+ * they are shorter.
+ *
+ * @return  time in SysTick cycles
+ */
+static uint32_t DATA_GetCycleCount(void) {
+    uint32_t ticks;
+    uint32_t timebase;
+
+    do
+    {   // read again if the tick counter changed meanwhile
+        ticks = MCU_GetTimeStamp();
+        timebase = MCU_GetTimeBase();
+    } while(ticks != MCU_GetTimeStamp());
+
+    return (ticks * DATA_TIMEBASE_CYCLES_PER_TICK) + (DATA_TIMEBASE_CYCLES_PER_TICK - 1 - timebase);
+}
 
+
+/**
+ * @brief   updates the read statistics of a data block
+ *
+ * @param   blockID (type: DATA_BLOCK_ID_TYPE_e) ID of the data block
+ * @param   retries (type: uint8_t) number of copies that had to be repeated, 0 if no copy was made
+ * @param   result (type: STD_RETURN_TYPE_e) E_OK if a consistent copy was made
+ *
+ * @return  void
+ */
+static void DATA_CountRead(DATA_BLOCK_ID_TYPE_e blockID, uint8_t retries, STD_RETURN_TYPE_e result) {
+    OS_TaskEnter_Critical();
+    if(result == E_OK)
+    {
+        data_statistics.block[blockID].nr_of_reads++;
+        data_statistics.block[blockID].nr_of_read_retries += retries;
+    }
+    else
+    {
+        data_statistics.block[blockID].nr_of_read_failures++;
+        if(retries > 0)
+        {   // the last copy was not a retry
+            data_statistics.block[blockID].nr_of_read_retries += retries - 1;
+        }
+    }
+    OS_TaskExit_Critical();
+}
+
+
+/**
+ * @brief   updates the write statistics of a data block
+ *
+ * @param   blockID (type: DATA_BLOCK_ID_TYPE_e) ID of the data block
+ * @param   latency (type: uint32_t) time from queueing the write until it was published in SysTick cycles
+ *
+ * @return  void
+ */
+static void DATA_CountLatency(DATA_BLOCK_ID_TYPE_e blockID, uint32_t latency) {
+    DATA_BLOCK_STATISTICS_s *statistics = &data_statistics.block[blockID];
+
+    if((statistics->nr_of_writes == 0) || (latency < statistics->latency_min))
+    {
+        statistics->latency_min = latency;
+    }
+    if(latency > statistics->latency_max)
+    {
+        statistics->latency_max = latency;
+    }
+    data_latency_sum[blockID] += latency;
+    statistics->nr_of_writes++;
+}
+
+
+/**
+ * @brief   notifies the subscribers of a data block that a new version was published
+ *
+ * Each subscriber is notified once per change of the block version. The
+ * function runs concurrently in the database task and in the callers of
+ * DB_Commit() and DB_Release(), so the version of a subscriber is checked
+ * and updated inside a critical section, and the subscriber is notified
+ * outside of it. Callbacks are executed in the context of the caller and
+ * must be short.
+ *
+ * @param   blockID (type: DATA_BLOCK_ID_TYPE_e) ID of the data block
+ *
+ * @return  void
+ */
+static void DATA_NotifySubscribers(DATA_BLOCK_ID_TYPE_e blockID) {
+    DATA_SUBSCRIBER_CALLBACK_f callback;
+    void *taskhandle;
+    uint32_t version;
+    uint8_t notify;
+    uint8_t i;
+
+    for(i = 0; i < data_nr_of_subscribers; i++)
+    {
+        /* the version only increases and is read inside the critical section, so a
+           concurrent call with an older version cannot notify a subscriber again */
+        notify = FALSE;
+        OS_TaskEnter_Critical();
+        version = DB_GetBlockVersion(blockID);
+        if((data_subscribers[i].blockID == blockID) && (data_subscribers[i].version != version))
+        {
+            data_subscribers[i].version = version;
+            callback = data_subscribers[i].callback;
+            taskhandle = data_subscribers[i].taskhandle;
+            notify = TRUE;
+        }
+        OS_TaskExit_Critical();
+
+        if(notify == TRUE)
+        {
+            if(callback != NULL_PTR)
+            {
+                callback(blockID, version);
+            }
+            if(taskhandle != NULL_PTR)
+            {
+                xTaskNotifyGive((TaskHandle_t)taskhandle);
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief   initializes the memory regions data blocks are allocated from
+ *
+ * @return  void
+ */
+static void DATA_InitRegions(void) {
+    memset(data_region, 0, sizeof(data_region));
+#if DATA_INTERNAL_ARENA_SIZE > 0
+    data_region[DATA_REGION_INTERNAL].start = (uint8_t *)data_internal_arena;
+    data_region[DATA_REGION_INTERNAL].size = sizeof(data_internal_arena);
+#endif
+#if defined(DATA_EXTSDRAM_REGION_START) && defined(DATA_EXTSDRAM_REGION_SIZE)
+    data_region[DATA_REGION_EXTSDRAM].start = (uint8_t *)(DATA_EXTSDRAM_REGION_START);
+    data_region[DATA_REGION_EXTSDRAM].size = (DATA_EXTSDRAM_REGION_SIZE);
+#endif
+}
+
+
+/**
+ * @brief   allocates the buffers of a data block from the memory regions
+ *
+ * The region is selected by the placement of the block. If the selected
+ * region is not available or full, the other region is used. The buffers
+ * are cleared, since external SDRAM is not initialized by the startup code.
+ *
+ * @param   blockID (type: DATA_BLOCK_ID_TYPE_e) ID of the data block
+ * @param   size (type: uint32_t) size of all buffers of the block in bytes, multiple of DATA_REGION_ALIGNMENT
+ *
+ * @return  pointer to the buffers, NULL_PTR if no region has enough free memory
+ */
+static void *DATA_AllocateBlock(DATA_BLOCK_ID_TYPE_e blockID, uint32_t size) {
+    DATA_BLOCK_PLACEMENT_e placement = DATA_PLACEMENT_AUTO;
+    DATA_REGION_e region = DATA_REGION_INTERNAL;
+    DATA_REGION_s *regionptr;
+    void *dataptr = NULL_PTR;
+    uint8_t i;
+
+#ifdef DATA_USE_BLOCK_PLACEMENT
+    placement = data_block_placement[blockID];
+#endif
+    if((placement == DATA_PLACEMENT_EXTSDRAM) ||
+            ((placement == DATA_PLACEMENT_AUTO) && (size >= DATA_EXTSDRAM_MIN_BLOCK_SIZE)))
+    {
+        region = DATA_REGION_EXTSDRAM;
+    }
+
+    for(i = 0; i < DATA_REGION_NR; i++)
+    {
+        regionptr = &data_region[region];
+        if((regionptr->start != NULL_PTR) && (size <= (regionptr->size - regionptr->used)))
+        {
+            dataptr = regionptr->start + regionptr->used;
+            regionptr->used += size;
+            memset(dataptr, 0, size);
+            break;
+        }
+        // selected region not available or full, try the other one
+        region = (region == DATA_REGION_INTERNAL) ? DATA_REGION_EXTSDRAM : DATA_REGION_INTERNAL;
+    }
+
+    return dataptr;
+}
+
+
+/**
+ * @brief   counts a write that is queued for a data block, or withdraws it if it could not be queued
+ *
+ * The calling task and the count including its write are kept for DB_ReadBlockAfterWrites().
+ *
+ * @param   blockID (type: DATA_BLOCK_ID_TYPE_e) ID of the data block
+ * @param   result (type: STD_RETURN_TYPE_e) E_OK before the write is queued, E_NOT_OK if queueing failed
+ *
+ * @return  void
+ */
+static void DATA_CountQueuedWrite(DATA_BLOCK_ID_TYPE_e blockID, STD_RETURN_TYPE_e result) {
+    if(blockID >= DATA_MAX_BLOCK_NR)
+    {
+        return;
+    }
+
+    OS_TaskEnter_Critical();
+    if(result == E_OK)
+    {
+        data_block_access[blockID].wrqueuedcnt++;
+        data_block_access[blockID].wrlasttask = xTaskGetCurrentTaskHandle();
+        data_block_access[blockID].wrlastcnt = data_block_access[blockID].wrqueuedcnt;
+    }
+    else
+    {
+        data_block_access[blockID].wrqueuedcnt--;
+        if(data_block_access[blockID].wrlasttask == (void *)xTaskGetCurrentTaskHandle())
+        {   // a previous write of the task may still be queued
+            data_block_access[blockID].wrlastcnt = data_block_access[blockID].wrqueuedcnt;
+        }
+    }
+    OS_TaskExit_Critical();
+}
+
+
+/**
+ * @brief   counts the writes of a queue message as processed by the database task
+ *
+ * @param   message (type: DATA_QUEUE_MESSAGE_s) message received from the queue
+ *
+ * @return  void
+ */
+static void DATA_CountProcessedWrites(const DATA_QUEUE_MESSAGE_s *message) {
+    const DATA_BLOCK_VECTOR_s *vector;
+    uint8_t i;
+
+    if(message->accesstype != WRITE_ACCESS)
+    {
+        return;
+    }
+
+    OS_TaskEnter_Critical();
+    if(message->nr_of_blocks == 0)
+    {
+        if(message->blockID < DATA_MAX_BLOCK_NR)
+        {
+            data_block_access[message->blockID].wrdonecnt++;
+        }
+    }
+    else
+    {
+        vector = (const DATA_BLOCK_VECTOR_s *)message->value.voidptr;
+        for(i = 0; i < message->nr_of_blocks; i++)
+        {
+            if(vector[i].blockID < DATA_MAX_BLOCK_NR)
+            {
+                data_block_access[vector[i].blockID].wrdonecnt++;
+            }
+        }
+    }
+    OS_TaskExit_Critical();
+}
+
+
+/**
+ * @brief   waits until the last write of a data block queued by the calling task has been processed by the database task
+ *
+ * DB_WriteBlock() only queues a pointer to the data of the sender. Without
+ * waiting, a task would not read back its own writes that are still queued,
+ * and a read into the buffer of such a write would change the data that is
+ * written. Writes the database task processes in the same batch count as
+ * processed only after the whole batch, since earlier writes of a block are
+ * skipped in favour of the last one (see DATA_Task()).
+ * Only the task that queued the last write of the block waits, its data is
+ * superseded by the write of another task anyway. The database task itself
+ * does not wait (e.g., in subscriber callbacks), it reads the data published
+ * so far. Inside a critical section, the read fails if the write is pending.
+ *
+ * @param   blockID (type: DATA_BLOCK_ID_TYPE_e) ID of the data block
+ *
+ * @return  E_OK if no own write is pending, E_NOT_OK if it was not processed
+ *          within DATA_READ_TIMEOUT_MS
+ */
+static STD_RETURN_TYPE_e DATA_WaitForQueuedWrites(DATA_BLOCK_ID_TYPE_e blockID) {
+    DATA_BLOCK_ACCESS_s *access = &data_block_access[blockID];
+    TaskHandle_t task = xTaskGetCurrentTaskHandle();
+    uint32_t target = 0;
+    uint32_t queued = 0;
+    uint8_t ownwrite = FALSE;
+    TickType_t timeout;
+    TickType_t waited = 0;
+
+    if(task == data_taskhandle)
+    {
+        return E_OK;
+    }
+
+    OS_TaskEnter_Critical();
+    if(access->wrlasttask == (void *)task)
+    {
+        ownwrite = TRUE;
+        target = access->wrlastcnt;
+    }
+    OS_TaskExit_Critical();
+    if(ownwrite == FALSE)
+    {
+        return E_OK;
+    }
+
+    timeout = DATA_READ_TIMEOUT_MS / portTICK_RATE_MS;
+    if(timeout == 0)
+    {
+        timeout = 1;
+    }
+
+    while((int32_t)(access->wrdonecnt - target) < 0)
+    {
+        queued = access->wrqueuedcnt;
+        if((int32_t)(queued - target) < 0)
+        {   // a write counted in target could not be queued
+            target = queued;
+            continue;
+        }
+        if(vPortCheckCriticalSection() || (waited >= timeout))
+        {
+            return E_NOT_OK;
+        }
+        vTaskDelay(1);
+        waited++;
+    }
+    return E_OK;
 }
@@ -52,16 +52,148 @@ typedef struct {
     } value;
     DATA_BLOCK_ID_TYPE_e        blockID;    /* definition of used message data type */
     DATA_BLOCK_ACCESS_TYPE_e    accesstype; /* read or write access type */
+    uint8_t                     nr_of_blocks; /* 0: single block, otherwise value points to a DATA_BLOCK_VECTOR_s array */
+    uint32_t                    timestamp;  /* time the message was queued in SysTick cycles */
 } DATA_QUEUE_MESSAGE_s;
 
+/**
+ * entry of a vectored database access, see DB_WriteBlockV() and DB_ReadBlockV()
+ */
+typedef struct {
+    DATA_BLOCK_ID_TYPE_e        blockID;    /*!< ID of the data block */
+    void                        *dataptr;   /*!< data of the caller to be written or to be read to */
+} DATA_BLOCK_VECTOR_s;
+
 
+/**
+ * state of the buffers of a data block, length and buffer type are taken
+ * from data_block_descriptor
+ */
 typedef struct {
     void                           *RDptr;
     void                           *WRptr;
-    DATA_BLOCK_CONSISTENCY_TYPE_e  nr_of_buffer;    // todo really needed?
+    void                           *SPptr;          /*!< spare buffer, only used by TRIPLE_BUFFERING */
+    void                           *RDborrowptr;    /*!< buffer lent to readers by DB_BorrowRead() */
+    volatile uint32_t              seqcnt;          /*!< sequence counter, odd while the block is updated */
+    uint8_t                        wrborrowed;      /*!< TRUE while the inactive buffer is lent by DB_BorrowWrite() */
+    uint8_t                        wrclaimed;       /*!< TRUE while the database task writes the inactive buffer */
+    uint8_t                        rdborrowcnt;     /*!< number of readers the active buffer is lent to by DB_BorrowRead() */
+    uint8_t                        publishpending;  /*!< TRUE if the inactive buffer is published with the last DB_Release() */
+    volatile uint32_t              wrqueuedcnt;     /*!< number of writes queued by DB_WriteBlock() and DB_WriteBlockV() */
+    volatile uint32_t              wrdonecnt;       /*!< number of queued writes processed by the database task */
+    void                           *wrlasttask;     /*!< task that queued the last write, see DB_ReadBlockAfterWrites() */
+    uint32_t                       wrlastcnt;       /*!< wrqueuedcnt including the last write of wrlasttask */
 } DATA_BLOCK_ACCESS_s;
 
+/**
+ * memory regions the buffers of data blocks can be allocated from, see DATA_BLOCK_PLACEMENT_e
+ */
+typedef enum {
+    DATA_REGION_INTERNAL    = 0,    /*!< arena of DATA_INTERNAL_ARENA_SIZE bytes in internal SRAM */
+    DATA_REGION_EXTSDRAM    = 1,    /*!< DATA_EXTSDRAM_REGION_SIZE bytes at DATA_EXTSDRAM_REGION_START */
+    DATA_REGION_NR          = 2,    /*!< number of regions */
+} DATA_REGION_e;
+
+/**
+ * placement of a data block whose block header has no buffer (blockptr is NULL_PTR)
+ */
+typedef enum {
+    DATA_PLACEMENT_AUTO     = 0,    /*!< external SDRAM if the buffers are at least DATA_EXTSDRAM_MIN_BLOCK_SIZE bytes, internal SRAM otherwise */
+    DATA_PLACEMENT_INTERNAL = 1,    /*!< internal SRAM, for small blocks accessed every cycle */
+    DATA_PLACEMENT_EXTSDRAM = 2,    /*!< external SDRAM, for large blocks that are rarely accessed */
+} DATA_BLOCK_PLACEMENT_e;
+
+/**
+ * state of a memory region used by the database
+ */
+typedef struct {
+    uint8_t     *start;     /*!< first byte of the region, NULL_PTR if the region is not available */
+    uint32_t    size;       /*!< size of the region in bytes */
+    uint32_t    used;       /*!< bytes allocated for data blocks */
+} DATA_REGION_s;
+
+/**
+ * function called when a new version of a data block was published, see DB_Subscribe()
+ */
+typedef void (*DATA_SUBSCRIBER_CALLBACK_f)(DATA_BLOCK_ID_TYPE_e blockID, uint32_t version);
+
+/**
+ * subscription to a data block
+ */
+typedef struct {
+    DATA_BLOCK_ID_TYPE_e        blockID;    /*!< ID of the data block */
+    DATA_SUBSCRIBER_CALLBACK_f  callback;   /*!< function to be called, NULL_PTR if not used */
+    void                        *taskhandle;/*!< FreeRTOS task to be notified with xTaskNotifyGive(), NULL_PTR if not used */
+    uint32_t                    version;    /*!< last version the subscriber was notified about */
+} DATA_SUBSCRIBER_s;
+
+/**
+ * access statistics of one data block, see DB_GetStatistics()
+ */
+typedef struct {
+    uint32_t nr_of_writes;          /*!< number of published writes */
+    uint32_t nr_of_reads;           /*!< number of consistent copies made by DB_ReadBlock() and DB_ReadBlockV() */
+    uint32_t nr_of_read_retries;    /*!< number of copies that had to be repeated */
+    uint32_t nr_of_read_failures;   /*!< number of reads that returned E_NOT_OK */
+    uint32_t nr_of_dropped_writes;  /*!< number of writes discarded because the block was lent by DB_BorrowWrite() */
+    uint32_t nr_of_coalesced_writes;/*!< number of writes skipped because the block was written again in the same batch */
+    uint32_t nr_of_collisions;      /*!< number of writes published while readers borrowed or copied the block */
+    uint32_t latency_min;           /*!< minimum time from queueing a write until it is published in SysTick cycles */
+    uint32_t latency_avg;           /*!< average time from queueing a write until it is published in SysTick cycles */
+    uint32_t latency_max;           /*!< maximum time from queueing a write until it is published in SysTick cycles */
+} DATA_BLOCK_STATISTICS_s;
+
+/**
+ * access statistics of the database
+ *
+ * If DATA_STATISTICS_BLOCK_ID is defined in database_cfg.h, the statistics
+ * are published periodically to this data block, which has to be of the size
+ * of this structure.
+ */
+typedef struct {
+    DATA_BLOCK_STATISTICS_s block[DATA_MAX_BLOCK_NR];   /*!< statistics of each data block */
+    uint32_t queue_highwatermark;                       /*!< maximum number of messages waiting in the database queue */
+    uint32_t nr_of_queue_timeouts;                      /*!< number of writes lost because the queue was full for DATA_QUEUE_TIMEOUT_MS */
+} DATA_STATISTICS_s;
+
+/**
+ * @brief   checks at compile time that a block header table has one entry per data block
+ *
+ * To be used in database_cfg.c next to the definition of the block header
+ * table, e.g. DATA_CHECK_BLOCKHEADER_COUNT(data_block_descriptor);
+ * Compilation fails with a negative array size if the number of entries
+ * does not match DATA_MAX_BLOCK_NR.
+ */
+#define DATA_CHECK_BLOCKHEADER_COUNT(table) \
+    typedef char data_check_blockheader_count[((sizeof(table)/sizeof((table)[0])) == DATA_MAX_BLOCK_NR) ? 1 : -1]
+
+/**
+ * Places a variable of database_cfg.c in external SDRAM, e.g. the buffers of
+ * a large data block. The section has to be provided by the linker script of
+ * the project, the default name can be overridden in database_cfg.h.
+ */
+#ifndef DATA_SECTION_EXTSDRAM
+#define DATA_SECTION_EXTSDRAM   __attribute__((section(".extsdram")))
+#endif
+
 /*================== Constant and Variable Definitions ====================*/
+/**
+ * block header of each data block (buffer, length of one buffer, buffer type),
+ * indexed by the block ID. To be defined const in database_cfg.c, so that it is
+ * placed in flash, and checked with DATA_CHECK_BLOCKHEADER_COUNT(). Blocks
+ * without buffer (blockptr is NULL_PTR) are allocated by the database task.
+ */
+extern const DATA_BASE_HEADER_s data_block_descriptor[];
+
+#ifdef DATA_USE_BLOCK_PLACEMENT
+/**
+ * placement of each data block, to be defined in database_cfg.c if
+ * DATA_USE_BLOCK_PLACEMENT is defined in database_cfg.h. Only used for blocks
+ * whose block header has no buffer (blockptr is NULL_PTR).
+ */
+extern const DATA_BLOCK_PLACEMENT_e data_block_placement[DATA_MAX_BLOCK_NR];
+#endif
+
 
 
 
@@ -76,18 +208,180 @@ extern void DB_WriteBlock(void *dataptrfromSender, DATA_BLOCK_ID_TYPE_e  blockID
 
 /**
  * @brief   Reads a datablock in database by value
+ *
+ * The block is copied synchronously in the context of the caller without
+ * passing through the database queue and without waiting for the database
+ * task. Writes that are still queued are not contained in the copy, see
+ * DB_ReadBlockAfterWrites(). If the database task publishes the block while
+ * it is copied, the copy is repeated.
+ *
  * @param   blockID (type: DATA_BLOCK_ID_TYPE_e)
  * @param   dataptrtoReceiver (type: void *)
- * @return  STD_RETURN_TYPE_e
+ * @return  E_OK if a consistent copy was made, E_NOT_OK if the database is not
+ *          initialized yet or no consistent copy could be made. The buffer of
+ *          the caller may have been changed anyway.
  */
 extern STD_RETURN_TYPE_e DB_ReadBlock(void *dataptrtoReceiver, DATA_BLOCK_ID_TYPE_e  blockID);
 
- /**
- * @brief   Gets a pointer to datablock in database ()
+/**
+ * @brief   Reads a datablock in database by value after the own writes of the caller
+ *
+ * Like DB_ReadBlock(), but if the calling task queued the last write of the
+ * block with DB_WriteBlock() or DB_WriteBlockV(), it waits up to
+ * DATA_READ_TIMEOUT_MS until the database task has published it. So a task
+ * reads back its own writes, and the buffer of its write that is still queued
+ * is not overwritten by reading into it. Writes queued by other tasks are not
+ * waited for. The database task and callers inside a critical section cannot wait.
+ *
  * @param   blockID (type: DATA_BLOCK_ID_TYPE_e)
- * @return  void* RDptr
-  */
-extern void * DATA_GetTablePtrBeginCritical(DATA_BLOCK_ID_TYPE_e  blockID);
+ * @param   dataptrtoReceiver (type: void *)
+ * @return  E_OK if a consistent copy was made, E_NOT_OK if the own write was
+ *          not published in time or DB_ReadBlock() failed
+ */
+extern STD_RETURN_TYPE_e DB_ReadBlockAfterWrites(void *dataptrtoReceiver, DATA_BLOCK_ID_TYPE_e  blockID);
+
+/**
+ * @brief   Stores several datablocks in database as one consistent snapshot
+ *
+ * Only one message is sent to the database task for all blocks. The blocks
+ * are published together, DB_ReadBlockV() returns either all old or all new
+ * blocks. The vector and the data it points to must stay valid until the
+ * database task has processed the message, like the data of DB_WriteBlock().
+ *
+ * @param   vector (type: DATA_BLOCK_VECTOR_s) array of block IDs and data pointers
+ * @param   nr_of_blocks (type: uint8_t) number of entries in vector
+ * @return  void
+ */
+extern void DB_WriteBlockV(const DATA_BLOCK_VECTOR_s *vector, uint8_t nr_of_blocks);
+
+/**
+ * @brief   Reads several datablocks in database by value as one consistent snapshot
+ *
+ * Like DB_ReadBlock(), but the copies of all blocks belong to the same state
+ * of the database, i.e. no block was published while they were made. Does not
+ * wait for queued writes, like DB_ReadBlock().
+ *
+ * @param   vector (type: DATA_BLOCK_VECTOR_s) array of block IDs and data pointers
+ * @param   nr_of_blocks (type: uint8_t) number of entries in vector
+ * @return  E_OK if a consistent copy was made, E_NOT_OK otherwise
+ */
+extern STD_RETURN_TYPE_e DB_ReadBlockV(const DATA_BLOCK_VECTOR_s *vector, uint8_t nr_of_blocks);
+
+/**
+ * @brief   Lends the inactive buffer of a double or triple buffered datablock to a producer
+ *
+ * The producer fills the buffer in place and publishes it with DB_Commit().
+ * Until then, writes to the block by DB_WriteBlock() are discarded. The buffer
+ * contains the data that was published before the currently active one, or
+ * data whose publication is deferred until the last DB_Release(), so the
+ * producer has to write all data. Deferred data is superseded by the data of
+ * the producer. Only one producer can borrow a block.
+ *
+ * @param   blockID (type: DATA_BLOCK_ID_TYPE_e)
+ * @return  pointer to the inactive buffer, NULL_PTR if the block is single
+ *          buffered, already borrowed or just written by the database task
+ */
+extern void * DB_BorrowWrite(DATA_BLOCK_ID_TYPE_e  blockID);
+
+/**
+ * @brief   Publishes the buffer lent by DB_BorrowWrite()
+ *
+ * The RD and WR pointers of the block are swapped, no data is copied. If the
+ * active buffer of a double buffered block is lent to readers, the swap is
+ * done by the last DB_Release().
+ *
+ * @param   blockID (type: DATA_BLOCK_ID_TYPE_e)
+ * @return  E_OK if the block was borrowed for writing, E_NOT_OK otherwise
+ */
+extern STD_RETURN_TYPE_e DB_Commit(DATA_BLOCK_ID_TYPE_e  blockID);
+
+/**
+ * @brief   Lends the active buffer of a double or triple buffered datablock to a reader
+ *
+ * The buffer is not changed until it is given back with DB_Release().
+ * Double buffering: new data is published after the last DB_Release(), so
+ * borrows should be kept short.
+ * Triple buffering: new data is published anyway. Readers that borrow the
+ * block while other readers still hold it get the same (older) buffer.
+ *
+ * @param   blockID (type: DATA_BLOCK_ID_TYPE_e)
+ * @return  pointer to the active buffer, NULL_PTR if the block is single buffered
+ */
+extern const void * DB_BorrowRead(DATA_BLOCK_ID_TYPE_e  blockID);
+
+/**
+ * @brief   Gives back a buffer lent by DB_BorrowRead()
+ *
+ * The last DB_Release() publishes data of a double buffered block that was
+ * deferred while the block was borrowed, unless the inactive buffer is lent
+ * by DB_BorrowWrite(). Then DB_Commit() publishes it.
+ *
+ * @param   blockID (type: DATA_BLOCK_ID_TYPE_e)
+ * @return  E_OK if the block was borrowed for reading, E_NOT_OK otherwise
+ */
+extern STD_RETURN_TYPE_e DB_Release(DATA_BLOCK_ID_TYPE_e  blockID);
+
+/**
+ * @brief   Gets the usage of a memory region by the buffers of the data blocks
+ *
+ * @param   region (type: DATA_REGION_e)
+ * @param   usage (type: DATA_REGION_s *) pointer to where the state of the region is copied to
+ * @return  void
+ */
+extern void DB_GetRegionUsage(DATA_REGION_e region, DATA_REGION_s *usage);
+
+/**
+ * @brief   Gets the version of a datablock
+ *
+ * The version is incremented each time the block is published, readers can
+ * compare it with the version of their last copy to skip unchanged blocks.
+ *
+ * @param   blockID (type: DATA_BLOCK_ID_TYPE_e)
+ * @return  number of updates of the block since startup
+ */
+extern uint32_t DB_GetBlockVersion(DATA_BLOCK_ID_TYPE_e  blockID);
+
+/**
+ * @brief   Registers a subscriber that is notified each time a datablock is published
+ *
+ * The callback is executed and the task is notified in the context of the
+ * publisher, i.e., the database task or the caller of DB_Commit() or
+ * DB_Release(). Callbacks must therefore be short and must not block.
+ *
+ * @param   blockID (type: DATA_BLOCK_ID_TYPE_e)
+ * @param   callback (type: DATA_SUBSCRIBER_CALLBACK_f) function to be called, NULL_PTR if not used
+ * @param   taskhandle (type: void *) FreeRTOS task handle to be notified with xTaskNotifyGive(), NULL_PTR if not used
+ * @return  E_OK if the subscriber was registered, E_NOT_OK if no free entry is left
+ */
+extern STD_RETURN_TYPE_e DB_Subscribe(DATA_BLOCK_ID_TYPE_e  blockID, DATA_SUBSCRIBER_CALLBACK_f callback, void *taskhandle);
+
+/**
+ * @brief   Gets the number of writes to a datablock that overlapped a read
+ *
+ * Counts the writes published while readers borrowed the block with
+ * DB_BorrowRead() and the copies of DB_ReadBlock() that were repeated because
+ * the block was published meanwhile. The former mutex based implementation
+ * of the database dropped these writes.
+ *
+ * @param   blockID (type: DATA_BLOCK_ID_TYPE_e)
+ * @return  number of colliding writes since startup
+ */
+extern uint32_t DB_GetWriteCollisionCount(DATA_BLOCK_ID_TYPE_e  blockID);
+
+/**
+ * @brief   Gets the access statistics of the database
+ *
+ * @param   statistics (type: DATA_STATISTICS_s *) the statistics are copied to this structure
+ * @return  void
+ */
+extern void DB_GetStatistics(DATA_STATISTICS_s *statistics);
+
+/**
+ * @brief   Resets the access statistics of the database
+ *
+ * @return  void
+ */
+extern void DB_ResetStatistics(void);
 
  /**
   * @brief   trigger of database manager
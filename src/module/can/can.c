@@ -49,6 +49,7 @@
 #include "mcu.h"
 #include "diag.h"
 #include "io.h"
+#include "string.h"
 /*================== Macros and Definitions ===============================*/
 #define ID_16BIT_FIFO0          0
 #define ID_16BIT_FIFO1          1
@@ -79,8 +80,10 @@ CAN_RX_BUFFER_s can0_rxbuffer = {
 };
 #endif
 
+CAN_RX_ID_TABLE_s can0_rxIDTable;      // RX messages sorted by ID
+
 #if CAN0_BUFFER_BYPASS_NUMBER_OF_IDs > 0
-uint8_t can0_fastLinkIndex[CAN0_BUFFER_BYPASS_NUMBER_OF_IDs];   // Link Table for bufferBypassing
+CAN_BYPASS_LINK_s can0_bypassLinks[CAN0_BUFFER_BYPASS_NUMBER_OF_IDs];   // Link Table for bufferBypassing, sorted by ID
 #endif
 
 CAN_ERROR_s CAN0_errorStruct = {
@@ -109,8 +112,10 @@ CAN_RX_BUFFER_s can1_rxbuffer = {
 };
 #endif
 
+CAN_RX_ID_TABLE_s can1_rxIDTable;      // RX messages sorted by ID
+
 #if CAN1_BUFFER_BYPASS_NUMBER_OF_IDs > 0
-uint8_t can1_fastLinkIndex[CAN1_BUFFER_BYPASS_NUMBER_OF_IDs];   // Link Table for bufferBypassing
+CAN_BYPASS_LINK_s can1_bypassLinks[CAN1_BUFFER_BYPASS_NUMBER_OF_IDs];   // Link Table for bufferBypassing, sorted by ID
 #endif
 
 CAN_ERROR_s CAN1_errorStruct = {
@@ -123,7 +128,7 @@ CAN_ERROR_s CAN1_errorStruct = {
 
 
 #if (CAN1_BUFFER_BYPASS_NUMBER_OF_IDs > 0 && CAN_USE_CAN_NODE1) || (CAN0_BUFFER_BYPASS_NUMBER_OF_IDs > 0 && CAN_USE_CAN_NODE0)
-uint8_t fastLinkBuffer[8]; /* data buffer for bypassed message, therefore size = 8 */
+uint32_t fastLinkBuffer[2]; /* data buffer for bypassed message (RDLR, RDHR), therefore size = 8 bytes */
 #endif
 
 /* ***********************************************************
@@ -149,6 +154,14 @@ static uint8_t CAN_GetNextID(CAN_MSG_RX_TYPE_s* can_RxMsgs, uint8_t numberOfRxID
         uint8_t filterCase);
 static uint8_t CAN_NumberOfNeededFilters(CAN_MSG_RX_TYPE_s* can_RxMsgs, uint8_t* numberOfDifferentIDs);
 static void CAN_InitFilter(CAN_HandleTypeDef* ptrHcan, CAN_MSG_RX_TYPE_s* can_RxMsgs, uint8_t numberOfRxMsgs);
+static void CAN_InitRxIDTable(CAN_RX_ID_TABLE_s* table, CAN_MSG_RX_TYPE_s* can_RxMsgs, uint8_t numberOfRxMsgs);
+static void CAN_InitBypassLinks(CAN_BYPASS_LINK_s* links, uint32_t* bypassIDs, uint8_t numberOfBypassIDs,
+        CAN_RX_ID_TABLE_s* table, CAN_MSG_RX_TYPE_s* can_RxMsgs, uint8_t numberOfRxMsgs);
+
+/* ID look-up */
+static uint8_t CAN_FindRxMsg(CAN_RX_ID_TABLE_s* table, CAN_MSG_RX_TYPE_s* can_RxMsgs, uint8_t numberOfRxMsgs,
+        uint32_t msgID, uint8_t previous);
+static CAN_BYPASS_LINK_s* CAN_FindBypassLink(CAN_BYPASS_LINK_s* links, uint8_t numberOfBypassIDs, uint32_t msgID);
 
 /* Interrupts */
 static void CAN_Disable_Transmit_IT(CAN_HandleTypeDef* ptrHcan);
@@ -157,6 +170,10 @@ static void CAN_ErrorCallback(CAN_HandleTypeDef* ptrHhcan);
 static STD_RETURN_TYPE_e CAN_RxMsg(CAN_NodeTypeDef_e canNode, CAN_HandleTypeDef* ptrHcan, uint8_t FIFONumber);
 
 /* Buffer/Interpreter */
+static uint32_t CAN_TxBufferEnqueue(CAN_TX_BUFFER_s* can_txbuffer, CanTxMsgTypeDef* msgs, uint32_t numberOfMsgs);
+#if CAN0_USE_RX_BUFFER || CAN1_USE_RX_BUFFER
+static uint32_t CAN_RxBufferDequeue(CAN_RX_BUFFER_s* can_rxbuffer, Can_PduType* msgs, uint32_t numberOfMsgs);
+#endif
 static STD_RETURN_TYPE_e CAN_BufferBypass(CAN_NodeTypeDef_e canNode, uint32_t msgID, uint8_t* rxData, uint8_t DLC,
         uint8_t RTR);
 static STD_RETURN_TYPE_e CAN_InterpretReceivedMsg(CAN_NodeTypeDef_e canNode, uint32_t msgID, uint8_t* data, uint8_t DLC,
@@ -181,6 +198,13 @@ void CAN_Init(void) {
     /* Configure CAN0 hardware filter */
     CAN_InitFilter(&hcan0, &can0_RxMsgs[0], can_CAN0_rx_length);
 
+    /* Sort RX messages and bypassed IDs for the look-up in the RX interrupt */
+    CAN_InitRxIDTable(&can0_rxIDTable, &can0_RxMsgs[0], can_CAN0_rx_length);
+#if CAN0_BUFFER_BYPASS_NUMBER_OF_IDs > 0
+    CAN_InitBypassLinks(&can0_bypassLinks[0], &can0_bufferBypass_RxMsgs[0], CAN0_BUFFER_BYPASS_NUMBER_OF_IDs,
+            &can0_rxIDTable, &can0_RxMsgs[0], can_CAN0_rx_length);
+#endif
+
     /* Check if more rx messages are bypassed than received */
     if (CAN0_BUFFER_BYPASS_NUMBER_OF_IDs > can_CAN0_rx_length) {
         DIAG_Handler(DIAG_CH_CAN_INIT_FAILURE, DIAG_EVENT_NOK, 1, NULL);
@@ -208,6 +232,13 @@ void CAN_Init(void) {
     /* Configure CAN1 hardware filter */
     CAN_InitFilter(&hcan1, &can1_RxMsgs[0], can_CAN1_rx_length);
 
+    /* Sort RX messages and bypassed IDs for the look-up in the RX interrupt */
+    CAN_InitRxIDTable(&can1_rxIDTable, &can1_RxMsgs[0], can_CAN1_rx_length);
+#if CAN1_BUFFER_BYPASS_NUMBER_OF_IDs > 0
+    CAN_InitBypassLinks(&can1_bypassLinks[0], &can1_bufferBypass_RxMsgs[0], CAN1_BUFFER_BYPASS_NUMBER_OF_IDs,
+            &can1_rxIDTable, &can1_RxMsgs[0], can_CAN1_rx_length);
+#endif
+
     /* Check if more RX messages are bypassed than received */
     if (CAN1_BUFFER_BYPASS_NUMBER_OF_IDs > can_CAN1_rx_length) {
         DIAG_Handler(DIAG_CH_CAN_INIT_FAILURE, DIAG_EVENT_NOK, 0, NULL);
@@ -414,6 +445,67 @@ static void CAN_InitFilter(CAN_HandleTypeDef* ptrHcan, CAN_MSG_RX_TYPE_s* can_Rx
     }
 }
 
+/**
+ * @brief  Sorts the RX messages of a CAN node by ID
+ *
+ * Insertion sort, stable, so messages with duplicate IDs stay in the configured order.
+ * If the node has more RX messages than CAN_MAX_NUMBER_OF_RX_IDS, the table stays
+ * empty and the messages are searched linearly.
+ *
+ * @param table:             table to initialize
+ * @param can_RxMsgs:        pointer to receive message struct
+ * @param numberOfRxMsgs:    number of RX messages
+ *
+ * @retval none
+ */
+static void CAN_InitRxIDTable(CAN_RX_ID_TABLE_s* table, CAN_MSG_RX_TYPE_s* can_RxMsgs, uint8_t numberOfRxMsgs) {
+    uint8_t i = 0;
+    uint8_t j = 0;
+    uint8_t index = 0;
+
+    table->length = 0;
+    if (numberOfRxMsgs > CAN_MAX_NUMBER_OF_RX_IDS) {
+        return;
+    }
+
+    for (i = 0; i < numberOfRxMsgs; i++) {
+        index = i;
+        for (j = i; j > 0 && can_RxMsgs[table->index[j - 1]].ID > can_RxMsgs[index].ID; j--) {
+            table->index[j] = table->index[j - 1];
+        }
+        table->index[j] = index;
+    }
+    table->length = numberOfRxMsgs;
+}
+
+/**
+ * @brief  Sorts the bypassed IDs of a CAN node and links them to their RX message
+ *
+ * @param links:             link table to initialize, numberOfBypassIDs entries
+ * @param bypassIDs:         configured bypassed IDs
+ * @param numberOfBypassIDs: number of bypassed IDs
+ * @param table:             RX messages sorted by ID, see CAN_InitRxIDTable()
+ * @param can_RxMsgs:        pointer to receive message struct
+ * @param numberOfRxMsgs:    number of RX messages
+ *
+ * @retval none
+ */
+static void CAN_InitBypassLinks(CAN_BYPASS_LINK_s* links, uint32_t* bypassIDs, uint8_t numberOfBypassIDs,
+        CAN_RX_ID_TABLE_s* table, CAN_MSG_RX_TYPE_s* can_RxMsgs, uint8_t numberOfRxMsgs) {
+    uint8_t i = 0;
+    uint8_t j = 0;
+    CAN_BYPASS_LINK_s link;
+
+    for (i = 0; i < numberOfBypassIDs; i++) {
+        link.ID = bypassIDs[i];
+        link.rxIndex = CAN_FindRxMsg(table, can_RxMsgs, numberOfRxMsgs, bypassIDs[i], CAN_RX_MSG_NOT_FOUND);
+        for (j = i; j > 0 && links[j - 1].ID > link.ID; j--) {
+            links[j] = links[j - 1];
+        }
+        links[j] = link;
+    }
+}
+
 /**
  * @brief  Returns the number of filters that have to be initialized
  *
@@ -436,34 +528,6 @@ static uint8_t CAN_NumberOfNeededFilters(CAN_MSG_RX_TYPE_s* can_RxMsgs, uint8_t*
 
     for (int i = 0; i < can_rx_length; i++) {
 
-#if CAN0_BUFFER_BYPASS_NUMBER_OF_IDs > 0 && CAN_USE_CAN_NODE0 == 1
-
-        if (can_RxMsgs  ==  &can0_RxMsgs[0]) {
-            /* Set buffer bypass IDs link table */
-            for (int k = 0; k < CAN0_BUFFER_BYPASS_NUMBER_OF_IDs; k++) {
-                if (can_RxMsgs[i].ID  ==  can0_bufferBypass_RxMsgs[k]) {
-                    // bypass ID  ==  ID in message receive struct
-
-                    can0_fastLinkIndex[k] = i;   // set for can_bufferBypass_RxMsgs[k] link to array index
-                    break;
-                }
-            }
-        }
-#endif
-#if CAN1_BUFFER_BYPASS_NUMBER_OF_IDs > 0 && CAN_USE_CAN_NODE1 == 1
-
-        if (can_RxMsgs  ==  &can1_RxMsgs[0]) {
-            /* Set buffer bypass IDs link table */
-            for (int k = 0; k < CAN1_BUFFER_BYPASS_NUMBER_OF_IDs; k++) {
-                if (can1_RxMsgs[i].ID  ==  can1_bufferBypass_RxMsgs[k]) {
-                    // bypass ID  ==  ID in message receive struct
-
-                    can1_fastLinkIndex[k] = i;   // set for can1_bufferBypass_RxMsgs[k] link to array index
-                    break;
-                }
-            }
-        }
-#endif
         if (can_RxMsgs[i].mask  ==  0 && IS_CAN_STDID(can_RxMsgs[i].ID)) {
 
             // ID List mode 16bit
@@ -779,8 +843,7 @@ static void CAN_TxCpltCallback(CAN_NodeTypeDef_e canNode) {
     }
     if (can_txbuffer != NULL) {
         // No Error during start of transmission
-        if ((can_txbuffer->ptrWrite  ==  can_txbuffer->ptrRead)
-                && (can_txbuffer->buffer[can_txbuffer->ptrRead].newMsg  ==  0)) {
+        if (can_txbuffer->idxWrite  ==  can_txbuffer->idxRead) {
             // nothing to transmit, buffer is empty
             retVal = E_NOT_OK;
         } else {
@@ -860,7 +923,7 @@ STD_RETURN_TYPE_e CAN_TxMsg(CAN_NodeTypeDef_e canNode, uint32_t msgID, uint8_t*
 STD_RETURN_TYPE_e CAN_Send(CAN_NodeTypeDef_e canNode, uint32_t msgID, uint8_t* ptrMsgData, uint32_t msgLength,
         uint32_t RTR) {
     STD_RETURN_TYPE_e retVal = E_NOT_OK;
-    uint8_t tmptxbuffer_wr;
+    CanTxMsgTypeDef message;
 
     CAN_TX_BUFFER_s* can_txbuffer = NULL;
 
@@ -874,57 +937,36 @@ STD_RETURN_TYPE_e CAN_Send(CAN_NodeTypeDef_e canNode, uint32_t msgID, uint8_t* p
 #endif
     }
 
-    if (can_txbuffer != NULL) {
-
-        OS_TaskEnter_Critical();
-        tmptxbuffer_wr = can_txbuffer->ptrWrite;
-
-        if (tmptxbuffer_wr  ==  can_txbuffer->ptrRead) {
-            if (can_txbuffer->buffer[tmptxbuffer_wr].newMsg  ==  0) {
-                // free buffer space for message
-
-                can_txbuffer->ptrWrite++;
-                can_txbuffer->ptrWrite = can_txbuffer->ptrWrite % can_txbuffer->length;
-                retVal = E_OK;
-            } else {
-                // buffer full
-                retVal = E_NOT_OK;
-            }
-        } else {
-            can_txbuffer->ptrWrite++;
-            can_txbuffer->ptrWrite = can_txbuffer->ptrWrite % can_txbuffer->length;
-            retVal = E_OK;
-        }
-        OS_TaskExit_Critical();
-    }
-
-
-    if (retVal  ==  E_OK && (IS_CAN_STDID(msgID) || IS_CAN_EXTID(msgID)) && IS_CAN_DLC(msgLength)) {
-        // if buffer free and valid CAN identifier
-
-        can_txbuffer->buffer[tmptxbuffer_wr].newMsg = 1;
+    if (can_txbuffer != NULL && (IS_CAN_STDID(msgID) || IS_CAN_EXTID(msgID)) && IS_CAN_DLC(msgLength)) {
+        // valid CAN identifier
         if (IS_CAN_STDID(msgID)) {
-            can_txbuffer->buffer[tmptxbuffer_wr].msg.StdId = msgID;
-            can_txbuffer->buffer[tmptxbuffer_wr].msg.IDE = CAN_ID_STD;   // don't use extended ID
+            message.StdId = msgID;
+            message.IDE = CAN_ID_STD;   // don't use extended ID
         } else {
-            can_txbuffer->buffer[tmptxbuffer_wr].msg.ExtId = msgID;
-            can_txbuffer->buffer[tmptxbuffer_wr].msg.IDE = CAN_ID_EXT;   // use extended ID
+            message.ExtId = msgID;
+            message.IDE = CAN_ID_EXT;   // use extended ID
         }
 
-        can_txbuffer->buffer[tmptxbuffer_wr].msg.RTR = RTR;
-        can_txbuffer->buffer[tmptxbuffer_wr].msg.DLC = msgLength;   // Data length of the frame that will be transmitted
+        message.RTR = RTR;
+        message.DLC = msgLength;   // Data length of the frame that will be transmitted
 
         /* copy message data in handle transmit structure */
-        can_txbuffer->buffer[tmptxbuffer_wr].msg.Data[0] = ptrMsgData[0];
-        can_txbuffer->buffer[tmptxbuffer_wr].msg.Data[1] = ptrMsgData[1];
-        can_txbuffer->buffer[tmptxbuffer_wr].msg.Data[2] = ptrMsgData[2];
-        can_txbuffer->buffer[tmptxbuffer_wr].msg.Data[3] = ptrMsgData[3];
-        can_txbuffer->buffer[tmptxbuffer_wr].msg.Data[4] = ptrMsgData[4];
-        can_txbuffer->buffer[tmptxbuffer_wr].msg.Data[5] = ptrMsgData[5];
-        can_txbuffer->buffer[tmptxbuffer_wr].msg.Data[6] = ptrMsgData[6];
-        can_txbuffer->buffer[tmptxbuffer_wr].msg.Data[7] = ptrMsgData[7];
-
-        retVal = E_OK;
+        message.Data[0] = ptrMsgData[0];
+        message.Data[1] = ptrMsgData[1];
+        message.Data[2] = ptrMsgData[2];
+        message.Data[3] = ptrMsgData[3];
+        message.Data[4] = ptrMsgData[4];
+        message.Data[5] = ptrMsgData[5];
+        message.Data[6] = ptrMsgData[6];
+        message.Data[7] = ptrMsgData[7];
+
+        /* NO NEED TO DISABLE INTERRUPTS, CAN_Send() IS THE ONLY PRODUCER OF THE BUFFER */
+        if (CAN_TxBufferEnqueue(can_txbuffer, &message, 1) == 1) {
+            retVal = E_OK;
+        } else {
+            // buffer full
+            retVal = E_NOT_OK;
+        }
     } else {
         retVal = E_NOT_OK;
     }
@@ -938,6 +980,7 @@ STD_RETURN_TYPE_e CAN_TxMsgBuffer(CAN_NodeTypeDef_e canNode) {
 
     CAN_TX_BUFFER_s* can_txbuffer = NULL;
     CAN_HandleTypeDef* ptrHcan = NULL;
+    uint32_t idxRead = 0;
 
     if (canNode  ==  CAN_NODE0) {
 #if CAN_USE_CAN_NODE0 == 1
@@ -957,20 +1000,21 @@ STD_RETURN_TYPE_e CAN_TxMsgBuffer(CAN_NodeTypeDef_e canNode) {
 #endif
     }
     if (can_txbuffer != NULL) {
+        /* The buffer is consumed from the task and from the transmit complete interrupt and the
+         * CAN handle is shared, so the consumer side stays locked. CAN_Send() needs no lock. */
         OS_TaskEnter_Critical();
-        if ((can_txbuffer->ptrWrite  ==  can_txbuffer->ptrRead)
-                && (can_txbuffer->buffer[can_txbuffer->ptrRead].newMsg  ==  0)) {
+        idxRead = can_txbuffer->idxRead;
+        if (can_txbuffer->idxWrite  ==  idxRead) {
             // nothing to transmit, buffer is empty
             retVal = E_NOT_OK;
         } else {
-            ptrHcan->pTxMsg = &can_txbuffer->buffer[can_txbuffer->ptrRead].msg;
+            __DMB();    // read the index before the message it announces
+            ptrHcan->pTxMsg = &can_txbuffer->buffer[idxRead & (can_txbuffer->length - 1)].msg;
             retVal = HAL_CAN_Transmit_IT(ptrHcan);
             if (retVal  ==  E_OK) {
-                // No Error during start of transmission
-                can_txbuffer->buffer[can_txbuffer->ptrRead].newMsg = 0;    // Msg is sent, set newMsg to 0, to allow writing of new data in buffer space
-                can_txbuffer->ptrRead++;
-                can_txbuffer->ptrRead = can_txbuffer->ptrRead % can_txbuffer->length;
-
+                // No Error during start of transmission, the message is copied to the mailbox
+                __DMB();    // release the buffer element to CAN_Send() only after it has been read
+                can_txbuffer->idxRead = idxRead + 1;
             } else {
                 retVal = E_NOT_OK;        // Error during transmission, retransmit message later
             }
@@ -984,10 +1028,147 @@ STD_RETURN_TYPE_e CAN_TxMsgBuffer(CAN_NodeTypeDef_e canNode) {
     return retVal;
 }
 
+/**
+ * @brief  Writes messages into a transmit buffer
+ *
+ * Messages that do not fit into the buffer are not written and counted as dropped.
+ * Must only be called by the producer of the buffer.
+ *
+ * @param  can_txbuffer: transmit buffer
+ * @param  msgs:         messages to write
+ * @param  numberOfMsgs: number of messages to write
+ *
+ * @retval number of messages written into the buffer
+ */
+static uint32_t CAN_TxBufferEnqueue(CAN_TX_BUFFER_s* can_txbuffer, CanTxMsgTypeDef* msgs, uint32_t numberOfMsgs) {
+    uint32_t idxWrite = can_txbuffer->idxWrite;
+    uint32_t fill = idxWrite - can_txbuffer->idxRead;
+    uint32_t i = 0;
+
+    if (numberOfMsgs > can_txbuffer->length - fill) {
+        can_txbuffer->droppedFrames += numberOfMsgs - (can_txbuffer->length - fill);
+        numberOfMsgs = can_txbuffer->length - fill;
+    }
+
+    __DMB();    // read the index before overwriting the elements it released
+    for (i = 0; i < numberOfMsgs; i++) {
+        can_txbuffer->buffer[(idxWrite + i) & (can_txbuffer->length - 1)].msg = msgs[i];
+    }
+    __DMB();    // write the messages before the index that announces them
+    can_txbuffer->idxWrite = idxWrite + numberOfMsgs;
+
+    if (fill + numberOfMsgs > can_txbuffer->highWaterMark) {
+        can_txbuffer->highWaterMark = fill + numberOfMsgs;
+    }
+
+    return numberOfMsgs;
+}
+
 /* ***************************************
  *  Receive message
  ****************************************/
 
+/**
+ * @brief  Looks up the RX messages configured for an ID
+ *
+ * Several RX messages may be configured for the same ID. They are returned
+ * one after the other in the configured order.
+ *
+ * @param  table:          RX messages sorted by ID, see CAN_InitRxIDTable()
+ * @param  can_RxMsgs:     pointer to receive message struct
+ * @param  numberOfRxMsgs: number of RX messages
+ * @param  msgID:          ID of the received message
+ * @param  previous:       index returned by the previous call for msgID,
+ *                         CAN_RX_MSG_NOT_FOUND to get the first RX message
+ *
+ * @retval index of the RX message, CAN_RX_MSG_NOT_FOUND if no (further) RX message is configured for the ID
+ */
+static uint8_t CAN_FindRxMsg(CAN_RX_ID_TABLE_s* table, CAN_MSG_RX_TYPE_s* can_RxMsgs, uint8_t numberOfRxMsgs,
+        uint32_t msgID, uint8_t previous) {
+    uint8_t low = 0;
+    uint8_t high = table->length;
+    uint8_t mid = 0;
+    uint8_t i = 0;
+
+    if (table->length != numberOfRxMsgs) {
+        // table not built, too many RX messages
+        i = (previous == CAN_RX_MSG_NOT_FOUND) ? 0 : previous + 1;
+        for (; i < numberOfRxMsgs; i++) {
+            if (can_RxMsgs[i].ID  ==  msgID) {
+                return i;
+            }
+        }
+        return CAN_RX_MSG_NOT_FOUND;
+    }
+
+    // first entry with ID >= msgID
+    while (low < high) {
+        mid = low + (high - low) / 2;
+        if (can_RxMsgs[table->index[mid]].ID < msgID) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    if (previous != CAN_RX_MSG_NOT_FOUND) {
+        // skip the messages with this ID up to and including the previous one
+        while (low < table->length && can_RxMsgs[table->index[low]].ID  ==  msgID && table->index[low] != previous) {
+            low++;
+        }
+        low++;
+    }
+    if (low < table->length && can_RxMsgs[table->index[low]].ID  ==  msgID) {
+        return table->index[low];
+    }
+    return CAN_RX_MSG_NOT_FOUND;
+}
+
+/**
+ * @brief  Looks up a bypassed ID
+ *
+ * @param  links:             bypassed IDs sorted by ID, see CAN_InitBypassLinks()
+ * @param  numberOfBypassIDs: number of bypassed IDs
+ * @param  msgID:             ID of the received message
+ *
+ * @retval link of the ID, NULL if the ID is not bypassed
+ */
+static CAN_BYPASS_LINK_s* CAN_FindBypassLink(CAN_BYPASS_LINK_s* links, uint8_t numberOfBypassIDs, uint32_t msgID) {
+    uint8_t low = 0;
+    uint8_t high = numberOfBypassIDs;
+    uint8_t mid = 0;
+
+    while (low < high) {
+        mid = low + (high - low) / 2;
+        if (links[mid].ID < msgID) {
+            low = mid + 1;
+        } else if (links[mid].ID > msgID) {
+            high = mid;
+        } else {
+            return &links[mid];
+        }
+    }
+    return NULL;
+}
+
+uint8_t CAN_GetRxMsgIndex(CAN_NodeTypeDef_e canNode, uint32_t msgID) {
+    return CAN_GetNextRxMsgIndex(canNode, msgID, CAN_RX_MSG_NOT_FOUND);
+}
+
+uint8_t CAN_GetNextRxMsgIndex(CAN_NodeTypeDef_e canNode, uint32_t msgID, uint8_t previous) {
+    uint8_t retVal = CAN_RX_MSG_NOT_FOUND;
+
+    if (canNode  ==  CAN_NODE0) {
+#if CAN_USE_CAN_NODE0 == 1
+        retVal = CAN_FindRxMsg(&can0_rxIDTable, &can0_RxMsgs[0], can_CAN0_rx_length, msgID, previous);
+#endif
+    } else if (canNode  ==  CAN_NODE1) {
+#if CAN_USE_CAN_NODE1 == 1
+        retVal = CAN_FindRxMsg(&can1_rxIDTable, &can1_RxMsgs[0], can_CAN1_rx_length, msgID, previous);
+#endif
+    }
+    return retVal;
+}
+
 /**
  * @brief  Receives CAN messages and stores them either in RxBuffer or in hcan
  *
@@ -999,15 +1180,14 @@ STD_RETURN_TYPE_e CAN_TxMsgBuffer(CAN_NodeTypeDef_e canNode) {
  */
 static STD_RETURN_TYPE_e CAN_RxMsg(CAN_NodeTypeDef_e canNode, CAN_HandleTypeDef* ptrHcan, uint8_t FIFONumber) {
     STD_RETURN_TYPE_e retVal = E_NOT_OK;
-    uint8_t bypassLinkIndex = 0;
+    CAN_BYPASS_LINK_s* bypassLink = NULL;
     uint32_t msgID;
 
 #if CAN0_USE_RX_BUFFER || CAN1_USE_RX_BUFFER
-    uint32_t* can_bufferbypass_rxmsgs = NULL;
-    uint32_t bufferbypasslength = 0;
+    CAN_BYPASS_LINK_s* can_bypassLinks = NULL;
+    uint8_t bufferbypasslength = 0;
     CAN_RX_BUFFER_s* can_rxbuffer = NULL;
     CAN_MSG_RX_TYPE_s* can_rxmsgs = NULL;
-    uint8_t* can_fastLinkIndex = NULL;
 #endif
 
     /* Set pointer on respective RxBuffer */
@@ -1016,9 +1196,8 @@ static STD_RETURN_TYPE_e CAN_RxMsg(CAN_NodeTypeDef_e canNode, CAN_HandleTypeDef*
         can_rxbuffer = &can1_rxbuffer;
 #if CAN1_BUFFER_BYPASS_NUMBER_OF_IDs > 0
         can_rxmsgs = &can1_RxMsgs[0];
-        can_bufferbypass_rxmsgs = &can1_bufferBypass_RxMsgs[0];
+        can_bypassLinks = &can1_bypassLinks[0];
         bufferbypasslength = CAN1_BUFFER_BYPASS_NUMBER_OF_IDs;
-        can_fastLinkIndex = &can1_fastLinkIndex[0];
 #endif
 #endif
     } else if (canNode  ==  CAN_NODE0) {
@@ -1026,9 +1205,8 @@ static STD_RETURN_TYPE_e CAN_RxMsg(CAN_NodeTypeDef_e canNode, CAN_HandleTypeDef*
         can_rxbuffer = &can0_rxbuffer;
 #if CAN0_BUFFER_BYPASS_NUMBER_OF_IDs > 0
         can_rxmsgs = &can0_RxMsgs[0];
-        can_bufferbypass_rxmsgs = &can0_bufferBypass_RxMsgs[0];
+        can_bypassLinks = &can0_bypassLinks[0];
         bufferbypasslength = CAN0_BUFFER_BYPASS_NUMBER_OF_IDs;
-        can_fastLinkIndex = &can0_fastLinkIndex[0];
 #endif
 #endif
     }
@@ -1042,57 +1220,48 @@ static STD_RETURN_TYPE_e CAN_RxMsg(CAN_NodeTypeDef_e canNode, CAN_HandleTypeDef*
     }
 
 #if CAN1_BUFFER_BYPASS_NUMBER_OF_IDs > 0 || CAN0_BUFFER_BYPASS_NUMBER_OF_IDs > 0
-    if (can_bufferbypass_rxmsgs != NULL) {
+    if (can_bypassLinks != NULL) {
         // only needed when messages are bypassed
-
-        for (bypassLinkIndex = 0; bypassLinkIndex < bufferbypasslength; bypassLinkIndex++) {
-            if (msgID  ==  can_bufferbypass_rxmsgs[bypassLinkIndex]) {
-                break;
-            }
-        }
+        bypassLink = CAN_FindBypassLink(can_bypassLinks, bufferbypasslength, msgID);
     }
 #endif
-    if (bypassLinkIndex >= bufferbypasslength && can_rxbuffer != NULL) {
+    if (bypassLink  ==  NULL && can_rxbuffer != NULL) {
         /* ##### Use buffer / Copy data in buffer ##### */
 
 #if CAN0_USE_RX_BUFFER || CAN1_USE_RX_BUFFER
         /* NO NEED TO DISABLE INTERRUPTS, BECAUSE FUNCTION IS CALLED FROM ISR */
+        uint32_t idxWrite = can_rxbuffer->idxWrite;
+        uint32_t fill = idxWrite - can_rxbuffer->idxRead;
+        CAN_RX_BUFFERELEMENT_s* element = NULL;
 
-        /* Set to 1 to mark message as new received. Set to 0 when reading message from buffer */
-        can_rxbuffer->buffer[can_rxbuffer->ptrWrite].newMsg = 1;
+        if (fill >= can_rxbuffer->length) {
+            /* buffer full, keep the unread messages and discard the received one */
+            can_rxbuffer->droppedFrames++;
+        } else {
+            __DMB();    // read the index before overwriting the element it released
+            element = &can_rxbuffer->buffer[idxWrite & (can_rxbuffer->length - 1)];
 
-        /* Get message ID */
-        can_rxbuffer->buffer[can_rxbuffer->ptrWrite].ID = msgID;
-        can_rxbuffer->buffer[can_rxbuffer->ptrWrite].RTR = (uint8_t)0x02
-                & ptrHcan->Instance->sFIFOMailBox[FIFONumber].RIR;
+            /* Get message ID */
+            element->ID = msgID;
+            element->RTR = (uint8_t)0x02 & ptrHcan->Instance->sFIFOMailBox[FIFONumber].RIR;
 
-        /* Get the DLC */
-        can_rxbuffer->buffer[can_rxbuffer->ptrWrite].DLC = (uint8_t)0x0F
-                & ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDTR;
+            /* Get the DLC */
+            element->DLC = (uint8_t)0x0F & ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDTR;
 
-        /* Get the data field */
-        can_rxbuffer->buffer[can_rxbuffer->ptrWrite].Data[0] = (uint8_t)0xFF
-                & ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDLR;
-        can_rxbuffer->buffer[can_rxbuffer->ptrWrite].Data[1] = (uint8_t)0xFF
-                & (ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDLR >> 8);
-        can_rxbuffer->buffer[can_rxbuffer->ptrWrite].Data[2] = (uint8_t)0xFF
-                & (ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDLR >> 16);
-        can_rxbuffer->buffer[can_rxbuffer->ptrWrite].Data[3] = (uint8_t)0xFF
-                & (ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDLR >> 24);
-        can_rxbuffer->buffer[can_rxbuffer->ptrWrite].Data[4] = (uint8_t)0xFF
-                & ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDHR;
-        can_rxbuffer->buffer[can_rxbuffer->ptrWrite].Data[5] = (uint8_t)0xFF
-                & (ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDHR >> 8);
-        can_rxbuffer->buffer[can_rxbuffer->ptrWrite].Data[6] = (uint8_t)0xFF
-                & (ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDHR >> 16);
-        can_rxbuffer->buffer[can_rxbuffer->ptrWrite].Data[7] = (uint8_t)0xFF
-                & (ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDHR >> 24);
-
-        /* Increment write pointer */
-        can_rxbuffer->ptrWrite++;
-        can_rxbuffer->ptrWrite = can_rxbuffer->ptrWrite % can_rxbuffer->length;
+            /* Get the data field, byte 0 is the least significant byte of RDLR */
+            element->Data[0] = ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDLR;
+            element->Data[1] = ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDHR;
+
+            /* Increment write index after the message is complete */
+            __DMB();
+            can_rxbuffer->idxWrite = idxWrite + 1;
+
+            if (fill + 1 > can_rxbuffer->highWaterMark) {
+                can_rxbuffer->highWaterMark = fill + 1;
+            }
+        }
 #endif
-    } else if (bypassLinkIndex < bufferbypasslength && can_rxmsgs != NULL && can_fastLinkIndex != NULL) {
+    } else if (bypassLink != NULL && can_rxmsgs != NULL) {
         /* ##### Buffer active but bypassed ##### */
 
 #if (CAN1_BUFFER_BYPASS_NUMBER_OF_IDs > 0 || CAN0_BUFFER_BYPASS_NUMBER_OF_IDs > 0) && (CAN_USE_CAN_NODE0 == 1 || CAN_USE_CAN_NODE1 == 1)
@@ -1102,38 +1271,30 @@ static STD_RETURN_TYPE_e CAN_RxMsg(CAN_NodeTypeDef_e canNode, CAN_HandleTypeDef*
         /* Get the DLC */
         DLC = (uint8_t)0x0F & ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDTR;
 
-        /* Get the data field */
-        fastLinkBuffer[0] = (uint8_t)0xFF & ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDLR;
-        fastLinkBuffer[1] = (uint8_t)0xFF & (ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDLR >> 8);
-        fastLinkBuffer[2] = (uint8_t)0xFF & (ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDLR >> 16);
-        fastLinkBuffer[3] = (uint8_t)0xFF & (ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDLR >> 24);
-        fastLinkBuffer[4] = (uint8_t)0xFF & ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDHR;
-        fastLinkBuffer[5] = (uint8_t)0xFF & (ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDHR >> 8);
-        fastLinkBuffer[6] = (uint8_t)0xFF & (ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDHR >> 16);
-        fastLinkBuffer[7] = (uint8_t)0xFF & (ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDHR >> 24);
+        /* Get the data field, the MCU is little endian, so the words hold the bytes in order */
+        fastLinkBuffer[0] = ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDLR;
+        fastLinkBuffer[1] = ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDHR;
 
         /* Get the RTR */
         RTR = (uint8_t)0x02 & ptrHcan->Instance->sFIFOMailBox[FIFONumber].RIR;
 
         /* Call callback function */
-        if (can_rxmsgs[can_fastLinkIndex[bypassLinkIndex]].func != NULL) {
-            can_rxmsgs[can_fastLinkIndex[bypassLinkIndex]].func(msgID, &fastLinkBuffer[0], DLC, RTR);
+        if (bypassLink->rxIndex != CAN_RX_MSG_NOT_FOUND && can_rxmsgs[bypassLink->rxIndex].func != NULL) {
+            can_rxmsgs[bypassLink->rxIndex].func(msgID, (uint8_t*)&fastLinkBuffer[0], DLC, RTR);
         } else {
             // No callback function defined
-            CAN_BufferBypass(canNode, msgID, &fastLinkBuffer[0], DLC, RTR);
+            CAN_BufferBypass(canNode, msgID, (uint8_t*)&fastLinkBuffer[0], DLC, RTR);
         }
 #endif
     } else {
         /* ##### Buffer not active ##### */
 
         CAN_MSG_RX_TYPE_s* msgRXstruct;
-        uint8_t length;
+        uint8_t i = CAN_GetRxMsgIndex(canNode, msgID);
         if (canNode == CAN_NODE0) {
             msgRXstruct = &can0_RxMsgs[0];
-            length = can_CAN0_rx_length;
         } else {
             msgRXstruct = &can1_RxMsgs[0];
-            length = can_CAN1_rx_length;
         }
 
         /* Set the Id */
@@ -1153,15 +1314,8 @@ static STD_RETURN_TYPE_e CAN_RxMsg(CAN_NodeTypeDef_e canNode, CAN_HandleTypeDef*
         ptrHcan->pRxMsg->Data[6] = (uint8_t)0xFF & (ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDHR >> 16);
         ptrHcan->pRxMsg->Data[7] = (uint8_t)0xFF & (ptrHcan->Instance->sFIFOMailBox[FIFONumber].RDHR >> 24);
 
-        uint8_t i = 0;
-        for (; i < length; i++) {
-            if (msgRXstruct[i].ID == msgID) {
-                break;
-            }
-        }
-
         /* Interpret received message */
-        if (msgRXstruct[i].func != NULL) {
+        if (i != CAN_RX_MSG_NOT_FOUND && msgRXstruct[i].func != NULL) {
             msgRXstruct[i].func(msgID, ptrHcan->pRxMsg->Data, ptrHcan->pRxMsg->DLC, ptrHcan->pRxMsg->RTR);
         } else {
             CAN_InterpretReceivedMsg(canNode, ptrHcan->pRxMsg->StdId, ptrHcan->pRxMsg->Data, ptrHcan->pRxMsg->DLC,
@@ -1211,25 +1365,111 @@ STD_RETURN_TYPE_e CAN_ReceiveBuffer(CAN_NodeTypeDef_e canNode, Can_PduType* msg)
         can_rxbuffer = NULL;
     }
 
-    if (can_rxbuffer->ptrWrite
-            != can_rxbuffer->ptrRead&& can_rxbuffer->buffer[can_rxbuffer->ptrRead].newMsg  ==  1 && can_rxbuffer != NULL) {
-        /* buffer not empty */
-        msg->id = can_rxbuffer->buffer[can_rxbuffer->ptrRead].ID;
-        msg->dlc = can_rxbuffer->buffer[can_rxbuffer->ptrRead].DLC;
+    if (can_rxbuffer != NULL && CAN_RxBufferDequeue(can_rxbuffer, msg, 1) == 1) {
+        retVal = E_OK;
+    }
+#endif
 
-        for (int i = 0; i < 8; i++) {
-            msg->sdu[i] = can_rxbuffer->buffer[can_rxbuffer->ptrRead].Data[i];
-        }
+    return retVal;
+}
 
-        /* Set to 0 to mark buffer entry as read. Set to 1 when writing message into buffer */
-        can_rxbuffer->buffer[can_rxbuffer->ptrRead].newMsg = 0;
+uint32_t CAN_ReceiveBufferBatch(CAN_NodeTypeDef_e canNode, Can_PduType* msgs, uint32_t maxNumberOfMsgs) {
+    uint32_t retVal = 0;
 
-        /* Move to next buffer element */
-        can_rxbuffer->ptrRead++;
-        can_rxbuffer->ptrRead = can_rxbuffer->ptrRead % can_rxbuffer->length;
-        retVal = E_OK;
+#if CAN0_USE_RX_BUFFER || CAN1_USE_RX_BUFFER
+
+    CAN_RX_BUFFER_s* can_rxbuffer = NULL;
+
+#if CAN0_USE_RX_BUFFER && CAN_USE_CAN_NODE0 == 1
+    if (canNode  ==  CAN_NODE0) {
+        can_rxbuffer = &can0_rxbuffer;
     }
 #endif
+#if CAN1_USE_RX_BUFFER && CAN_USE_CAN_NODE1 == 1
+    if (canNode  ==  CAN_NODE1) {
+        can_rxbuffer = &can1_rxbuffer;
+    }
+#endif
+
+    if (can_rxbuffer != NULL && msgs != NULL) {
+        retVal = CAN_RxBufferDequeue(can_rxbuffer, msgs, maxNumberOfMsgs);
+    }
+#endif
+
+    return retVal;
+}
+
+#if CAN0_USE_RX_BUFFER || CAN1_USE_RX_BUFFER
+/**
+ * @brief  Reads messages from a receive buffer
+ *
+ * Must only be called by the consumer of the buffer.
+ *
+ * @param  can_rxbuffer: receive buffer
+ * @param  msgs:         where the messages are copied to
+ * @param  numberOfMsgs: maximum number of messages to read
+ *
+ * @retval number of messages read, 0 if the buffer is empty
+ */
+static uint32_t CAN_RxBufferDequeue(CAN_RX_BUFFER_s* can_rxbuffer, Can_PduType* msgs, uint32_t numberOfMsgs) {
+    uint32_t idxRead = can_rxbuffer->idxRead;
+    uint32_t fill = can_rxbuffer->idxWrite - idxRead;
+    CAN_RX_BUFFERELEMENT_s* element = NULL;
+    uint32_t i = 0;
+
+    if (numberOfMsgs > fill) {
+        numberOfMsgs = fill;
+    }
+
+    __DMB();    // read the index before the messages it announces
+    for (i = 0; i < numberOfMsgs; i++) {
+        element = &can_rxbuffer->buffer[(idxRead + i) & (can_rxbuffer->length - 1)];
+        msgs[i].id = element->ID;
+        msgs[i].dlc = element->DLC;
+        memcpy(&msgs[i].sdu[0], &element->Data[0], 8);    // little endian, byte 0 is the LSB of Data[0]
+    }
+    __DMB();    // copy the messages before their elements are released to the producer
+    can_rxbuffer->idxRead = idxRead + numberOfMsgs;
+
+    return numberOfMsgs;
+}
+#endif
+
+STD_RETURN_TYPE_e CAN_GetBufferStatistics(CAN_NodeTypeDef_e canNode, CAN_BUFFER_STATISTICS_s* stats) {
+    STD_RETURN_TYPE_e retVal = E_NOT_OK;
+    CAN_RX_BUFFER_s* can_rxbuffer = NULL;
+    CAN_TX_BUFFER_s* can_txbuffer = NULL;
+    uint8_t nodeUsed = FALSE;
+
+    if (canNode  ==  CAN_NODE0) {
+#if CAN_USE_CAN_NODE0 == 1
+        nodeUsed = TRUE;
+#if CAN0_USE_RX_BUFFER
+        can_rxbuffer = &can0_rxbuffer;
+#endif
+#if CAN0_USE_TX_BUFFER
+        can_txbuffer = &can0_txbuffer;
+#endif
+#endif
+    } else if (canNode  ==  CAN_NODE1) {
+#if CAN_USE_CAN_NODE1 == 1
+        nodeUsed = TRUE;
+#if CAN1_USE_RX_BUFFER
+        can_rxbuffer = &can1_rxbuffer;
+#endif
+#if CAN1_USE_TX_BUFFER
+        can_txbuffer = &can1_txbuffer;
+#endif
+#endif
+    }
+
+    if (nodeUsed == TRUE && stats != NULL) {
+        stats->rxDroppedFrames = (can_rxbuffer != NULL) ? can_rxbuffer->droppedFrames : 0;
+        stats->rxHighWaterMark = (can_rxbuffer != NULL) ? can_rxbuffer->highWaterMark : 0;
+        stats->txDroppedFrames = (can_txbuffer != NULL) ? can_txbuffer->droppedFrames : 0;
+        stats->txHighWaterMark = (can_txbuffer != NULL) ? can_txbuffer->highWaterMark : 0;
+        retVal = E_OK;
+    }
 
     return retVal;
 }
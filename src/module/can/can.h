@@ -54,6 +54,36 @@
 #define CAN1_TX_BUFFER_LENGTH    CAN1_TRANSMIT_BUFFER_LENGTH
 #define CAN1_RX_BUFFER_LENGTH    CAN1_RECEIVE_BUFFER_LENGTH
 
+/* the buffers are rings indexed by free running counters, so their lengths have to be powers of two */
+#define CAN_IS_POWER_OF_TWO(x)   (((x) != 0) && (((x) & ((x) - 1)) == 0))
+
+#if CAN0_USE_TX_BUFFER && !CAN_IS_POWER_OF_TWO(CAN0_TX_BUFFER_LENGTH)
+#error "CAN0_TRANSMIT_BUFFER_LENGTH has to be a power of two"
+#endif
+#if CAN0_USE_RX_BUFFER && !CAN_IS_POWER_OF_TWO(CAN0_RX_BUFFER_LENGTH)
+#error "CAN0_RECEIVE_BUFFER_LENGTH has to be a power of two"
+#endif
+#if CAN1_USE_TX_BUFFER && !CAN_IS_POWER_OF_TWO(CAN1_TX_BUFFER_LENGTH)
+#error "CAN1_TRANSMIT_BUFFER_LENGTH has to be a power of two"
+#endif
+#if CAN1_USE_RX_BUFFER && !CAN_IS_POWER_OF_TWO(CAN1_RX_BUFFER_LENGTH)
+#error "CAN1_RECEIVE_BUFFER_LENGTH has to be a power of two"
+#endif
+
+/**
+ * maximum number of RX messages of a CAN node that are looked up by binary search
+ * over their IDs, see CAN_GetRxMsgIndex(). The RX messages of a node with more
+ * messages are searched linearly. Can be overridden in can_cfg.h.
+ */
+#ifndef CAN_MAX_NUMBER_OF_RX_IDS
+#define CAN_MAX_NUMBER_OF_RX_IDS    64
+#endif
+
+/**
+ * returned by CAN_GetRxMsgIndex() if no RX message is configured for the ID
+ */
+#define CAN_RX_MSG_NOT_FOUND        0xFF
+
 typedef enum {
     CAN_ERROR_NONE = HAL_CAN_ERROR_NONE, /*!< No error             */
     CAN_ERROR_EWG = HAL_CAN_ERROR_EWG, /*!< EWG error            */
@@ -82,31 +112,67 @@ typedef struct CAN_ERROR {
 
 typedef struct CAN_RX_BUFFERELEMENT {
     uint32_t ID;
+    uint32_t Data[2];                           /*!< data field as read from the RDLR and RDHR mailbox registers   */
     uint8_t DLC;
     uint8_t RTR;
-    uint8_t Data[8];
-    uint8_t newMsg;
 } CAN_RX_BUFFERELEMENT_s;
 
+/**
+ * single producer (RX interrupt), single consumer (CAN_ReceiveBuffer()) ring of received messages.
+ * The indices are free running, the element of an index is buffer[index & (length - 1)].
+ */
 typedef struct CAN_RX_BUFFER {
-    uint8_t ptrRead;
-    uint8_t ptrWrite;
-    uint8_t length;
+    volatile uint32_t idxRead;                  /*!< number of messages read, only written by the consumer         */
+    volatile uint32_t idxWrite;                 /*!< number of messages written, only written by the producer      */
+    uint32_t length;                            /*!< number of elements, power of two                               */
+    uint32_t droppedFrames;                     /*!< messages discarded because the buffer was full                */
+    uint32_t highWaterMark;                     /*!< maximum number of unread messages                              */
     CAN_RX_BUFFERELEMENT_s* buffer;
 } CAN_RX_BUFFER_s;
 
+/**
+ * RX messages of a CAN node sorted by ID, built by CAN_Init()
+ */
+typedef struct CAN_RX_ID_TABLE {
+    uint8_t length;                             /*!< number of sorted entries, 0 if the RX messages are searched linearly */
+    uint8_t index[CAN_MAX_NUMBER_OF_RX_IDS];    /*!< indices of the RX messages in ascending order of their IDs          */
+} CAN_RX_ID_TABLE_s;
+
+/**
+ * ID whose reception bypasses the RX buffer, the links of a CAN node are sorted by ID
+ */
+typedef struct CAN_BYPASS_LINK {
+    uint32_t ID;                                /*!< bypassed ID                                                          */
+    uint8_t rxIndex;                            /*!< index of the RX message with this ID, CAN_RX_MSG_NOT_FOUND if none   */
+} CAN_BYPASS_LINK_s;
+
 typedef struct CAN_TX_BUFFERELEMENT {
     CanTxMsgTypeDef msg;
-    uint8_t newMsg;
 } CAN_TX_BUFFERELEMENT_s;
 
+/**
+ * single producer (CAN_Send()), single consumer (CAN_TxMsgBuffer()) ring of messages to transmit.
+ * The indices are free running, the element of an index is buffer[index & (length - 1)].
+ */
 typedef struct CAN_TX_BUFFER {
-    uint8_t ptrRead;
-    uint8_t ptrWrite;
-    uint8_t length;
+    volatile uint32_t idxRead;                  /*!< number of messages transmitted, only written by the consumer  */
+    volatile uint32_t idxWrite;                 /*!< number of messages written, only written by the producer      */
+    uint32_t length;                            /*!< number of elements, power of two                               */
+    uint32_t droppedFrames;                     /*!< messages rejected by CAN_Send() because the buffer was full   */
+    uint32_t highWaterMark;                     /*!< maximum number of pending messages                             */
     CAN_TX_BUFFERELEMENT_s* buffer;
 } CAN_TX_BUFFER_s;
 
+/**
+ * fill statistics of the buffers of a CAN node, see CAN_GetBufferStatistics()
+ */
+typedef struct CAN_BUFFER_STATISTICS {
+    uint32_t rxDroppedFrames;                   /*!< received messages discarded because the RX buffer was full    */
+    uint32_t rxHighWaterMark;                   /*!< maximum number of unread messages in the RX buffer            */
+    uint32_t txDroppedFrames;                   /*!< messages rejected because the TX buffer was full              */
+    uint32_t txHighWaterMark;                   /*!< maximum number of pending messages in the TX buffer           */
+} CAN_BUFFER_STATISTICS_s;
+
 /*================== Constant and Variable Definitions ====================*/
 /**
  * @brief  CAN listen only transceiver mode of CAN node 0
@@ -186,6 +252,9 @@ extern STD_RETURN_TYPE_e CAN_TxMsg(CAN_NodeTypeDef_e canNode, uint32_t msgID, ui
  * @param  RTR     Specifies the type of frame for the message that will be transmitted.
  *                 This parameter can be a value of CAN_remote_transmission_request
  *
+ * The TX buffer has a single producer: CAN_Send() must not be called concurrently
+ * for the same canNode, e.g. from two tasks.
+ *
  * @retval E_OK if successful, E_NOT_OK if buffer is full or error occurred
  */
 extern STD_RETURN_TYPE_e CAN_Send(CAN_NodeTypeDef_e canNode, uint32_t msgID, uint8_t* ptrMsgData,
@@ -212,6 +281,56 @@ extern STD_RETURN_TYPE_e CAN_TxMsgBuffer(CAN_NodeTypeDef_e canNode);
  */
 extern STD_RETURN_TYPE_e CAN_ReceiveBuffer(CAN_NodeTypeDef_e canNode, Can_PduType* msg);
 
+/**
+ * @brief  Reads several can messages from RxBuffer
+ *
+ * @param canNode         canNode on which the messages have been received
+ * @param msgs            array the received messages are copied to
+ * @param maxNumberOfMsgs maximum number of messages to read, i.e., length of msgs
+ *
+ * @retval number of messages read, 0 if buffer empty or invalid pointer
+ */
+extern uint32_t CAN_ReceiveBufferBatch(CAN_NodeTypeDef_e canNode, Can_PduType* msgs, uint32_t maxNumberOfMsgs);
+
+/**
+ * @brief  Looks up the RX message configured for an ID
+ *
+ * The RX messages are sorted by ID in CAN_Init(), so the look-up is a binary search.
+ * If several RX messages are configured for the ID, the first one is returned,
+ * the others are returned by CAN_GetNextRxMsgIndex().
+ *
+ * @param canNode canNode on which the message has been received
+ * @param msgID   ID of the message
+ *
+ * @retval index of the message in can0_RxMsgs or can1_RxMsgs, CAN_RX_MSG_NOT_FOUND if the ID is not configured
+ */
+extern uint8_t CAN_GetRxMsgIndex(CAN_NodeTypeDef_e canNode, uint32_t msgID);
+
+/**
+ * @brief  Looks up the next RX message configured for the same ID
+ *
+ * Iterates over all RX messages configured for an ID in the configured order:
+ * starting with previous = CAN_RX_MSG_NOT_FOUND, each call returns the RX
+ * message following previous.
+ *
+ * @param canNode  canNode on which the message has been received
+ * @param msgID    ID of the message
+ * @param previous index returned by the previous call, CAN_RX_MSG_NOT_FOUND for the first one
+ *
+ * @retval index of the message in can0_RxMsgs or can1_RxMsgs, CAN_RX_MSG_NOT_FOUND if there is no further message
+ */
+extern uint8_t CAN_GetNextRxMsgIndex(CAN_NodeTypeDef_e canNode, uint32_t msgID, uint8_t previous);
+
+/**
+ * @brief  Gets the number of dropped messages and the high-water marks of the buffers
+ *
+ * @param canNode CAN node of the buffers
+ * @param stats   where the statistics are copied to, 0 for a buffer that is not used
+ *
+ * @retval E_OK if the statistics were copied, E_NOT_OK if canNode is not used or stats is NULL
+ */
+extern STD_RETURN_TYPE_e CAN_GetBufferStatistics(CAN_NodeTypeDef_e canNode, CAN_BUFFER_STATISTICS_s* stats);
+
 /* Sleep mode */
 
 /**
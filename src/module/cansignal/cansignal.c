@@ -51,6 +51,11 @@
 #include "database.h"
 /*================== Macros and Definitions ===============================*/
 
+/**
+ * end of a list of TX messages in the timing wheel
+ */
+#define CANS_TX_NONE    0xFF
+
 /*================== Constant and Variable Definitions ====================*/
 static CANS_STATE_s cans_state = {
         .periodic_enable = FALSE,
@@ -58,23 +63,85 @@ static CANS_STATE_s cans_state = {
         .current_sensor_cc_present = FALSE,
     };
 
+/**
+ * signals of each RX message in cans_CAN0_signals_rx or cans_CAN1_signals_rx,
+ * indexed by CANS_messagesRx_e, see CANS_InitSignalRanges()
+ */
+static CANS_SIGNAL_RANGE_s cans_rxSignalRange[CANS_MAX_NUMBER_OF_RX_MESSAGES];
+static uint8_t cans_rxSignalRangeValid = FALSE;
+
+/**
+ * signals of each TX message in cans_CAN0_signals_tx or cans_CAN1_signals_tx,
+ * indexed by CANS_messagesTx_e
+ */
+static CANS_SIGNAL_RANGE_s cans_txSignalRange[CANS_MAX_NUMBER_OF_TX_MESSAGES];
+static uint8_t cans_txSignalRangeValid = FALSE;
+
+/**
+ * timing wheel of the periodic TX messages: each slot holds a list of the messages,
+ * in ascending order, whose next transmission tick modulo CANS_TX_WHEEL_SLOTS is the
+ * slot. Ticks are compared by their difference, so the counter may overflow.
+ */
+static uint8_t cans_txWheel[CANS_TX_WHEEL_SLOTS];
+static uint8_t cans_txNext[CANS_MAX_NUMBER_OF_TX_MESSAGES];
+static uint32_t cans_txDueTick[CANS_MAX_NUMBER_OF_TX_MESSAGES];
+static uint32_t cans_txPeriodTicks[CANS_MAX_NUMBER_OF_TX_MESSAGES];
+static CANS_TX_TIMING_s cans_txTiming[CANS_MAX_NUMBER_OF_TX_MESSAGES];
+static uint32_t cans_txTick = 0;
+static uint8_t cans_txWheelValid = FALSE;
+
 static DATA_BLOCK_STATEREQUEST_s canstatereq_tab;
+static DATA_BLOCK_ERRORSTATE_s cans_errorstate_tab;
+static DATA_BLOCK_CURRENT_s cans_current_tab;
+
+/**
+ * versions of the local copies of the data blocks, see CANS_UpdateBlock()
+ */
+static uint32_t cans_statereq_version = 0xFFFFFFFF;
+static uint32_t cans_errorstate_version = 0xFFFFFFFF;
+static uint32_t cans_current_version = 0xFFFFFFFF;
 
 /*================== Function Prototypes ==================================*/
 static STD_RETURN_TYPE_e CANS_PeriodicTransmit(void);
 static STD_RETURN_TYPE_e CANS_PeriodicReceive(void);
-static void CANS_SetSignalData(CANS_signal_s signal, uint64_t value, uint8_t *dataPtr);
-static void CANS_GetSignalData(uint64_t *dst, CANS_signal_s signal, uint8_t *dataPtr);
+static uint64_t CANS_LoadPayload(const uint8_t *dataPtr);
+static void CANS_StorePayload(uint64_t payload, uint8_t *dataPtr);
+static uint64_t CANS_SetSignalData(const CANS_signal_s *signal, uint64_t value, uint64_t payload);
+static void CANS_GetSignalData(uint64_t *dst, const CANS_signal_s *signal, uint64_t payload);
 static void CANS_ComposeMessage(CAN_NodeTypeDef_e canNode, CANS_messagesTx_e msgIdx, uint8_t dataptr[]);
 static void CANS_ParseMessage(CAN_NodeTypeDef_e canNode, CANS_messagesRx_e msgIdx, uint8_t dataptr[]);
 static uint8_t CANS_CheckCanTiming(void);
+static void CANS_UpdateBlock(void *dataptr, DATA_BLOCK_ID_TYPE_e blockID, uint32_t *version);
 static void CANS_SetCurrentSensorPresent(uint8_t command);
 static void CANS_SetCurrentSensorCCPresent(uint8_t command);
+static void CANS_InitSignalRanges(CANS_SIGNAL_RANGE_s *ranges, uint16_t nrOfRanges, uint8_t tx,
+        const CANS_signal_s *signals, uint16_t nrOfSignals);
+static void CANS_InitTxWheel(void);
+static void CANS_TxWheelInsert(uint8_t txIdx);
+static STD_RETURN_TYPE_e CANS_TransmitMessage(CAN_NodeTypeDef_e canNode, uint32_t i);
 /*================== Function Implementations =============================*/
 
 /*================== Public functions =====================================*/
 void CANS_Init(void) {
-    // custom initialization could be made here. right now no need for any init
+    uint16_t i = 0;
+
+    for (i = 0; i < CANS_MAX_NUMBER_OF_RX_MESSAGES; i++) {
+        cans_rxSignalRange[i].first = 0;
+        cans_rxSignalRange[i].end = 0;
+    }
+    CANS_InitSignalRanges(cans_rxSignalRange, CANS_MAX_NUMBER_OF_RX_MESSAGES, FALSE, &cans_CAN0_signals_rx[0], cans_CAN0_signals_rx_length);
+    CANS_InitSignalRanges(cans_rxSignalRange, CANS_MAX_NUMBER_OF_RX_MESSAGES, FALSE, &cans_CAN1_signals_rx[0], cans_CAN1_signals_rx_length);
+    cans_rxSignalRangeValid = TRUE;
+
+    for (i = 0; i < CANS_MAX_NUMBER_OF_TX_MESSAGES; i++) {
+        cans_txSignalRange[i].first = 0;
+        cans_txSignalRange[i].end = 0;
+    }
+    CANS_InitSignalRanges(cans_txSignalRange, CANS_MAX_NUMBER_OF_TX_MESSAGES, TRUE, &cans_CAN0_signals_tx[0], cans_CAN0_signals_tx_length);
+    CANS_InitSignalRanges(cans_txSignalRange, CANS_MAX_NUMBER_OF_TX_MESSAGES, TRUE, &cans_CAN1_signals_tx[0], cans_CAN1_signals_tx_length);
+    cans_txSignalRangeValid = TRUE;
+
+    CANS_InitTxWheel();
 }
 
 void CANS_MainFunction(void) {
@@ -91,73 +158,210 @@ void CANS_MainFunction(void) {
 /**
  * handles the processing of messages that are meant to be transmitted.
  *
- * This function looks for the repetition times and the repetition phase of
- * messages that are intended to be sent periodically. If a comparison with
- * an internal counter (i.e., the counter how often this function has been called)
- * states that a transmit is pending, the message is composed by call of CANS_ComposeMessage
- * and transfered to the buffer of the CAN module. If a callback function
+ * This function looks for the messages that are intended to be sent periodically
+ * and are due in the current tick. The messages are scheduled by a timing wheel
+ * (see CANS_InitTxWheel()), so only the slot of the current tick is visited. A due
+ * message is composed by call of CANS_ComposeMessage, transfered to the buffer of
+ * the CAN module and scheduled for its next transmission. If a callback function
  * is declared in configuration, this callback is called after successful transmission.
+ * Without CANS_Init(), the repetition time and phase of all messages are compared
+ * with the internal tick counter.
  *
  * @return E_OK if a successful transfer to CAN buffer occured, E_NOT_OK otherwise
  */
 static STD_RETURN_TYPE_e CANS_PeriodicTransmit(void) {
-    static uint32_t counter_ticks = 0;
     uint32_t i = 0;
-    STD_RETURN_TYPE_e result = E_NOT_OK;
-
-#if CAN_USE_CAN_NODE0 == TRUE
-    for (i = 0; i < can_CAN0_tx_length; i++) {
-        if (((counter_ticks * CANS_TICK_MS) % (can_CAN0_messages_tx[i].repetition_time)) == can_CAN0_messages_tx[i].repetition_phase) {
-            Can_PduType PduToSend = { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, 0x0, 8 };
-            CANS_ComposeMessage(CAN_NODE0, (CANS_messagesTx_e)(i), PduToSend.sdu);
-            PduToSend.id = can_CAN0_messages_tx[i].ID;
-
-            result = CAN_Send(CAN_NODE0, PduToSend.id, PduToSend.sdu, PduToSend.dlc, 0);
+    uint8_t txIdx = CANS_TX_NONE;
+    uint8_t due = CANS_TX_NONE;
+    uint8_t *link = NULL_PTR;
+    uint8_t *dueLink = &due;
+    uint32_t slot = cans_txTick & (CANS_TX_WHEEL_SLOTS - 1);
+
+    if (cans_txWheelValid == TRUE) {
+        // unlink the messages of the slot that are due in this tick, the others wait for a later turn
+        link = &cans_txWheel[slot];
+        while (*link != CANS_TX_NONE) {
+            txIdx = *link;
+            if (cans_txDueTick[txIdx] == cans_txTick) {
+                *link = cans_txNext[txIdx];
+                cans_txNext[txIdx] = CANS_TX_NONE;
+                *dueLink = txIdx;
+                dueLink = &cans_txNext[txIdx];
+            } else {
+                link = &cans_txNext[txIdx];
+            }
+        }
 
-            if (result == E_NOT_OK) {
-                DIAG_Handler(DIAG_CH_CANS_CAN_MOD_FAILURE, DIAG_EVENT_NOK, 1, NULL_PTR);
+        while (due != CANS_TX_NONE) {
+            txIdx = due;
+            due = cans_txNext[txIdx];
+            if (txIdx < can_CAN0_tx_length) {
+                (void)CANS_TransmitMessage(CAN_NODE0, txIdx);
             } else {
-                DIAG_Handler(DIAG_CH_CANS_CAN_MOD_FAILURE, DIAG_EVENT_OK, 1, NULL_PTR);
+                (void)CANS_TransmitMessage(CAN_NODE1, txIdx - can_CAN0_tx_length);
             }
-            if (can_CAN0_messages_tx[i].cbk_func != NULL_PTR && result == E_OK) {
-                can_CAN0_messages_tx[i].cbk_func(i, NULL_PTR);
+            cans_txDueTick[txIdx] += cans_txPeriodTicks[txIdx];
+            CANS_TxWheelInsert(txIdx);
+        }
+    } else {
+#if CAN_USE_CAN_NODE0 == TRUE
+        for (i = 0; i < can_CAN0_tx_length; i++) {
+            if (((cans_txTick * CANS_TICK_MS) % (can_CAN0_messages_tx[i].repetition_time)) == can_CAN0_messages_tx[i].repetition_phase) {
+                (void)CANS_TransmitMessage(CAN_NODE0, i);
             }
         }
-    }
 #endif
 
 #if CAN_USE_CAN_NODE1 == TRUE
-    for (i = 0; i < can_CAN1_tx_length; i++) {
-        if (((counter_ticks * CANS_TICK_MS) % (can_CAN1_messages_tx[i].repetition_time)) == can_CAN1_messages_tx[i].repetition_phase) {
-            Can_PduType PduToSend = { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, 0x0, 8 };
-            CANS_ComposeMessage(CAN_NODE1, (CANS_messagesTx_e)i + can_CAN0_tx_length, PduToSend.sdu);
-            PduToSend.id = can_CAN1_messages_tx[i].ID;
+        for (i = 0; i < can_CAN1_tx_length; i++) {
+            if (((cans_txTick * CANS_TICK_MS) % (can_CAN1_messages_tx[i].repetition_time)) == can_CAN1_messages_tx[i].repetition_phase) {
+                (void)CANS_TransmitMessage(CAN_NODE1, i);
+            }
+        }
+#endif
+    }
+
+    cans_txTick++;
+    return TRUE;
+}
 
-            result = CAN_Send(CAN_NODE1, PduToSend.id, PduToSend.sdu, PduToSend.dlc, 0);
+/**
+ * composes a TX message and transfers it to the buffer of the CAN module.
+ *
+ * @param   canNode     CAN node of the message
+ * @param   i           index of the message in can_CAN0_messages_tx or can_CAN1_messages_tx
+ *
+ * @return  E_OK if the message was transfered to the CAN buffer, E_NOT_OK otherwise
+ */
+static STD_RETURN_TYPE_e CANS_TransmitMessage(CAN_NodeTypeDef_e canNode, uint32_t i) {
+    STD_RETURN_TYPE_e result = E_NOT_OK;
+    const CAN_MSG_TX_TYPE_s *msg = NULL_PTR;
+    uint32_t txIdx = 0;
+    uint32_t now = 0;
+    uint32_t delta = 0;
+    uint32_t jitter = 0;
+    uint8_t diagData = 0;
+    Can_PduType PduToSend = { { 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, 0x0, 8 };
 
-            if (result == E_NOT_OK) {
-                DIAG_Handler(DIAG_CH_CANS_CAN_MOD_FAILURE, DIAG_EVENT_NOK, 0, NULL_PTR);
-            } else {
-                DIAG_Handler(DIAG_CH_CANS_CAN_MOD_FAILURE, DIAG_EVENT_OK, 0, NULL_PTR);
-            }
-            if (can_CAN1_messages_tx[i].cbk_func != NULL_PTR && result == E_OK) {
-                can_CAN1_messages_tx[i].cbk_func(i, NULL_PTR);
+    if (canNode == CAN_NODE0) {
+        msg = &can_CAN0_messages_tx[i];
+        txIdx = i;
+        diagData = 1;
+    } else {
+        msg = &can_CAN1_messages_tx[i];
+        txIdx = i + can_CAN0_tx_length;
+        diagData = 0;
+    }
+
+    CANS_ComposeMessage(canNode, (CANS_messagesTx_e)txIdx, PduToSend.sdu);
+    PduToSend.id = msg->ID;
+
+    result = CAN_Send(canNode, PduToSend.id, PduToSend.sdu, PduToSend.dlc, 0);
+
+    if (result == E_NOT_OK) {
+        DIAG_Handler(DIAG_CH_CANS_CAN_MOD_FAILURE, DIAG_EVENT_NOK, diagData, NULL_PTR);
+    } else {
+        DIAG_Handler(DIAG_CH_CANS_CAN_MOD_FAILURE, DIAG_EVENT_OK, diagData, NULL_PTR);
+    }
+    if (msg->cbk_func != NULL_PTR && result == E_OK) {
+        msg->cbk_func(i, NULL_PTR);
+    }
+
+    if (txIdx < CANS_MAX_NUMBER_OF_TX_MESSAGES) {
+        now = MCU_GetTimeStamp();
+        if (cans_txTiming[txIdx].nrOfTransmits > 0) {
+            delta = now - cans_txTiming[txIdx].lastTimestamp;
+            jitter = (delta > msg->repetition_time) ? delta - msg->repetition_time : msg->repetition_time - delta;
+            if (jitter > cans_txTiming[txIdx].maxJitter_ms) {
+                cans_txTiming[txIdx].maxJitter_ms = jitter;
             }
         }
+        cans_txTiming[txIdx].lastTimestamp = now;
+        cans_txTiming[txIdx].nrOfTransmits++;
+    }
+
+    return result;
+}
+
+/**
+ * @brief   schedules all periodic TX messages in the timing wheel
+ *
+ * A message is first transmitted in the tick at which the former schedule, which
+ * compared (tick * CANS_TICK_MS) % repetition_time with repetition_phase, transmitted
+ * it. The timing wheel is only used if all TX messages fit into the tables
+ * (CANS_MAX_NUMBER_OF_TX_MESSAGES).
+ *
+ * @return  none
+ */
+static void CANS_InitTxWheel(void) {
+    uint32_t i = 0;
+    uint32_t nrOfMessages = can_CAN0_tx_length + can_CAN1_tx_length;
+    const CAN_MSG_TX_TYPE_s *msg = NULL_PTR;
+
+    cans_txWheelValid = FALSE;
+    if (nrOfMessages > CANS_MAX_NUMBER_OF_TX_MESSAGES || nrOfMessages >= CANS_TX_NONE) {
+        return;
+    }
+
+    for (i = 0; i < CANS_TX_WHEEL_SLOTS; i++) {
+        cans_txWheel[i] = CANS_TX_NONE;
     }
+
+    for (i = 0; i < nrOfMessages; i++) {
+        cans_txNext[i] = CANS_TX_NONE;
+        cans_txTiming[i].nrOfTransmits = 0;
+        cans_txTiming[i].lastTimestamp = 0;
+        cans_txTiming[i].maxJitter_ms = 0;
+
+        if (i < can_CAN0_tx_length) {
+#if CAN_USE_CAN_NODE0 != TRUE
+            continue;
+#endif
+            msg = &can_CAN0_messages_tx[i];
+        } else {
+#if CAN_USE_CAN_NODE1 != TRUE
+            continue;
 #endif
+            msg = &can_CAN1_messages_tx[i - can_CAN0_tx_length];
+        }
 
-    result = E_NOT_OK;
+        cans_txPeriodTicks[i] = msg->repetition_time / CANS_TICK_MS;
+        if (cans_txPeriodTicks[i] == 0) {
+            cans_txPeriodTicks[i] = 1;
+        }
+        cans_txDueTick[i] = cans_txTick + ((msg->repetition_phase + CANS_TICK_MS - 1) / CANS_TICK_MS);
+        CANS_TxWheelInsert(i);
+    }
 
-    counter_ticks++;
-    return TRUE;
+    cans_txWheelValid = TRUE;
+}
+
+/**
+ * @brief   inserts a TX message into the slot of its next transmission tick
+ *
+ * The list of the slot is kept in ascending order of the message index, so the
+ * messages of a tick are transmitted in the order of the configuration.
+ *
+ * @param   txIdx   TX message, node 1 messages follow the node 0 messages
+ *
+ * @return  none
+ */
+static void CANS_TxWheelInsert(uint8_t txIdx) {
+    uint8_t *link = &cans_txWheel[cans_txDueTick[txIdx] & (CANS_TX_WHEEL_SLOTS - 1)];
+
+    while (*link != CANS_TX_NONE && *link < txIdx) {
+        link = &cans_txNext[*link];
+    }
+    cans_txNext[txIdx] = *link;
+    *link = txIdx;
 }
 
 /**
  * handles the processing of received CAN messages.
  *
  * This function gets the messages in the receive buffer
- * of the CAN module. If a message ID is
+ * of the CAN module, up to CANS_RX_BATCH_SIZE per call of
+ * CAN_ReceiveBufferBatch(). If a message ID is
  * matching one of the IDs in the configuration of
  * CANS module, the signal processing is executed
  * by call to CANS_ParseMessage.
@@ -165,32 +369,42 @@ static STD_RETURN_TYPE_e CANS_PeriodicTransmit(void) {
  * @return E_OK, if a message has been received and parsed, E_NOT_OK otherwise
  */
 static STD_RETURN_TYPE_e CANS_PeriodicReceive(void) {
-    Can_PduType msg = {};
+    Can_PduType msgs[CANS_RX_BATCH_SIZE];
     STD_RETURN_TYPE_e result_node0 = E_NOT_OK, result_node1 = E_NOT_OK;
+    uint32_t nrOfMsgs = 0;
     uint32_t i = 0;
+    uint32_t j = 0;
 
 #if CAN_USE_CAN_NODE0 == TRUE
-    while (CAN_ReceiveBuffer(CAN_NODE0, &msg)  ==  E_OK) {
-        for (i = 0; i < can_CAN0_rx_length; i++) {
-            if (msg.id  ==  can0_RxMsgs[i].ID) {
-                CANS_ParseMessage(CAN_NODE0, (CANS_messagesRx_e)i, msg.sdu);
+    do {
+        nrOfMsgs = CAN_ReceiveBufferBatch(CAN_NODE0, &msgs[0], CANS_RX_BATCH_SIZE);
+        for (j = 0; j < nrOfMsgs; j++) {
+            // all RX messages configured for the ID are parsed
+            i = CAN_GetRxMsgIndex(CAN_NODE0, msgs[j].id);
+            while (i != CAN_RX_MSG_NOT_FOUND) {
+                CANS_ParseMessage(CAN_NODE0, (CANS_messagesRx_e)i, msgs[j].sdu);
                 result_node0 = E_OK;
+                i = CAN_GetNextRxMsgIndex(CAN_NODE0, msgs[j].id, (uint8_t)i);
             }
         }
-    }
+    } while (nrOfMsgs == CANS_RX_BATCH_SIZE);
 #else
     result_node0 = E_OK;
 #endif
 
 #if CAN_USE_CAN_NODE1 == TRUE
-    while (CAN_ReceiveBuffer(CAN_NODE1, &msg) == E_OK) {
-        for (i = 0; i < can_CAN1_rx_length; i++) {
-            if (msg.id == can1_RxMsgs[i].ID) {
-                CANS_ParseMessage(CAN_NODE1, (CANS_messagesRx_e)i + can_CAN0_rx_length, msg.sdu);
+    do {
+        nrOfMsgs = CAN_ReceiveBufferBatch(CAN_NODE1, &msgs[0], CANS_RX_BATCH_SIZE);
+        for (j = 0; j < nrOfMsgs; j++) {
+            // all RX messages configured for the ID are parsed
+            i = CAN_GetRxMsgIndex(CAN_NODE1, msgs[j].id);
+            while (i != CAN_RX_MSG_NOT_FOUND) {
+                CANS_ParseMessage(CAN_NODE1, (CANS_messagesRx_e)i + can_CAN0_rx_length, msgs[j].sdu);
                 result_node1 = E_OK;
+                i = CAN_GetNextRxMsgIndex(CAN_NODE1, msgs[j].id, (uint8_t)i);
             }
         }
-    }
+    } while (nrOfMsgs == CANS_RX_BATCH_SIZE);
 #else
     result_node1 = E_OK;
 #endif
@@ -205,13 +419,46 @@ static STD_RETURN_TYPE_e CANS_PeriodicReceive(void) {
  * @return  bitmask     bitfield mask
  */
 static uint64_t CANS_GetBitmask(uint8_t bitlength) {
-    uint64_t bitmask = 0x00000000;
-    uint8_t i = 0;
-    for (i = 0; i < bitlength; i++) {
-        bitmask = bitmask << 1;
-        bitmask = bitmask | 0x00000001;
-    }
-    return bitmask;
+    return (bitlength >= 64) ? UINT64_MAX : ((((uint64_t)1) << bitlength) - 1);
+}
+
+/**
+ * @brief   reads the 8 byte CAN message data as one little endian value
+ *
+ * Byte 0 of the message is the least significant byte, independent of the
+ * alignment of dataPtr and the byte order of the MCU.
+ *
+ * @param   dataPtr     CAN message data
+ *
+ * @return  payload     message data as 64 bit value
+ */
+static uint64_t CANS_LoadPayload(const uint8_t *dataPtr) {
+    uint32_t low = ((uint32_t)dataPtr[0]) | ((uint32_t)dataPtr[1] << 8) |
+                   ((uint32_t)dataPtr[2] << 16) | ((uint32_t)dataPtr[3] << 24);
+    uint32_t high = ((uint32_t)dataPtr[4]) | ((uint32_t)dataPtr[5] << 8) |
+                    ((uint32_t)dataPtr[6] << 16) | ((uint32_t)dataPtr[7] << 24);
+
+    return (((uint64_t)high) << 32) | low;
+}
+
+/**
+ * @brief   writes a little endian 64 bit value to the 8 byte CAN message data
+ *
+ * @param   payload     message data as 64 bit value, see CANS_LoadPayload()
+ * @param   dataPtr     CAN message data
+ */
+static void CANS_StorePayload(uint64_t payload, uint8_t *dataPtr) {
+    uint32_t low = (uint32_t)payload;
+    uint32_t high = (uint32_t)(payload >> 32);
+
+    dataPtr[0] = (uint8_t)low;
+    dataPtr[1] = (uint8_t)(low >> 8);
+    dataPtr[2] = (uint8_t)(low >> 16);
+    dataPtr[3] = (uint8_t)(low >> 24);
+    dataPtr[4] = (uint8_t)high;
+    dataPtr[5] = (uint8_t)(high >> 8);
+    dataPtr[6] = (uint8_t)(high >> 16);
+    dataPtr[7] = (uint8_t)(high >> 24);
 }
 
 /**
@@ -219,23 +466,19 @@ static uint64_t CANS_GetBitmask(uint8_t bitlength) {
  *
  * @param[out] dst       pointer where the signal data should be copied to
  * @param[in]  signal    signal identifier
- * @param[in]  dataPtr   CAN message data, from which signal data is extracted
+ * @param[in]  payload   CAN message data, see CANS_LoadPayload()
  */
-static void CANS_GetSignalData(uint64_t *dst, CANS_signal_s signal, uint8_t *dataPtr) {
-    uint8_t bitposition = signal.bit_position;
-    uint8_t bitlength = (uint8_t)signal.bit_length;
-    uint64_t bitmask = 0x00000000;
-    uint64_t *dataPtr64 = (uint64_t *)dataPtr;
-
-    bitmask = CANS_GetBitmask(bitlength);
-    *dst = (((*dataPtr64) >> bitposition) & bitmask);
+static void CANS_GetSignalData(uint64_t *dst, const CANS_signal_s *signal, uint64_t payload) {
+    uint64_t bitmask = CANS_GetBitmask((uint8_t)signal->bit_length);
+
+    *dst = ((payload >> signal->bit_position) & bitmask);
     // *dst = signal.factor*(float)(((*dataPtr64) >> bitposition) & bitmask) + signal.offset;
-    if (*dst > signal.max) {
+    if (*dst > signal->max) {
         DIAG_Handler(DIAG_CH_CANS_MAX_VALUE_VIOLATE, DIAG_EVENT_NOK, 0, NULL);
     } else {
         DIAG_Handler(DIAG_CH_CANS_MAX_VALUE_VIOLATE, DIAG_EVENT_OK, 0, NULL);
     }
-    if (*dst < signal.min) {
+    if (*dst < signal->min) {
         DIAG_Handler(DIAG_CH_CANS_MIN_VALUE_VIOLATE, DIAG_EVENT_NOK, 0, NULL);
     } else {
         DIAG_Handler(DIAG_CH_CANS_MIN_VALUE_VIOLATE, DIAG_EVENT_OK, 0, NULL);
@@ -246,17 +489,16 @@ static void CANS_GetSignalData(uint64_t *dst, CANS_signal_s signal, uint8_t *dat
  *
  * @param signal    signal identifier
  * @param value     signal value data
- * @param dataPtr   CAN message data, in which the signal data is inserted
+ * @param payload   CAN message data, see CANS_LoadPayload()
+ *
+ * @return  payload with the signal data inserted
  */
-static void CANS_SetSignalData(CANS_signal_s signal, uint64_t value, uint8_t *dataPtr) {
-    uint8_t bitposition = signal.bit_position;
-    uint8_t bitlength = (uint8_t)signal.bit_length;
-    uint64_t bitmask = 0x0000000000000000;
-    uint64_t *dataPtr64 = (uint64_t *)dataPtr;
-
-    bitmask = CANS_GetBitmask(bitlength);
-    dataPtr64[0] &= ~(((uint64_t)bitmask) << bitposition);
-    dataPtr64[0] |= ((((uint64_t)value) & bitmask) << bitposition);
+static uint64_t CANS_SetSignalData(const CANS_signal_s *signal, uint64_t value, uint64_t payload) {
+    uint64_t bitmask = CANS_GetBitmask((uint8_t)signal->bit_length);
+
+    payload &= ~(bitmask << signal->bit_position);
+    payload |= ((value & bitmask) << signal->bit_position);
+    return payload;
 }
 
 /**
@@ -269,20 +511,31 @@ static void CANS_SetSignalData(CANS_signal_s signal, uint64_t value, uint8_t *da
  */
 static void CANS_ComposeMessage(CAN_NodeTypeDef_e canNode, CANS_messagesTx_e msgIdx, uint8_t dataptr[]) {
     uint32_t i = 0;
-    uint32_t nrTxSignals = 0;
+    uint32_t first = 0;
+    uint32_t end = 0;
+    uint64_t payload = 0;
     // find multiplexor if multiplexed signal
 
-    CANS_signal_s *cans_signals_tx;
+    const CANS_signal_s *cans_signals_tx = NULL;
 
     if (canNode == CAN_NODE0) {
-        cans_signals_tx = (CANS_signal_s *)&cans_CAN0_signals_tx;
-        nrTxSignals = cans_CAN0_signals_tx_length;
+        cans_signals_tx = &cans_CAN0_signals_tx[0];
+        end = cans_CAN0_signals_tx_length;
     } else if (canNode == CAN_NODE1) {
-        cans_signals_tx = (CANS_signal_s *)&cans_CAN1_signals_tx;
-        nrTxSignals = cans_CAN1_signals_tx_length;
+        cans_signals_tx = &cans_CAN1_signals_tx[0];
+        end = cans_CAN1_signals_tx_length;
+    } else {
+        return;
+    }
+
+    if (cans_txSignalRangeValid == TRUE && msgIdx < CANS_MAX_NUMBER_OF_TX_MESSAGES) {
+        first = cans_txSignalRange[msgIdx].first;
+        end = cans_txSignalRange[msgIdx].end;
     }
 
-    for (i = 0; i < nrTxSignals; i++) {
+    // the message data is composed in a register and written once
+    payload = CANS_LoadPayload(dataptr);
+    for (i = first; i < end; i++) {
         if (cans_signals_tx[i].msgIdx.Tx == msgIdx) {
 
             // simple, not multiplexed signal
@@ -290,12 +543,13 @@ static void CANS_ComposeMessage(CAN_NodeTypeDef_e canNode, CANS_messagesTx_e msg
             if (cans_signals_tx[i].getter != NULL_PTR) {
                 cans_signals_tx[i].getter(i, &value);
             }
-            CANS_SetSignalData(cans_signals_tx[i], value, dataptr);
+            payload = CANS_SetSignalData(&cans_signals_tx[i], value, payload);
         } else {
             ;
             // do nothing
         }
     }
+    CANS_StorePayload(payload, dataptr);
 }
 /**
  * @brief   parses signal data from message associated with this msgIdx
@@ -307,26 +561,38 @@ static void CANS_ComposeMessage(CAN_NodeTypeDef_e canNode, CANS_messagesTx_e msg
 */
 static void CANS_ParseMessage(CAN_NodeTypeDef_e canNode, CANS_messagesRx_e msgIdx, uint8_t dataptr[]) {
     uint32_t i = 0;
+    uint32_t first = 0;
+    uint32_t end = 0;
+    uint64_t payload = CANS_LoadPayload(dataptr);
+
+    if (cans_rxSignalRangeValid == TRUE && msgIdx < CANS_MAX_NUMBER_OF_RX_MESSAGES) {
+        first = cans_rxSignalRange[msgIdx].first;
+        end = cans_rxSignalRange[msgIdx].end;
+    } else if (canNode == CAN_NODE0) {
+        end = cans_CAN0_signals_rx_length;
+    } else if (canNode == CAN_NODE1) {
+        end = cans_CAN1_signals_rx_length;
+    }
 
     if (canNode == CAN_NODE0) {
-        for (i = 0; i < cans_CAN0_signals_rx_length; i++) {
+        for (i = first; i < end; i++) {
             /* Iterate over CAN0 rx signals and find message */
 
             if (cans_CAN0_signals_rx[i].msgIdx.Rx  ==  msgIdx) {
                 uint64_t value = 0;
-                CANS_GetSignalData(&value, cans_CAN0_signals_rx[i], dataptr);
+                CANS_GetSignalData(&value, &cans_CAN0_signals_rx[i], payload);
                 if (cans_CAN0_signals_rx[i].setter != NULL_PTR) {
                     cans_CAN0_signals_rx[i].setter(i, &value);
                 }
             }
         }
     } else if (canNode == CAN_NODE1) {
-        for (i = 0; i < cans_CAN1_signals_rx_length; i++) {
+        for (i = first; i < end; i++) {
             /* Iterate over CAN1 rx signals and find message */
 
             if (cans_CAN1_signals_rx[i].msgIdx.Rx  ==  msgIdx) {
                 uint64_t value = 0;
-                CANS_GetSignalData(&value, cans_CAN1_signals_rx[i], dataptr);
+                CANS_GetSignalData(&value, &cans_CAN1_signals_rx[i], payload);
                 if (cans_CAN1_signals_rx[i].setter != NULL_PTR) {
                     cans_CAN1_signals_rx[i].setter(cans_CAN0_signals_rx_length + i, &value);
                 }
@@ -335,6 +601,37 @@ static void CANS_ParseMessage(CAN_NodeTypeDef_e canNode, CANS_messagesRx_e msgId
     }
 }
 
+/**
+ * @brief   determines the range of the signals of each message in a signal table
+ *
+ * The signals of a message are usually configured one after the other. Signals of
+ * other messages within the range are skipped by CANS_ParseMessage() and
+ * CANS_ComposeMessage().
+ *
+ * @param   ranges       range table indexed by message, see cans_rxSignalRange
+ * @param   nrOfRanges   number of entries of the range table
+ * @param   tx           TRUE for a TX signal table, FALSE for an RX signal table
+ * @param   signals      signal table of a CAN node
+ * @param   nrOfSignals  number of signals in the table
+ *
+ * @return  none
+ */
+static void CANS_InitSignalRanges(CANS_SIGNAL_RANGE_s *ranges, uint16_t nrOfRanges, uint8_t tx,
+        const CANS_signal_s *signals, uint16_t nrOfSignals) {
+    uint16_t i = 0;
+    uint32_t msgIdx = 0;
+
+    for (i = 0; i < nrOfSignals; i++) {
+        msgIdx = (tx == TRUE) ? (uint32_t)signals[i].msgIdx.Tx : (uint32_t)signals[i].msgIdx.Rx;
+        if (msgIdx < nrOfRanges) {
+            if (ranges[msgIdx].end == 0) {
+                ranges[msgIdx].first = i;
+            }
+            ranges[msgIdx].end = i + 1;
+        }
+    }
+}
+
 /**
  * @brief   Checks if the CAN messages come in the specified time window
  *
@@ -348,14 +645,12 @@ static uint8_t CANS_CheckCanTiming(void) {
     uint8_t retVal = FALSE;
 
     uint32_t current_time;
-    DATA_BLOCK_ERRORSTATE_s error_flags;
-    DATA_BLOCK_CURRENT_s current_tab;
 
 
     current_time = MCU_GetTimeStamp();
-    DB_ReadBlock(&canstatereq_tab, DATA_BLOCK_ID_STATEREQUEST);
+    CANS_UpdateBlock(&canstatereq_tab, DATA_BLOCK_ID_STATEREQUEST, &cans_statereq_version);
 
-    DB_ReadBlock(&error_flags, DATA_BLOCK_ID_ERRORSTATE);
+    CANS_UpdateBlock(&cans_errorstate_tab, DATA_BLOCK_ID_ERRORSTATE, &cans_errorstate_version);
 
     // Is the BMS still getting CAN messages?
     if ((current_time-canstatereq_tab.timestamp) <= 105) {
@@ -373,8 +668,8 @@ static uint8_t CANS_CheckCanTiming(void) {
     }
 
     // check time stamps of current measurements
-    DB_ReadBlock(&current_tab, DATA_BLOCK_ID_CURRENT);
-    if (current_time-current_tab.timestamp > CANS_SENSOR_RESPONSE_TIMEOUT_MS) {
+    CANS_UpdateBlock(&cans_current_tab, DATA_BLOCK_ID_CURRENT, &cans_current_version);
+    if (current_time-cans_current_tab.timestamp > CANS_SENSOR_RESPONSE_TIMEOUT_MS) {
         DIAG_Handler(DIAG_CH_CURRENT_SENSOR_RESPONDING, DIAG_EVENT_NOK, 0, NULL_PTR);
     } else {
         DIAG_Handler(DIAG_CH_CURRENT_SENSOR_RESPONDING, DIAG_EVENT_OK, 0, NULL_PTR);
@@ -384,8 +679,8 @@ static uint8_t CANS_CheckCanTiming(void) {
     }
 
     // check time stamps of CC measurements
-    if (error_flags.can_cc_used == 1) {
-        if (current_time-current_tab.timestamp_cc > CANS_SENSOR_RESPONSE_TIMEOUT_MS) {
+    if (cans_errorstate_tab.can_cc_used == 1) {
+        if (current_time-cans_current_tab.timestamp_cc > CANS_SENSOR_RESPONSE_TIMEOUT_MS) {
             DIAG_Handler(DIAG_CH_CAN_CC_RESPONDING, DIAG_EVENT_NOK, 0, NULL_PTR);
         } else {
             DIAG_Handler(DIAG_CH_CAN_CC_RESPONDING, DIAG_EVENT_OK, 0, NULL_PTR);
@@ -400,6 +695,29 @@ static uint8_t CANS_CheckCanTiming(void) {
 }
 
 
+/**
+ * @brief   updates the local copy of a data block if a new version was published
+ *
+ * CANS_CheckCanTiming() is called every cycle, so blocks which did not change
+ * since the last call are not copied again.
+ *
+ * @param   dataptr     local copy of the data block
+ * @param   blockID     ID of the data block
+ * @param   version     version of the local copy, updated after a successful read
+ *
+ * @return  none
+ */
+static void CANS_UpdateBlock(void *dataptr, DATA_BLOCK_ID_TYPE_e blockID, uint32_t *version) {
+    uint32_t newversion = DB_GetBlockVersion(blockID);
+
+    if (newversion != *version) {
+        if (DB_ReadBlock(dataptr, blockID) == E_OK) {
+            *version = newversion;
+        }
+    }
+}
+
+
 /**
  * @brief   enable/disable the periodic transmit/receive.
  *
@@ -459,6 +777,28 @@ static void CANS_SetCurrentSensorCCPresent(uint8_t command) {
 
 
 
+/**
+ * @brief   gets the timing statistics of a periodic TX message.
+ *
+ * @param   msgIdx  TX message, node 1 messages follow the node 0 messages
+ * @param   timing  where the statistics are copied to
+ *
+ * @return  E_OK if the statistics were copied, E_NOT_OK otherwise
+ */
+extern STD_RETURN_TYPE_e CANS_GetTxTiming(CANS_messagesTx_e msgIdx, CANS_TX_TIMING_s *timing) {
+    if (cans_txWheelValid == FALSE || timing == NULL_PTR || (uint32_t)msgIdx >= (uint32_t)(can_CAN0_tx_length + can_CAN1_tx_length)) {
+        return E_NOT_OK;
+    }
+
+    taskENTER_CRITICAL();
+    *timing = cans_txTiming[msgIdx];
+    taskEXIT_CRITICAL();
+
+    return E_OK;
+}
+
+
+
 /**
  * @brief   set flag for presence of current sensor.
  *
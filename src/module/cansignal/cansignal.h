@@ -42,6 +42,46 @@
 #include "general.h"
 /*================== Macros and Definitions ===============================*/
 
+/**
+ * maximum number of RX messages (CANS_messagesRx_e) whose signals are looked up by
+ * their range in the signal table. The signals of further messages are searched in
+ * the whole signal table. Can be overridden in cansignal_cfg.h.
+ */
+#ifndef CANS_MAX_NUMBER_OF_RX_MESSAGES
+#define CANS_MAX_NUMBER_OF_RX_MESSAGES  64
+#endif
+
+/**
+ * maximum number of TX messages (CANS_messagesTx_e) whose signals are looked up by
+ * their range in the signal table, see CANS_MAX_NUMBER_OF_RX_MESSAGES.
+ * Can be overridden in cansignal_cfg.h.
+ */
+#ifndef CANS_MAX_NUMBER_OF_TX_MESSAGES
+#define CANS_MAX_NUMBER_OF_TX_MESSAGES  64
+#endif
+
+/**
+ * number of received messages that are read from the CAN buffer per call of
+ * CAN_ReceiveBufferBatch(). Can be overridden in cansignal_cfg.h.
+ */
+#ifndef CANS_RX_BATCH_SIZE
+#define CANS_RX_BATCH_SIZE              8
+#endif
+
+/**
+ * number of slots (ticks of CANS_TICK_MS) of the timing wheel that schedules the
+ * periodic TX messages, has to be a power of two. Messages with a longer repetition
+ * time stay in their slot for several turns of the wheel.
+ * Can be overridden in cansignal_cfg.h.
+ */
+#ifndef CANS_TX_WHEEL_SLOTS
+#define CANS_TX_WHEEL_SLOTS             32
+#endif
+
+#if (CANS_TX_WHEEL_SLOTS == 0) || ((CANS_TX_WHEEL_SLOTS & (CANS_TX_WHEEL_SLOTS - 1)) != 0)
+#error "CANS_TX_WHEEL_SLOTS has to be a power of two"
+#endif
+
 /*================== Constant and Variable Definitions ====================*/
 /**
  * This structure contains variables relevant for the CAN signal module.
@@ -52,12 +92,29 @@ typedef struct {
     uint8_t current_sensor_cc_present;         /*!< defines if a CC info is being sent  */
 } CANS_STATE_s;
 
+/**
+ * range of the signals of one message in the signal table of its CAN node
+ */
+typedef struct {
+    uint16_t first;                            /*!< index of the first signal of the message  */
+    uint16_t end;                              /*!< index after the last signal of the message, 0 if the message has no signals */
+} CANS_SIGNAL_RANGE_s;
+
+/**
+ * timing statistics of a periodic TX message, see CANS_GetTxTiming()
+ */
+typedef struct {
+    uint32_t nrOfTransmits;                    /*!< number of times the message was passed to the CAN module  */
+    uint32_t lastTimestamp;                    /*!< MCU_GetTimeStamp() of the last transmission              */
+    uint32_t maxJitter_ms;                     /*!< maximum deviation of the time between two transmissions from the repetition time */
+} CANS_TX_TIMING_s;
+
 
 /*================== Function Prototypes ==================================*/
 /**
  * initializes local variables and module internals needed to use conversion of
- * can signals. Until now no initialization is needed and thus the function does
- * nothing.
+ * can signals. The range of the signals of each RX and TX message in the signal
+ * tables is determined, so that a message only parses or composes its own signals.
  */
 extern void CANS_Init(void);
 
@@ -71,6 +128,17 @@ extern void CANS_Enable_Periodic(uint8_t command);
 extern uint8_t CANS_IsCurrentSensorPresent(void);
 extern uint8_t CANS_IsCurrentSensorCCPresent(void);
 
+/**
+ * gets the timing statistics of a periodic TX message.
+ *
+ * @param   msgIdx  TX message, node 1 messages follow the node 0 messages
+ * @param   timing  where the statistics are copied to
+ *
+ * @return  E_OK if the statistics were copied, E_NOT_OK if the message is not
+ *          scheduled by the timing wheel or timing is NULL_PTR
+ */
+extern STD_RETURN_TYPE_e CANS_GetTxTiming(CANS_messagesTx_e msgIdx, CANS_TX_TIMING_s *timing);
+
 /*================== Function Implementations =============================*/
 
 #endif /* CANSIGNAL_H_ */
@@ -47,7 +47,10 @@
 #include "diag.h"
 #include "os.h"
 #include "ltc_pec.h"
+#include "ltc_ntc.h"
+#include "ltc_conv.h"
 #include "spi.h"
+#include "stat.h"
 
 /*================== Macros and Definitions ===============================*/
 // LTC COMM definitions
@@ -62,15 +65,189 @@
 
 #define LTC_MAX_SUPPORTED_CELLS         12
 
+/**
+ * converts a transfer time in us to the number of ms the state machine waits,
+ * rounded up and at least 1ms
+ */
+#define LTC_TRANSFERTIME_MS(time_us)    ((((time_us)+999)/1000) > 0 ? (((time_us)+999)/1000) : 1)
+
+/**
+ * number of cell voltage register groups (RDCVA...RDCVF) read in one burst
+ */
+#define LTC_VOLTAGE_REGISTER_GROUPS     (BS_MAX_SUPPORTED_CELLS/3)
+
+/**
+ * number of LTC daisy-chains, each connected to its own SPI interface. The daisy-chains
+ * are measured concurrently, LTC_N_LTC is the number of LTCs in one daisy-chain.
+ * Can be overridden in ltc_cfg.h.
+ */
+#ifndef LTC_NR_OF_CHAINS
+#define LTC_NR_OF_CHAINS                1
+#endif
+
+#if (LTC_NR_OF_CHAINS < 1) || (LTC_NR_OF_CHAINS > 4)
+#error "LTC_NR_OF_CHAINS has to be between 1 and 4"
+#endif
+
+#if (BS_NR_OF_MODULES % LTC_NR_OF_CHAINS) != 0
+#error "the modules have to be distributed evenly over the LTC daisy-chains"
+#endif
+
+/**
+ * number of modules measured by one daisy-chain
+ */
+#define LTC_NR_OF_MODULES_PER_CHAIN     (BS_NR_OF_MODULES/LTC_NR_OF_CHAINS)
+
+#if LTC_N_LTC != LTC_NR_OF_MODULES_PER_CHAIN
+#error "LTC_N_LTC has to be the number of modules measured by one LTC daisy-chain (BS_NR_OF_MODULES/LTC_NR_OF_CHAINS)"
+#endif
+
+/**
+ * index of the first module of the daisy-chain of ltc_state in the database
+ */
+#define LTC_MODULE_OFFSET(ltc_state)    ((ltc_state)->instanceID*LTC_NR_OF_MODULES_PER_CHAIN)
+
+/**
+ * SPI interface and chip select (see SPI_SetCS()) of the first LTC daisy-chain,
+ * can be overridden in ltc_cfg.h. The further daisy-chains are configured with
+ * LTC_SPI_HANDLE_1/LTC_SPI_BUSID_1 ... LTC_SPI_HANDLE_3/LTC_SPI_BUSID_3, every
+ * daisy-chain needs its own SPI interface.
+ */
+#ifndef LTC_SPI_HANDLE
+#define LTC_SPI_HANDLE                  (&spi_devices[0])
+#endif
+#ifndef LTC_SPI_BUSID
+#define LTC_SPI_BUSID                   1
+#endif
+
+#if (LTC_NR_OF_CHAINS > 1) && (!defined(LTC_SPI_HANDLE_1) || !defined(LTC_SPI_BUSID_1))
+#error "LTC_SPI_HANDLE_1 and LTC_SPI_BUSID_1 have to be defined for the second LTC daisy-chain"
+#endif
+#if (LTC_NR_OF_CHAINS > 2) && (!defined(LTC_SPI_HANDLE_2) || !defined(LTC_SPI_BUSID_2))
+#error "LTC_SPI_HANDLE_2 and LTC_SPI_BUSID_2 have to be defined for the third LTC daisy-chain"
+#endif
+#if (LTC_NR_OF_CHAINS > 3) && (!defined(LTC_SPI_HANDLE_3) || !defined(LTC_SPI_BUSID_3))
+#error "LTC_SPI_HANDLE_3 and LTC_SPI_BUSID_3 have to be defined for the fourth LTC daisy-chain"
+#endif
+
+/**
+ * bit mask with one bit set for every daisy-chain
+ */
+#define LTC_ALL_CHAINS_MASK             ((uint8_t)((1u << LTC_NR_OF_CHAINS)-1))
+
+/**
+ * adaptive scheduling of the temperature multiplexer steps: after a step of the
+ * sequence, a temperature step of the same multiplexer with enough credit is read once
+ * more before the sequence continues. Can be overridden in ltc_cfg.h.
+ */
+#ifndef LTC_MUX_ADAPTIVE
+#define LTC_MUX_ADAPTIVE                    TRUE
+#endif
+
+/**
+ * number of steps of the multiplexer sequence that are scheduled adaptively
+ */
+#ifndef LTC_MUX_ADAPTIVE_MAX_STEPS
+#define LTC_MUX_ADAPTIVE_MAX_STEPS          32
+#endif
+
+/**
+ * credit a step needs for an additional read. Every step of the sequence adds the weight
+ * of each temperature step to its credit, so a step with weight w is read about every
+ * LTC_MUX_ADAPTIVE_CREDIT/w steps, at most every second step.
+ */
+#ifndef LTC_MUX_ADAPTIVE_CREDIT
+#define LTC_MUX_ADAPTIVE_CREDIT             16
+#endif
+
+/**
+ * maximum weight of a step
+ */
+#ifndef LTC_MUX_ADAPTIVE_MAX_WEIGHT
+#define LTC_MUX_ADAPTIVE_MAX_WEIGHT         8
+#endif
+
+/**
+ * rate of change of a temperature in 0.1 degC/s that adds 1 to the weight of its step
+ */
+#ifndef LTC_MUX_ADAPTIVE_RATE_PER_WEIGHT
+#define LTC_MUX_ADAPTIVE_RATE_PER_WEIGHT    5
+#endif
+
+/**
+ * temperatures in 0.1 degC above LTC_MUX_ADAPTIVE_TEMP_HIGH or below LTC_MUX_ADAPTIVE_TEMP_LOW
+ * add 1 to the weight of their step per LTC_MUX_ADAPTIVE_TEMP_PER_WEIGHT
+ */
+#ifndef LTC_MUX_ADAPTIVE_TEMP_HIGH
+#define LTC_MUX_ADAPTIVE_TEMP_HIGH          450
+#endif
+#ifndef LTC_MUX_ADAPTIVE_TEMP_LOW
+#define LTC_MUX_ADAPTIVE_TEMP_LOW           50
+#endif
+#ifndef LTC_MUX_ADAPTIVE_TEMP_PER_WEIGHT
+#define LTC_MUX_ADAPTIVE_TEMP_PER_WEIGHT    20
+#endif
+
+/**
+ * maximum number of times the cell voltage register groups with PEC errors are
+ * re-read in one measurement cycle, 0 disables the re-read.
+ * Can be overridden in ltc_cfg.h.
+ */
+#ifndef LTC_PEC_MAX_REREADS
+#define LTC_PEC_MAX_REREADS                 2
+#endif
+
 /**
  * Saves the last state and the last substate
  */
-#define LTC_SAVELASTSTATES()    ltc_state.laststate = ltc_state.state; \
-                                ltc_state.lastsubstate = ltc_state.substate
+#define LTC_SAVELASTSTATES()    ltc_state->laststate = ltc_state->state; \
+                                ltc_state->lastsubstate = ltc_state->substate
 
-/*================== Constant and Variable Definitions ====================*/
+/**
+ * initial state of the daisy-chain id connected to the SPI interface handle with chip select busID
+ */
+#define LTC_STATE_INIT(id, handle, busID) {         \
+    .timer                   = 0,                   \
+    .statereq                = LTC_STATE_NO_REQUEST, \
+    .state                   = LTC_STATEMACH_UNINITIALIZED, \
+    .substate                = 0,                   \
+    .laststate               = LTC_STATEMACH_UNINITIALIZED, \
+    .lastsubstate            = 0,                   \
+    .adcModereq              = LTC_ADCMODE_FAST_DCP0, \
+    .adcMode                 = LTC_ADCMODE_FAST_DCP0, \
+    .adcMeasChreq            = LTC_ADCMEAS_UNDEFINED, \
+    .adcMeasCh               = LTC_ADCMEAS_UNDEFINED, \
+    .numberOfMeasuredMux     = 32,                  \
+    .triggerentry            = 0,                   \
+    .ErrRetryCounter         = 0,                   \
+    .ErrRequestCounter       = 0,                   \
+    .VoltageSampleTime       = 0,                   \
+    .muxSampleTime           = 0,                   \
+    .commandDataTransferTime = 3,                   \
+    .commandTransferTime     = 3,                   \
+    .gpioClocksTransferTime  = 3,                   \
+    .muxmeas_seqptr          = NULL_PTR,            \
+    .muxmeas_seqendptr       = NULL_PTR,            \
+    .muxmeas_nr_end          = 0,                   \
+    .spiHandle               = (handle),            \
+    .spiBusID                = (busID),             \
+    .instanceID              = (id),                \
+    .errStatus               = {                    \
+        .errPECCnt            = &ltc_errPECCnt[(id)*LTC_NR_OF_MODULES_PER_CHAIN],            \
+        .errSPICnt            = &ltc_errSPICnt[(id)*LTC_NR_OF_MODULES_PER_CHAIN],            \
+        .errRetryCnt          = &ltc_errRetryCnt[(id)*LTC_NR_OF_MODULES_PER_CHAIN],          \
+        .errConsecutivePECCnt = &ltc_errConsecutivePECCnt[(id)*LTC_NR_OF_MODULES_PER_CHAIN], \
+        .lastValidTimestamp   = &ltc_lastValidTimestamp[(id)*LTC_NR_OF_MODULES_PER_CHAIN],   \
+    },                                              \
+    .busSize                 = LTC_N_LTC,           \
+    .first_measurement_made  = FALSE,               \
+    .ltc_muxcycle_finished   = E_NOT_OK,            \
+    .check_spi_flag          = FALSE,               \
+    .balance_control_done    = FALSE,               \
+    .nextStepTime            = 0,                   \
+}
 
-static uint8_t ltc_used_cells_index = 0;
+/*================== Constant and Variable Definitions ====================*/
 
 static DATA_BLOCK_CELLVOLTAGE_s ltc_cellvoltage;
 static DATA_BLOCK_CELLTEMPERATURE_s ltc_celltemperature;
@@ -80,36 +257,101 @@ static DATA_BLOCK_USER_MUX_s ltc_user_mux;
 static DATA_BLOCK_BALANCING_CONTROL_s ltc_balancing_control;
 static DATA_BLOCK_SLAVE_CONTROL_s ltc_slave_control;
 
+/**
+ * statistics of the last cell voltage measurement, see LTC_GetCellVoltageStatistics()
+ */
+static STAT_U16_RESULT_s ltc_voltage_stats;
+
+/**
+ * statistics of the cell voltages accumulated by LTC_SaveRXtoVoltagebuffer() while the
+ * register groups are parsed, evaluated and reset by LTC_SaveVoltages()
+ */
+static STAT_ACCUMULATOR_s ltc_voltage_acc;
+
+/**
+ * daisy-chains (one bit per instanceID) whose cell voltages were added to ltc_voltage_acc,
+ * and FALSE if a daisy-chain added its cells twice or not all of them
+ */
+static uint8_t ltc_voltage_acc_chains = 0;
+static uint8_t ltc_voltage_acc_valid = TRUE;
+
+/**
+ * daisy-chains (one bit per instanceID) whose cell voltages respectively temperatures
+ * were saved since they were last published, see LTC_ChainDone()
+ */
+static uint8_t ltc_voltage_chains_done = 0;
+static uint8_t ltc_temperature_chains_done = 0;
+
+/**
+ * data blocks of the LTC driver that are published together by LTC_Initialize_Database()
+ */
+static const DATA_BLOCK_VECTOR_s ltc_database_blocks[] = {
+    {DATA_BLOCK_ID_CELLVOLTAGE,                 &ltc_cellvoltage},
+    {DATA_BLOCK_ID_CELLTEMPERATURE,             &ltc_celltemperature},
+    {DATA_BLOCK_ID_MINMAX,                      &ltc_minmax},
+    {DATA_BLOCK_ID_BALANCING_FEEDBACK_VALUES,   &ltc_balancing_feedback},
+    {DATA_BLOCK_ID_BALANCING_CONTROL_VALUES,    &ltc_balancing_control},
+    {DATA_BLOCK_ID_SLAVE_CONTROL,               &ltc_slave_control},
+};
+
+/**
+ * data blocks that are published together by LTC_SaveVoltages()
+ */
+static const DATA_BLOCK_VECTOR_s ltc_voltage_blocks[] = {
+    {DATA_BLOCK_ID_CELLVOLTAGE,     &ltc_cellvoltage},
+    {DATA_BLOCK_ID_MINMAX,          &ltc_minmax},
+};
+
+/**
+ * data blocks that are published together by LTC_SaveTemperatures()
+ */
+static const DATA_BLOCK_VECTOR_s ltc_temperature_blocks[] = {
+    {DATA_BLOCK_ID_CELLTEMPERATURE, &ltc_celltemperature},
+    {DATA_BLOCK_ID_MINMAX,          &ltc_minmax},
+};
+
 static LTC_ERRORTABLE_s LTC_ErrorTable[BS_NR_OF_MODULES];  // init in LTC_ResetErrorTable-function
 
+/**
+ * adaptive scheduling state of the steps of the multiplexer sequence
+ */
+static LTC_MUX_ADAPTIVE_STEP_s ltc_mux_adaptive[LTC_NR_OF_CHAINS][LTC_MUX_ADAPTIVE_MAX_STEPS];
+
+/**
+ * last read temperatures in 0.1 degC, used for the rate of change
+ */
+static int16_t ltc_mux_temperature[BS_NR_OF_TEMP_SENSORS];
+
+/**
+ * temperature step that is read once more before the sequence continues, NULL_PTR if none
+ */
+static LTC_MUX_CH_CFG_s *ltc_mux_extrastep[LTC_NR_OF_CHAINS];
+
 
-static LTC_STATE_s ltc_state = {
-    .timer                   = 0,
-    .statereq                = LTC_STATE_NO_REQUEST,
-    .state                   = LTC_STATEMACH_UNINITIALIZED,
-    .substate                = 0,
-    .laststate               = LTC_STATEMACH_UNINITIALIZED,
-    .lastsubstate            = 0,
-    .adcModereq              = LTC_ADCMODE_FAST_DCP0,
-    .adcMode                 = LTC_ADCMODE_FAST_DCP0,
-    .adcMeasChreq            = LTC_ADCMEAS_UNDEFINED,
-    .adcMeasCh               = LTC_ADCMEAS_UNDEFINED,
-    .numberOfMeasuredMux     = 32,
-    .triggerentry            = 0,
-    .ErrRetryCounter         = 0,
-    .ErrRequestCounter       = 0,
-    .VoltageSampleTime       = 0,
-    .muxSampleTime           = 0,
-    .commandDataTransferTime = 3,
-    .commandTransferTime     = 3,
-    .gpioClocksTransferTime  = 3,
-    .muxmeas_seqptr          = NULL_PTR,
-    .muxmeas_seqendptr       = NULL_PTR,
-    .muxmeas_nr_end          = 0,
-    .first_measurement_made  = FALSE,
-    .ltc_muxcycle_finished   = E_NOT_OK,
-    .check_spi_flag          = FALSE,
-    .balance_control_done     = FALSE,
+/**
+ * state of the daisy-chains, see LTC_NR_OF_CHAINS
+ */
+/**
+ * communication error statistics of every LTC, indexed by module, see LTC_GetDeviceErrors().
+ * The errStatus of each daisy-chain points to the range of its modules.
+ */
+static uint32_t ltc_errPECCnt[BS_NR_OF_MODULES];
+static uint32_t ltc_errSPICnt[BS_NR_OF_MODULES];
+static uint32_t ltc_errRetryCnt[BS_NR_OF_MODULES];
+static uint16_t ltc_errConsecutivePECCnt[BS_NR_OF_MODULES];
+static uint32_t ltc_lastValidTimestamp[BS_NR_OF_MODULES];
+
+static LTC_STATE_s ltc_states[LTC_NR_OF_CHAINS] = {
+    LTC_STATE_INIT(0, LTC_SPI_HANDLE, LTC_SPI_BUSID),
+#if LTC_NR_OF_CHAINS > 1
+    LTC_STATE_INIT(1, LTC_SPI_HANDLE_1, LTC_SPI_BUSID_1),
+#endif
+#if LTC_NR_OF_CHAINS > 2
+    LTC_STATE_INIT(2, LTC_SPI_HANDLE_2, LTC_SPI_BUSID_2),
+#endif
+#if LTC_NR_OF_CHAINS > 3
+    LTC_STATE_INIT(3, LTC_SPI_HANDLE_3, LTC_SPI_BUSID_3),
+#endif
 };
 
 static const uint8_t ltc_cmdDummy[1]={0x00};
@@ -120,8 +362,10 @@ static const uint8_t ltc_cmdRDCVA[4] = {0x00, 0x04, 0x07, 0xC2};
 static const uint8_t ltc_cmdRDCVB[4] = {0x00, 0x06, 0x9A, 0x94};
 static const uint8_t ltc_cmdRDCVC[4] = {0x00, 0x08, 0x5E, 0x52};
 static const uint8_t ltc_cmdRDCVD[4] = {0x00, 0x0A, 0xC3, 0x04};
-//static const uint8_t ltc_cmdRDCVE[4] = {0x00, 0x09, 0xD5, 0x60};
-//static const uint8_t ltc_cmdRDCVF[4] = {0x00, 0x0B, 0x48, 0x36};
+static const uint8_t ltc_cmdRDCVE[4] = {0x00, 0x09, 0xD5, 0x60};
+static const uint8_t ltc_cmdRDCVF[4] = {0x00, 0x0B, 0x48, 0x36};
+
+static const uint8_t *const ltc_cmdRDCV[6] = {ltc_cmdRDCVA, ltc_cmdRDCVB, ltc_cmdRDCVC, ltc_cmdRDCVD, ltc_cmdRDCVE, ltc_cmdRDCVF};
 static const uint8_t ltc_cmdWRCOMM[4] = {0x07, 0x21, 0x24, 0xB2};
 static const uint8_t ltc_cmdSTCOMM[4] = {0x07, 0x23, 0xB9, 0xE4};
 static const uint8_t ltc_cmdRDCOMM[4] = {0x07, 0x22, 0x32, 0xD6};
@@ -170,58 +414,94 @@ static const uint8_t ltc_cmdADAX_normal_ALLGPIOS[4] = {0x05, 0x60, 0xD3, 0xA0};
 static const uint8_t ltc_cmdADAX_filtered_ALLGPIOS[4] = {0x05, 0xE0, 0x97, 0x86}; /*!< All channels, filtered mode           */
 static const uint8_t ltc_cmdADAX_fast_ALLGPIOS[4] = {0x04, 0xE0, 0x1F, 0xCA};     /*!< All channels, fast mode               */
 
-static uint8_t ltc_RXPECbuffer[LTC_N_BYTES_FOR_DATA_TRANSMISSION];
-static uint8_t ltc_TXPECbuffer[LTC_N_BYTES_FOR_DATA_TRANSMISSION];
-static uint8_t ltc_TXBuffer[LTC_N_BYTES_FOR_DATA_TRANSMISSION_DATA_ONLY];
+/*
+ * the transmit and receive buffers are separate for every daisy-chain, indexed by instanceID
+ */
+static uint8_t ltc_RXPECbuffer[LTC_NR_OF_CHAINS][LTC_N_BYTES_FOR_DATA_TRANSMISSION];
+static uint8_t ltc_TXPECbuffer[LTC_NR_OF_CHAINS][LTC_N_BYTES_FOR_DATA_TRANSMISSION];
+
+/**
+ * buffers and transfers of the burst that reads all cell voltage register groups
+ */
+static uint8_t ltc_voltageTXPECbuffer[LTC_NR_OF_CHAINS][LTC_VOLTAGE_REGISTER_GROUPS][LTC_N_BYTES_FOR_DATA_TRANSMISSION];
+static uint8_t ltc_voltageRXPECbuffer[LTC_NR_OF_CHAINS][LTC_VOLTAGE_REGISTER_GROUPS][LTC_N_BYTES_FOR_DATA_TRANSMISSION];
+static SPI_TRANSFER_s ltc_voltageTransfers[LTC_NR_OF_CHAINS][LTC_VOLTAGE_REGISTER_GROUPS];
+
+/**
+ * cell voltage register groups (one bit per group) not yet received with valid PEC in the
+ * current measurement cycle and the transfers to re-read them, see LTC_RX_VoltageRegisterReread()
+ */
+static uint8_t ltc_voltagePending[LTC_NR_OF_CHAINS];
+static SPI_TRANSFER_s ltc_voltageRereadTransfers[LTC_NR_OF_CHAINS][LTC_VOLTAGE_REGISTER_GROUPS];
+
+/**
+ * task notified when a burst of SPI transfers is complete, see LTC_SetNotifiedTask()
+ */
+static void *ltc_notifiedTask = NULL_PTR;
+static uint8_t ltc_TXBuffer[LTC_NR_OF_CHAINS][LTC_N_BYTES_FOR_DATA_TRANSMISSION_DATA_ONLY];
 
-static uint8_t ltc_TXBufferClock[4+9];
-static uint8_t ltc_TXPECBufferClock[4+9];
+static uint8_t ltc_TXBufferClock[LTC_NR_OF_CHAINS][4+9];
+static uint8_t ltc_TXPECBufferClock[LTC_NR_OF_CHAINS][4+9];
 
 
 /*================== Function Prototypes ==================================*/
-static float LTC_Convert_MuxVoltages_to_Temperatures(float v_adc);
 
 static void LTC_Initialize_Database(void);
-static void LTC_SaveBalancingFeedback(uint8_t *DataBufferSPI_RX);
-static void LTC_Get_BalancingControlValues(void);
+static void LTC_StateMachine(LTC_STATE_s *ltc_state);
+static uint8_t LTC_ChainDone(uint8_t *chainsdone, uint8_t instanceID);
+static void LTC_SaveBalancingFeedback(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_RX);
+static STD_RETURN_TYPE_e LTC_Get_BalancingControlValues(void);
 
-static STD_RETURN_TYPE_e LTC_BalanceControl(uint8_t registerSet);
+static STD_RETURN_TYPE_e LTC_BalanceControl(LTC_STATE_s *ltc_state, uint8_t registerSet);
 
-static void LTC_ResetErrorTable(void);
-static STD_RETURN_TYPE_e LTC_Init(void);
+static void LTC_ResetErrorTable(LTC_STATE_s *ltc_state);
+static STD_RETURN_TYPE_e LTC_Init(LTC_STATE_s *ltc_state);
 
-static STD_RETURN_TYPE_e LTC_StartVoltageMeasurement(LTC_ADCMODE_e adcMode, LTC_ADCMEAS_CHAN_e  adcMeasCh);
-static STD_RETURN_TYPE_e LTC_StartGPIOMeasurement(LTC_ADCMODE_e adcMode, LTC_ADCMEAS_CHAN_e  adcMeasCh);
+static STD_RETURN_TYPE_e LTC_StartVoltageMeasurement(LTC_STATE_s *ltc_state, LTC_ADCMODE_e adcMode, LTC_ADCMEAS_CHAN_e  adcMeasCh);
+static STD_RETURN_TYPE_e LTC_StartGPIOMeasurement(LTC_STATE_s *ltc_state, LTC_ADCMODE_e adcMode, LTC_ADCMEAS_CHAN_e  adcMeasCh);
 static uint16_t LTC_Get_MeasurementTCycle(LTC_ADCMODE_e adcMode, LTC_ADCMEAS_CHAN_e  adcMeasCh);
 
-static void LTC_SaveRXtoVoltagebuffer(uint8_t registerSet, uint8_t *rxBuffer);
-
-static STD_RETURN_TYPE_e LTC_RX_PECCheck(uint8_t *DataBufferSPI_RX_with_PEC);
-static STD_RETURN_TYPE_e LTC_RX(uint8_t *Command, uint8_t *DataBufferSPI_RX_with_PEC);
-static STD_RETURN_TYPE_e LTC_TX(uint8_t *Command, uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC);
+static void LTC_SaveRXtoVoltagebuffer(LTC_STATE_s *ltc_state, uint8_t registerSet, uint8_t *rxBuffer);
+
+static STD_RETURN_TYPE_e LTC_RX_PECCheck(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_RX_with_PEC);
+static uint8_t LTC_RX_PECValid(uint8_t *DataBufferSPI_RX_with_PEC, uint16_t ltc);
+static STD_RETURN_TYPE_e LTC_RX(LTC_STATE_s *ltc_state, uint8_t *Command, uint8_t *DataBufferSPI_RX_with_PEC);
+static STD_RETURN_TYPE_e LTC_RX_VoltageRegisters(LTC_STATE_s *ltc_state);
+static uint8_t LTC_RX_VoltageRegisterReread(LTC_STATE_s *ltc_state);
+static STD_RETURN_TYPE_e LTC_TX(LTC_STATE_s *ltc_state, uint8_t *Command, uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC);
+static STD_RETURN_TYPE_e LTC_ChainSPIStatus(LTC_STATE_s *ltc_state, STD_RETURN_TYPE_e statusSPI);
+static STD_RETURN_TYPE_e LTC_ChainSendWakeUp(LTC_STATE_s *ltc_state);
+static STD_RETURN_TYPE_e LTC_ChainSendCmd(LTC_STATE_s *ltc_state, const uint8_t *Command);
+static STD_RETURN_TYPE_e LTC_ChainSendData(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_TX_with_PEC);
+static STD_RETURN_TYPE_e LTC_ChainReceiveData(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_TX_with_PEC, uint8_t *DataBufferSPI_RX_with_PEC);
+static STD_RETURN_TYPE_e LTC_ChainSendI2CCmd(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_TX_with_PEC);
 static void LTC_SetMUXChCommand(uint8_t *DataBufferSPI_TX, uint8_t mux, uint8_t channel);
-static uint8_t LTC_SendEEPROMReadCommand(uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC, uint8_t step);
-static void LTC_SetEEPROMReadCommand(uint8_t step, uint8_t *DataBufferSPI_TX);
-static void LTC_EEPROMSaveReadValue(uint8_t *rxBuffer);
-static uint8_t LTC_SendEEPROMWriteCommand(uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC, uint8_t step);
-static void LTC_SetEEPROMWriteCommand(uint8_t step, uint8_t *DataBufferSPI_TX);
-static uint8_t LTC_SetMuxChannel(uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC, uint8_t mux, uint8_t channel);
-static uint8_t LTC_SetPortExpander(uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC);
-static void LTC_PortExpanderSaveValues(uint8_t *rxBuffer);
-static void LTC_TempSensSaveTemp(uint8_t *rxBuffer);
+static uint8_t LTC_SendEEPROMReadCommand(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC, uint8_t step);
+static STD_RETURN_TYPE_e LTC_SetEEPROMReadCommand(uint8_t step, uint8_t *DataBufferSPI_TX);
+static void LTC_EEPROMSaveReadValue(LTC_STATE_s *ltc_state, uint8_t *rxBuffer);
+static uint8_t LTC_SendEEPROMWriteCommand(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC, uint8_t step);
+static STD_RETURN_TYPE_e LTC_SetEEPROMWriteCommand(LTC_STATE_s *ltc_state, uint8_t step, uint8_t *DataBufferSPI_TX);
+static uint8_t LTC_SetMuxChannel(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC, uint8_t mux, uint8_t channel);
+static uint8_t LTC_SetPortExpander(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC);
+static void LTC_PortExpanderSaveValues(LTC_STATE_s *ltc_state, uint8_t *rxBuffer);
+static void LTC_TempSensSaveTemp(LTC_STATE_s *ltc_state, uint8_t *rxBuffer);
 
-static STD_RETURN_TYPE_e LTC_I2CClock(uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC);
-static STD_RETURN_TYPE_e LTC_Send_I2C_Command(uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC, uint8_t *cmd_data);
+static STD_RETURN_TYPE_e LTC_I2CClock(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC);
+static STD_RETURN_TYPE_e LTC_Send_I2C_Command(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC, uint8_t *cmd_data);
 
-static uint8_t LTC_I2CCheckACK(uint8_t *DataBufferSPI_RX, int mux);
+static uint8_t LTC_I2CCheckACK(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_RX, int mux);
 
-static void LTC_SaveMuxMeasurement(uint8_t *DataBufferSPI_RX, LTC_MUX_CH_CFG_s  *muxseqptr);
+static void LTC_SaveMuxMeasurement(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_RX, LTC_MUX_CH_CFG_s  *muxseqptr);
+static LTC_MUX_CH_CFG_s *LTC_MuxCurrentStep(LTC_STATE_s *ltc_state);
+static void LTC_MuxStepDone(LTC_STATE_s *ltc_state);
+static void LTC_MuxResetAdaptive(LTC_STATE_s *ltc_state);
+static void LTC_MuxUpdateWeight(LTC_STATE_s *ltc_state, LTC_MUX_CH_CFG_s *muxseqptr, uint16_t maxdelta, int16_t mintemperature, int16_t maxtemperature);
 
 
-static uint32_t LTC_GetSPIClock(void);
-static void LTC_SetTransferTimes(void);
+static uint32_t LTC_GetSPIClock(LTC_STATE_s *ltc_state);
+static void LTC_SetTransferTimes(LTC_STATE_s *ltc_state);
 
-static LTC_RETURN_TYPE_e LTC_CheckStateRequest(LTC_STATE_REQUEST_e statereq);
+static LTC_RETURN_TYPE_e LTC_CheckStateRequest(LTC_STATE_s *ltc_state, LTC_STATE_REQUEST_e statereq);
 
 
 /*================== Function Implementations =============================*/
@@ -244,6 +524,11 @@ static void LTC_Initialize_Database(void) {
 
     ltc_cellvoltage.state = 0;
     ltc_cellvoltage.timestamp = 0;
+    STAT_InitAccumulator(&ltc_voltage_acc);
+    ltc_voltage_acc_chains = 0;
+    ltc_voltage_acc_valid = TRUE;
+    ltc_voltage_chains_done = 0;
+    ltc_temperature_chains_done = 0;
     ltc_minmax.voltage_min = 0;
     ltc_minmax.voltage_max = 0;
     ltc_minmax.voltage_module_number_min = 0;
@@ -290,12 +575,7 @@ static void LTC_Initialize_Database(void) {
     ltc_slave_control.eeprom_write_address_last_used = 0xFFFFFFFF;
     ltc_slave_control.eeprom_write_address_to_use = 0xFFFFFFFF;
 
-    DB_WriteBlock(&ltc_cellvoltage, DATA_BLOCK_ID_CELLVOLTAGE);
-    DB_WriteBlock(&ltc_celltemperature, DATA_BLOCK_ID_CELLTEMPERATURE);
-    DB_WriteBlock(&ltc_minmax, DATA_BLOCK_ID_MINMAX);
-    DB_WriteBlock(&ltc_balancing_feedback, DATA_BLOCK_ID_BALANCING_FEEDBACK_VALUES);
-    DB_WriteBlock(&ltc_balancing_control, DATA_BLOCK_ID_BALANCING_CONTROL_VALUES);
-    DB_WriteBlock(&ltc_slave_control, DATA_BLOCK_ID_SLAVE_CONTROL);
+    DB_WriteBlockV(ltc_database_blocks, sizeof(ltc_database_blocks)/sizeof(ltc_database_blocks[0]));
 
     for (i=0; i < (8*2*BS_NR_OF_MODULES); i++) {
         ltc_user_mux.value[i] = 0;
@@ -309,8 +589,11 @@ static void LTC_Initialize_Database(void) {
 /**
  * @brief   stores the measured voltages in the database.
  *
- * This function loops through the data of all modules in the LTC daisy-chain that are
- * stored in the LTC_CellVoltages buffer and writes them in the database.
+ * This function writes the cell voltages of all modules in the LTC daisy-chain and their
+ * min, max and mean in the database. If every daisy-chain saved all register groups of
+ * its cycle exactly once, the statistics accumulated by LTC_SaveRXtoVoltagebuffer() are
+ * used, otherwise the cell voltages are reduced in one pass (see STAT_ReduceU16()).
+ * The statistics are kept for LTC_GetCellVoltageStatistics().
  * At each write iteration, the variable named "state" and related to voltages in the
  * database is incremented.
  *
@@ -319,58 +602,63 @@ static void LTC_Initialize_Database(void) {
  */
 extern void LTC_SaveVoltages(void) {
 
-    uint16_t i = 0;
-    uint16_t j = 0;
-    uint16_t min = 0;
-    uint16_t max = 0;
-    uint32_t mean = 0;
-    uint8_t module_number_min = 0;
-    uint8_t module_number_max = 0;
-    uint8_t cell_number_min = 0;
-    uint8_t cell_number_max = 0;
-
-    max = min = ltc_cellvoltage.voltage[0];
-    mean = 0;
-    for (i=0; i < BS_NR_OF_MODULES; i++) {
-        for (j=0; j < BS_NR_OF_BAT_CELLS_PER_MODULE; j++) {
-            mean += ltc_cellvoltage.voltage[i*(BS_NR_OF_BAT_CELLS_PER_MODULE)+j];
-            if (ltc_cellvoltage.voltage[i*(BS_NR_OF_BAT_CELLS_PER_MODULE)+j] < min) {
-                min = ltc_cellvoltage.voltage[i*(BS_NR_OF_BAT_CELLS_PER_MODULE)+j];
-                module_number_min = i;
-                cell_number_min = j;
-            }
-            if (ltc_cellvoltage.voltage[i*(BS_NR_OF_BAT_CELLS_PER_MODULE)+j] > max) {
-                max = ltc_cellvoltage.voltage[i*(BS_NR_OF_BAT_CELLS_PER_MODULE)+j];
-                module_number_max = i;
-                cell_number_max = j;
-            }
-        }
+    STAT_U16_RESULT_s stats;
+    STD_RETURN_TYPE_e retVal = E_NOT_OK;
+
+    // if every cell was parsed once in this cycle, the statistics are already accumulated
+    if ((ltc_voltage_acc_valid == TRUE) && (ltc_voltage_acc_chains == LTC_ALL_CHAINS_MASK) &&
+            (ltc_voltage_acc.count == BS_NR_OF_BAT_CELLS)) {
+        retVal = STAT_GetResultU16(&ltc_voltage_acc, &stats);
+    } else {
+        retVal = STAT_ReduceU16(ltc_cellvoltage.voltage, BS_NR_OF_BAT_CELLS, &stats);
     }
-    mean /= (BS_NR_OF_BAT_CELLS);
+    STAT_InitAccumulator(&ltc_voltage_acc);
+    ltc_voltage_acc_chains = 0;
+    ltc_voltage_acc_valid = TRUE;
+
+    if (retVal != E_OK) {
+        return;
+    }
+
+    OS_TaskEnter_Critical();
+    ltc_voltage_stats = stats;
+    OS_TaskExit_Critical();
 
-    DB_ReadBlock(&ltc_minmax, DATA_BLOCK_ID_MINMAX);
+    // ltc_minmax is owned by the LTC driver and is not read back from the database
     ltc_cellvoltage.state++;
     ltc_minmax.state++;
-    ltc_minmax.voltage_mean = mean;
+    ltc_minmax.voltage_mean = stats.mean;
     ltc_minmax.previous_voltage_min = ltc_minmax.voltage_min;
-    ltc_minmax.voltage_min = min;
-    ltc_minmax.voltage_module_number_min = module_number_min;
-    ltc_minmax.voltage_cell_number_min = cell_number_min;
+    ltc_minmax.voltage_min = stats.min;
+    ltc_minmax.voltage_module_number_min = stats.index_min/BS_NR_OF_BAT_CELLS_PER_MODULE;
+    ltc_minmax.voltage_cell_number_min = stats.index_min%BS_NR_OF_BAT_CELLS_PER_MODULE;
     ltc_minmax.previous_voltage_max = ltc_minmax.voltage_max;
-    ltc_minmax.voltage_max = max;
-    ltc_minmax.voltage_module_number_max = module_number_max;
-    ltc_minmax.voltage_cell_number_max = cell_number_max;
-    DB_WriteBlock(&ltc_cellvoltage, DATA_BLOCK_ID_CELLVOLTAGE);
-    DB_WriteBlock(&ltc_minmax, DATA_BLOCK_ID_MINMAX);
+    ltc_minmax.voltage_max = stats.max;
+    ltc_minmax.voltage_module_number_max = stats.index_max/BS_NR_OF_BAT_CELLS_PER_MODULE;
+    ltc_minmax.voltage_cell_number_max = stats.index_max%BS_NR_OF_BAT_CELLS_PER_MODULE;
+    DB_WriteBlockV(ltc_voltage_blocks, sizeof(ltc_voltage_blocks)/sizeof(ltc_voltage_blocks[0]));
+
+}
+
+
+extern STD_RETURN_TYPE_e LTC_GetCellVoltageStatistics(STAT_U16_RESULT_s *stats) {
+
+    if (stats == NULL_PTR) {
+        return E_NOT_OK;
+    }
+
+    OS_TaskEnter_Critical();
+    *stats = ltc_voltage_stats;
+    OS_TaskExit_Critical();
 
+    return E_OK;
 }
 
 /**
  * @brief   stores the measured temperatures and the measured multiplexer feedbacks in the database.
  *
- * This function loops through the temperature and multiplexer feedback data of all modules
- * in the LTC daisy-chain that are stored in the LTC_MultiplexerVoltages buffer and writes
- * them in the database.
+ * This function reduces the temperatures of all modules in the LTC daisy-chain in one
+ * pass (see STAT_ReduceS16()) and writes them in the database.
  * At each write iteration, the variables named "state" and related to temperatures and multiplexer feedbacks
  * in the database are incremented.
  *
@@ -379,47 +667,23 @@ extern void LTC_SaveVoltages(void) {
  */
 extern void LTC_SaveTemperatures(void) {
 
-    uint16_t i = 0;
-    uint16_t j = 0;
-    int16_t min = 0;
-    uint16_t max = 0;
-    int32_t mean = 0;
-    uint8_t module_number_min = 0;
-    uint8_t module_number_max = 0;
-    uint8_t sensor_number_min = 0;
-    uint8_t sensor_number_max = 0;
-
-    max = min = ltc_celltemperature.temperature[0];
-    mean = 0;
-    for (i=0; i < BS_NR_OF_MODULES; i++) {
-        for (j=0; j < BS_NR_OF_TEMP_SENSORS_PER_MODULE; j++) {
-            mean += ltc_celltemperature.temperature[i*(BS_NR_OF_TEMP_SENSORS_PER_MODULE)+j];
-            if (ltc_celltemperature.temperature[i*(BS_NR_OF_TEMP_SENSORS_PER_MODULE)+j] < min) {
-                min = ltc_celltemperature.temperature[i*(BS_NR_OF_TEMP_SENSORS_PER_MODULE)+j];
-                module_number_min = i;
-                sensor_number_min = j;
-            }
-            if (ltc_celltemperature.temperature[i*(BS_NR_OF_TEMP_SENSORS_PER_MODULE)+j] > max) {
-                max = ltc_celltemperature.temperature[i*(BS_NR_OF_TEMP_SENSORS_PER_MODULE)+j];
-                module_number_max = i;
-                sensor_number_max = j;
-            }
-        }
+    STAT_S16_RESULT_s stats;
+
+    if (STAT_ReduceS16(ltc_celltemperature.temperature, BS_NR_OF_TEMP_SENSORS, &stats) != E_OK) {
+        return;
     }
-    mean /= (BS_NR_OF_TEMP_SENSORS);
 
-    DB_ReadBlock(&ltc_minmax, DATA_BLOCK_ID_MINMAX);
+    // ltc_minmax is owned by the LTC driver and is not read back from the database
     ltc_celltemperature.state++;
     ltc_minmax.state++;
-    ltc_minmax.temperature_mean = mean;
-    ltc_minmax.temperature_min = min;
-    ltc_minmax.temperature_module_number_min = module_number_min;
-    ltc_minmax.temperature_sensor_number_min = sensor_number_min;
-    ltc_minmax.temperature_max = max;
-    ltc_minmax.temperature_module_number_max = module_number_max;
-    ltc_minmax.temperature_sensor_number_max = sensor_number_max;
-    DB_WriteBlock(&ltc_celltemperature, DATA_BLOCK_ID_CELLTEMPERATURE);
-    DB_WriteBlock(&ltc_minmax, DATA_BLOCK_ID_MINMAX);
+    ltc_minmax.temperature_mean = stats.mean;
+    ltc_minmax.temperature_min = stats.min;
+    ltc_minmax.temperature_module_number_min = stats.index_min/BS_NR_OF_TEMP_SENSORS_PER_MODULE;
+    ltc_minmax.temperature_sensor_number_min = stats.index_min%BS_NR_OF_TEMP_SENSORS_PER_MODULE;
+    ltc_minmax.temperature_max = stats.max;
+    ltc_minmax.temperature_module_number_max = stats.index_max/BS_NR_OF_TEMP_SENSORS_PER_MODULE;
+    ltc_minmax.temperature_sensor_number_max = stats.index_max%BS_NR_OF_TEMP_SENSORS_PER_MODULE;
+    DB_WriteBlockV(ltc_temperature_blocks, sizeof(ltc_temperature_blocks)/sizeof(ltc_temperature_blocks[0]));
 }
 
 /**
@@ -430,7 +694,7 @@ extern void LTC_SaveTemperatures(void) {
  * @return  void
  *
  */
-static void LTC_SaveBalancingFeedback(uint8_t *DataBufferSPI_RX) {
+static void LTC_SaveBalancingFeedback(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_RX) {
 
     uint16_t i = 0;
     uint16_t val_i = 0;
@@ -439,7 +703,7 @@ static void LTC_SaveBalancingFeedback(uint8_t *DataBufferSPI_RX) {
 
         val_i = DataBufferSPI_RX[8+1*i*8] | (DataBufferSPI_RX[8+1*i*8+1] << 8);    // raw value, GPIO3
 
-            ltc_balancing_feedback.value[i] = val_i;
+            ltc_balancing_feedback.value[LTC_MODULE_OFFSET(ltc_state)+i] = val_i;
 
     }
 
@@ -456,49 +720,28 @@ static void LTC_SaveBalancingFeedback(uint8_t *DataBufferSPI_RX) {
  *
  * This function gets the balancing control from the database. Balancing control
  * is set by the BMS. The LTC driver only executes the balancing orders.
+ * If the orders cannot be read, no cell is balanced.
  *
- * @return  void
- */
-static void LTC_Get_BalancingControlValues(void) {
-    DB_ReadBlock(&ltc_balancing_control, DATA_BLOCK_ID_BALANCING_CONTROL_VALUES);
-}
-
-
-/**
- * @brief   converts a raw voltage from multiplexer to a temperature value in Celsius.
- *
- * The temperatures are read from NTC elements via voltage dividers.
- * This function implements the look-up table between voltage and temperature,
- * taking into account the NTC characteristics and the voltage divider.
- *
- * @param   Vout            voltage read from the multiplexer in V
- *
- * @return  temperature     temperature value in Celsius
+ * @return  E_OK if the balancing orders were read, E_NOT_OK otherwise
  */
-static float LTC_Convert_MuxVoltages_to_Temperatures(float v_adc) {
-
-    float temperature = 0.0;
-    //float v_adc2 = v_adc*v_adc;
-    //float v_adc3 = v_adc2*v_adc;
-    //float v_adc4 = v_adc3*v_adc;
-    //float v_adc5 = v_adc4*v_adc;
-    //float v_adc6 = v_adc5*v_adc;
-
-    // Example: 5th grade polynomial for EPCOS B57861S0103F045 NTC-Thermistor, 10 kOhm, Series B57861S
-    //temperature = -6.2765*v_adc5 + 49.0397*v_adc4 - 151.3602*v_adc3 + 233.2521*v_adc2 - 213.4588*v_adc + 130.5822;
-
-
-    // Dummy function, must be adapted to the application
-    temperature = 0.01 * v_adc;
+static STD_RETURN_TYPE_e LTC_Get_BalancingControlValues(void) {
+    uint16_t i = 0;
 
-    return temperature;
+    if (DB_ReadBlock(&ltc_balancing_control, DATA_BLOCK_ID_BALANCING_CONTROL_VALUES) != E_OK) {
+        for (i=0; i < BS_NR_OF_BAT_CELLS; i++) {
+            ltc_balancing_control.value[i] = 0;
+        }
+        return E_NOT_OK;
+    }
+    return E_OK;
 }
 
+
 /**
  * @brief   re-entrance check of LTC state machine trigger function
  *
  * This function is not re-entrant and should only be called time- or event-triggered.
- * It increments the triggerentry counter from the state variable ltc_state.
+ * It increments the triggerentry counter from the state variable ltc_state->
  * It should never be called by two different processes, so if it is the case, triggerentry
  * should never be higher than 0 when this function is called.
  *
@@ -506,12 +749,12 @@ static float LTC_Convert_MuxVoltages_to_Temperatures(float v_adc) {
  * @return  retval  0 if no further instance of the function is active, 0xff else
  *
  */
-uint8_t LTC_CheckReEntrance(void) {
+uint8_t LTC_CheckReEntrance(LTC_STATE_s *ltc_state) {
     uint8_t retval = 0;
 
     OS_TaskEnter_Critical();
-    if (!ltc_state.triggerentry) {
-        ltc_state.triggerentry++;
+    if (!ltc_state->triggerentry) {
+        ltc_state->triggerentry++;
     } else {
         retval = 0xFF;    // multiple calls of function
     }
@@ -520,10 +763,36 @@ uint8_t LTC_CheckReEntrance(void) {
     return (retval);
 }
 
+/**
+ * @brief   gets the communication error statistics of one LTC.
+ *
+ * @param   module  index of the LTC, 0 ... BS_NR_OF_MODULES-1
+ * @param   errors  where the statistics are copied to
+ *
+ * @return  E_OK if the statistics were copied, E_NOT_OK if module is out of range or errors is NULL_PTR
+ */
+extern STD_RETURN_TYPE_e LTC_GetDeviceErrors(uint16_t module, LTC_DEVICE_ERRORS_s *errors) {
+
+    if ((module >= BS_NR_OF_MODULES) || (errors == NULL_PTR)) {
+        return E_NOT_OK;
+    }
+
+    OS_TaskEnter_Critical();
+    errors->errPECCnt = ltc_errPECCnt[module];
+    errors->errSPICnt = ltc_errSPICnt[module];
+    errors->errRetryCnt = ltc_errRetryCnt[module];
+    errors->errConsecutivePECCnt = ltc_errConsecutivePECCnt[module];
+    errors->lastValidTimestamp = ltc_lastValidTimestamp[module];
+    OS_TaskExit_Critical();
+
+    return E_OK;
+}
+
 /**
  * @brief   gets the current state request.
  *
  * This function is used in the functioning of the LTC state machine.
+ * The request is made to all daisy-chains, the one of the first daisy-chain is returned.
  *
  * @return  retval  current state request, taken from LTC_STATE_REQUEST_e
  */
@@ -532,7 +801,7 @@ extern LTC_STATE_REQUEST_e LTC_GetStateRequest(void) {
     LTC_STATE_REQUEST_e retval = LTC_STATE_NO_REQUEST;
 
     OS_TaskEnter_Critical();
-    retval    = ltc_state.statereq;
+    retval    = ltc_states[0].statereq;
     OS_TaskExit_Critical();
 
     return (retval);
@@ -542,11 +811,12 @@ extern LTC_STATE_REQUEST_e LTC_GetStateRequest(void) {
  * @brief   gets the current state.
  *
  * This function is used in the functioning of the LTC state machine.
+ * The state of the first daisy-chain is returned.
  *
  * @return  current state, taken from LTC_STATEMACH_e
  */
 extern LTC_STATEMACH_e LTC_GetState(void) {
-    return (ltc_state.state);
+    return (ltc_states[0].state);
 }
 
 /**
@@ -562,15 +832,15 @@ extern LTC_STATEMACH_e LTC_GetState(void) {
  * @return  retVal          current state request, taken from LTC_STATE_REQUEST_e
  *
  */
-LTC_STATE_REQUEST_e LTC_TransferStateRequest(uint8_t *busIDptr, LTC_ADCMODE_e *adcModeptr, LTC_ADCMEAS_CHAN_e *adcMeasChptr) {
+LTC_STATE_REQUEST_e LTC_TransferStateRequest(LTC_STATE_s *ltc_state, uint8_t *busIDptr, LTC_ADCMODE_e *adcModeptr, LTC_ADCMEAS_CHAN_e *adcMeasChptr) {
 
     LTC_STATE_REQUEST_e retval = LTC_STATE_NO_REQUEST;
 
     OS_TaskEnter_Critical();
-    retval    = ltc_state.statereq;
-    *adcModeptr = ltc_state.adcModereq;
-    *adcMeasChptr = ltc_state.adcMeasChreq;
-    ltc_state.statereq = LTC_STATE_NO_REQUEST;
+    retval    = ltc_state->statereq;
+    *adcModeptr = ltc_state->adcModereq;
+    *adcMeasChptr = ltc_state->adcMeasChreq;
+    ltc_state->statereq = LTC_STATE_NO_REQUEST;
     OS_TaskExit_Critical();
 
     return (retval);
@@ -579,113 +849,150 @@ LTC_STATE_REQUEST_e LTC_TransferStateRequest(uint8_t *busIDptr, LTC_ADCMODE_e *a
 LTC_RETURN_TYPE_e LTC_SetStateRequest(LTC_STATE_REQUEST_e statereq) {
 
     LTC_RETURN_TYPE_e retVal = LTC_STATE_NO_REQUEST;
+    uint8_t i = 0;
 
     OS_TaskEnter_Critical();
-    retVal = LTC_CheckStateRequest(statereq);
+    // the request is only made if all daisy-chains accept it
+    for (i=0; i < LTC_NR_OF_CHAINS; i++) {
+        retVal = LTC_CheckStateRequest(&ltc_states[i], statereq);
+        if (retVal != LTC_OK && retVal != LTC_BUSY_OK && retVal != LTC_OK_FROM_ERROR) {
+            break;
+        }
+    }
 
     if (retVal == LTC_OK || retVal == LTC_BUSY_OK || retVal == LTC_OK_FROM_ERROR) {
-            ltc_state.statereq   = statereq;
+        for (i=0; i < LTC_NR_OF_CHAINS; i++) {
+            ltc_states[i].statereq   = statereq;
         }
+    }
     OS_TaskExit_Critical();
 
     return (retVal);
 }
 
+void LTC_SetNotifiedTask(void *taskhandle) {
+    ltc_notifiedTask = taskhandle;
+}
+
 void LTC_Trigger(void) {
 
+    uint8_t i = 0;
+
+    DIAG_SysMonNotify(DIAG_SYSMON_LTC_ID, 0);        // task is running, state = ok
+
+    // the daisy-chains are on separate SPI interfaces, so their transfers overlap
+    for (i=0; i < LTC_NR_OF_CHAINS; i++) {
+        LTC_StateMachine(&ltc_states[i]);
+    }
+}
+
+
+/**
+ * @brief   processes the current state of the state machine of one daisy-chain.
+ *
+ * The state is only processed if its deadline elapsed or, for states waiting for an
+ * SPI transfer, once the transfer on the SPI interface of the daisy-chain is complete.
+ *
+ * @param   ltc_state   state of the daisy-chain
+ *
+ * @return  void
+ */
+static void LTC_StateMachine(LTC_STATE_s *ltc_state) {
+
 
     STD_RETURN_TYPE_e retVal = E_OK;
+    uint8_t i = 0;
     LTC_STATE_REQUEST_e statereq = LTC_STATE_NO_REQUEST;
     uint8_t tmpbusID = 0;
     LTC_ADCMODE_e tmpadcMode = LTC_ADCMODE_UNDEFINED;
     LTC_ADCMEAS_CHAN_e tmpadcMeasCh = LTC_ADCMEAS_UNDEFINED;
+    uint32_t stepTime = 0;
+    int32_t remainingTime = 0;
+    uint8_t earlyStep = FALSE;
+    uint8_t nrOfRereads = 0;
 
     // Check re-entrance of function
-    if (LTC_CheckReEntrance())
+    if (LTC_CheckReEntrance(ltc_state))
         return;
 
-    DIAG_SysMonNotify(DIAG_SYSMON_LTC_ID, 0);        // task is running, state = ok
+    // ltc_state->timer holds the time left until the deadline of the current state
+    stepTime = MCU_GetTimeStamp();
+    remainingTime = (int32_t)(ltc_state->nextStepTime - stepTime);
+    ltc_state->timer = (remainingTime > 0) ? (uint16_t)remainingTime : 0;
 
-    if (ltc_state.check_spi_flag == FALSE) {
-        if (ltc_state.timer) {
-            if (--ltc_state.timer) {
-                ltc_state.triggerentry--;
-                return;    // handle state machine only if timer has elapsed
-            }
-        }
-    } else {
-        if (SPI_IsTransmitOngoing() == TRUE) {
-            if (ltc_state.timer) {
-                if (--ltc_state.timer) {
-                    ltc_state.triggerentry--;
-                    return;    // handle state machine only if timer has elapsed
-                }
-            }
+    if (ltc_state->timer) {
+        if (ltc_state->check_spi_flag == FALSE || SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
+            ltc_state->triggerentry--;
+            return;    // handle state machine only if deadline has elapsed
         }
+        // the SPI transfer the state waits for completed before its deadline
+        earlyStep = TRUE;
     }
 
 
-    switch (ltc_state.state) {
+    switch (ltc_state->state) {
         /****************************UNINITIALIZED***********************************/
         case LTC_STATEMACH_UNINITIALIZED:
             // waiting for Initialization Request
-            statereq = LTC_TransferStateRequest(&tmpbusID, &tmpadcMode, &tmpadcMeasCh);
+            statereq = LTC_TransferStateRequest(ltc_state, &tmpbusID, &tmpadcMode, &tmpadcMeasCh);
             if (statereq == LTC_STATE_INIT_REQUEST) {
 
                 LTC_SAVELASTSTATES();
-                ltc_state.timer = LTC_STATEMACH_SHORTTIME;
-                ltc_state.state = LTC_STATEMACH_INITIALIZATION;
-                ltc_state.substate = LTC_ENTRY_UNINITIALIZED;
-                ltc_state.adcMode = tmpadcMode;
-                ltc_state.adcMeasCh = tmpadcMeasCh;
+                ltc_state->timer = LTC_STATEMACH_SHORTTIME;
+                ltc_state->state = LTC_STATEMACH_INITIALIZATION;
+                ltc_state->substate = LTC_ENTRY_UNINITIALIZED;
+                ltc_state->adcMode = tmpadcMode;
+                ltc_state->adcMeasCh = tmpadcMeasCh;
             } else if (statereq == LTC_STATE_NO_REQUEST) {
 
                 // no actual request pending //
             } else {
-                ltc_state.ErrRequestCounter++;   // illegal request pending
+                ltc_state->ErrRequestCounter++;   // illegal request pending
             }
             break;
 
         /****************************INITIALIZATION**********************************/
         case LTC_STATEMACH_INITIALIZATION:
 
-            LTC_SetTransferTimes();
-            ltc_state.muxmeas_seqptr = ltc_mux_seq.seqptr;
-            ltc_state.muxmeas_nr_end = ltc_mux_seq.nr_of_steps;
-            ltc_state.muxmeas_seqendptr = ((LTC_MUX_CH_CFG_s *)ltc_mux_seq.seqptr)+ltc_mux_seq.nr_of_steps;  // last sequence + 1
+            LTC_SetTransferTimes(ltc_state);
+            ltc_state->muxmeas_seqptr = ltc_mux_seq.seqptr;
+            ltc_state->muxmeas_nr_end = ltc_mux_seq.nr_of_steps;
+            ltc_state->muxmeas_seqendptr = ((LTC_MUX_CH_CFG_s *)ltc_mux_seq.seqptr)+ltc_mux_seq.nr_of_steps;  // last sequence + 1
+            LTC_MuxResetAdaptive(ltc_state);
 
-            if (ltc_state.substate == LTC_ENTRY_INITIALIZATION) {
+            if (ltc_state->substate == LTC_ENTRY_INITIALIZATION) {
 
                 LTC_SAVELASTSTATES();
-                retVal = LTC_SendWakeUp();        // Send dummy byte to wake up the daisy chain
+                SPI_SetDeviceBusID(ltc_state->spiHandle, ltc_state->spiBusID);
+                retVal = LTC_ChainSendWakeUp(ltc_state);        // Send dummy byte to wake up the daisy chain
 
                 if ((retVal != E_OK)) {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                    ltc_state.timer = LTC_STATEMACH_SHORTTIME;
+                    ltc_state->timer = LTC_STATEMACH_SHORTTIME;
                 } else {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                    ltc_state.substate = LTC_RE_ENTRY_INITIALIZATION;
-                    ltc_state.timer = LTC_STATEMACH_DAISY_CHAIN_FIRST_INITIALIZATION_TIME;
+                    ltc_state->substate = LTC_RE_ENTRY_INITIALIZATION;
+                    ltc_state->timer = LTC_STATEMACH_DAISY_CHAIN_FIRST_INITIALIZATION_TIME;
                 }
 
-            } else if (ltc_state.substate == LTC_RE_ENTRY_INITIALIZATION) {
+            } else if (ltc_state->substate == LTC_RE_ENTRY_INITIALIZATION) {
 
                 LTC_SAVELASTSTATES();
-                retVal = LTC_SendWakeUp();  // Send dummy byte again to wake up the daisy chain
+                retVal = LTC_ChainSendWakeUp(ltc_state);  // Send dummy byte again to wake up the daisy chain
 
                 if ((retVal != E_OK)) {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                    ltc_state.timer = LTC_STATEMACH_SHORTTIME;
+                    ltc_state->timer = LTC_STATEMACH_SHORTTIME;
                 } else {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                    ltc_state.substate = LTC_START_INIT_INITIALIZATION;
-                    ltc_state.timer = LTC_STATEMACH_DAISY_CHAIN_SECOND_INITIALIZATION_TIME;
+                    ltc_state->substate = LTC_START_INIT_INITIALIZATION;
+                    ltc_state->timer = LTC_STATEMACH_DAISY_CHAIN_SECOND_INITIALIZATION_TIME;
                 }
 
-            } else if (ltc_state.substate == LTC_START_INIT_INITIALIZATION) {
+            } else if (ltc_state->substate == LTC_START_INIT_INITIALIZATION) {
 
-                retVal = LTC_Init();  // Initialize main LTC loop
-                ltc_state.lastsubstate = ltc_state.substate;
+                retVal = LTC_Init(ltc_state);  // Initialize main LTC loop
+                ltc_state->lastsubstate = ltc_state->substate;
 
                 if ((retVal != E_OK)) {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
@@ -693,17 +1000,20 @@ void LTC_Trigger(void) {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                 }
 
-                ltc_state.substate = LTC_EXIT_INITIALIZATION;
-                ltc_state.timer = ltc_state.commandDataTransferTime;
+                ltc_state->substate = LTC_EXIT_INITIALIZATION;
+                ltc_state->timer = ltc_state->commandDataTransferTime;
 
-            } else if (ltc_state.substate == LTC_EXIT_INITIALIZATION) {
+            } else if (ltc_state->substate == LTC_EXIT_INITIALIZATION) {
             // in daisy-chain mode, there is no confirmation of the initialization
                 LTC_SAVELASTSTATES();
-                LTC_Initialize_Database();
-                LTC_ResetErrorTable();
-                ltc_state.timer = LTC_STATEMACH_SHORTTIME;
-                ltc_state.state = LTC_STATEMACH_INITIALIZED;
-                ltc_state.substate = LTC_ENTRY_INITIALIZATION;
+                if (ltc_state->instanceID == 0) {
+                    // the database blocks are shared by all daisy-chains
+                    LTC_Initialize_Database();
+                }
+                LTC_ResetErrorTable(ltc_state);
+                ltc_state->timer = LTC_STATEMACH_SHORTTIME;
+                ltc_state->state = LTC_STATEMACH_INITIALIZED;
+                ltc_state->substate = LTC_ENTRY_INITIALIZATION;
             }
             break;
 
@@ -711,28 +1021,28 @@ void LTC_Trigger(void) {
         case LTC_STATEMACH_INITIALIZED:
             LTC_IF_INITIALIZED_CALLBACK();
             LTC_SAVELASTSTATES();
-            ltc_state.timer = LTC_STATEMACH_SHORTTIME;
-            ltc_state.state = LTC_STATEMACH_STARTMEAS;
-            ltc_state.substate = LTC_ENTRY;
+            ltc_state->timer = LTC_STATEMACH_SHORTTIME;
+            ltc_state->state = LTC_STATEMACH_STARTMEAS;
+            ltc_state->substate = LTC_ENTRY;
             break;
 
         /****************************START MEASUREMENT*******************************/
         case LTC_STATEMACH_STARTMEAS:
 
-            ltc_state.adcMode = LTC_VOLTAGE_MEASUREMENT_MODE;
-            ltc_state.adcMeasCh = LTC_ADCMEAS_ALLCHANNEL;
+            ltc_state->adcMode = LTC_VOLTAGE_MEASUREMENT_MODE;
+            ltc_state->adcMeasCh = LTC_ADCMEAS_ALLCHANNEL;
 
-            ltc_state.check_spi_flag = FALSE;
-            retVal = LTC_StartVoltageMeasurement(ltc_state.adcMode, ltc_state.adcMeasCh);
+            ltc_state->check_spi_flag = FALSE;
+            retVal = LTC_StartVoltageMeasurement(ltc_state, ltc_state->adcMode, ltc_state->adcMeasCh);
 
             if ((retVal != E_OK)) {
                 DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                ltc_state.timer = LTC_STATEMACH_SHORTTIME;
+                ltc_state->timer = LTC_STATEMACH_SHORTTIME;
             } else {
                 DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                ltc_state.timer = ltc_state.commandTransferTime + LTC_Get_MeasurementTCycle(ltc_state.adcMode, ltc_state.adcMeasCh);
-                ltc_state.state = LTC_STATEMACH_READVOLTAGE;
-                ltc_state.substate = LTC_READ_VOLTAGE_REGISTER_A_RDCVA_READVOLTAGE;
+                ltc_state->timer = ltc_state->commandTransferTime + LTC_Get_MeasurementTCycle(ltc_state->adcMode, ltc_state->adcMeasCh);
+                ltc_state->state = LTC_STATEMACH_READVOLTAGE;
+                ltc_state->substate = LTC_READ_VOLTAGE_REGISTER_A_RDCVA_READVOLTAGE;
             }
 
             break;
@@ -740,165 +1050,84 @@ void LTC_Trigger(void) {
         /****************************READ VOLTAGE************************************/
         case LTC_STATEMACH_READVOLTAGE:
 
-            if (ltc_state.substate == LTC_READ_VOLTAGE_REGISTER_A_RDCVA_READVOLTAGE) {
-
-                ltc_state.check_spi_flag = TRUE;
-                SPI_SetTransmitOngoing();
-                retVal = LTC_RX((uint8_t*)(ltc_cmdRDCVA), ltc_RXPECbuffer);
-                if (retVal != E_OK) {
-                    DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                    ltc_state.timer = 0;
-                } else {
-                    DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                    ltc_state.timer = ltc_state.commandDataTransferTime+10;
-                }
-                    ltc_state.substate = LTC_READ_VOLTAGE_REGISTER_B_RDCVB_READVOLTAGE;
-
-                break;
-
-            } else if (ltc_state.substate == LTC_READ_VOLTAGE_REGISTER_B_RDCVB_READVOLTAGE) {
-
-                if (LTC_RX_PECCheck(ltc_RXPECbuffer) != E_OK) {
-                    DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_NOK, 0, NULL_PTR);
-                } else {
-                    DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_OK, 0, NULL_PTR);
-                    LTC_SaveRXtoVoltagebuffer(0, ltc_RXPECbuffer);
-                }
-
-                SPI_SetTransmitOngoing();
-                retVal = LTC_RX((uint8_t*)(ltc_cmdRDCVB), ltc_RXPECbuffer);
-                if (retVal != E_OK) {
-                    DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                    ltc_state.timer = 0;
-                } else {
-                    DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                    ltc_state.timer = ltc_state.commandDataTransferTime+10;
-                }
-                    ltc_state.substate = LTC_READ_VOLTAGE_REGISTER_C_RDCVC_READVOLTAGE;
-
-
-                break;
-
-            } else if (ltc_state.substate == LTC_READ_VOLTAGE_REGISTER_C_RDCVC_READVOLTAGE) {
-
-                if (LTC_RX_PECCheck(ltc_RXPECbuffer) != E_OK) {
-                    DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_NOK, 0, NULL_PTR);
-                } else {
-                    DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_OK, 0, NULL_PTR);
-                    LTC_SaveRXtoVoltagebuffer(1, ltc_RXPECbuffer);
-                }
-
-                SPI_SetTransmitOngoing();
-                retVal = LTC_RX((uint8_t*)(ltc_cmdRDCVC), ltc_RXPECbuffer);
-                if (retVal != E_OK) {
-                    DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                    ltc_state.timer = 0;
-                } else {
-                    DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                    ltc_state.timer = ltc_state.commandDataTransferTime+10;
-                }
-                    ltc_state.substate = LTC_READ_VOLTAGE_REGISTER_D_RDCVD_READVOLTAGE;
-
-                break;
-
-            } else if (ltc_state.substate == LTC_READ_VOLTAGE_REGISTER_D_RDCVD_READVOLTAGE) {
-
-                if (LTC_RX_PECCheck(ltc_RXPECbuffer) != E_OK) {
-                    DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_NOK, 0, NULL_PTR);
-                } else {
-                    DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_OK, 0, NULL_PTR);
-                    LTC_SaveRXtoVoltagebuffer(2, ltc_RXPECbuffer);
-                }
-
-                SPI_SetTransmitOngoing();
-                retVal = LTC_RX((uint8_t*)(ltc_cmdRDCVD), ltc_RXPECbuffer);
-                if (retVal != E_OK) {
-                    DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                    ltc_state.timer = 0;
-                } else {
-                    DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                    ltc_state.timer = ltc_state.commandDataTransferTime+10;
-                }
-
-                if (BS_MAX_SUPPORTED_CELLS > 12) {
-                    ltc_state.substate = LTC_READ_VOLTAGE_REGISTER_E_RDCVE_READVOLTAGE;
-                } else {
-                    ltc_state.substate = LTC_EXIT_READVOLTAGE;
-                }
-
-                break;
-
-            } else if (ltc_state.substate == LTC_READ_VOLTAGE_REGISTER_E_RDCVE_READVOLTAGE) {
-
-                if (LTC_RX_PECCheck(ltc_RXPECbuffer) != E_OK) {
-                    DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_NOK, 0, NULL_PTR);
-                } else {
-                    DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_OK, 0, NULL_PTR);
-                    LTC_SaveRXtoVoltagebuffer(3, ltc_RXPECbuffer);
-                }
-
-                SPI_SetTransmitOngoing();
-                retVal = LTC_RX((uint8_t*)(ltc_cmdRDCVD), ltc_RXPECbuffer);
-                if (retVal != E_OK) {
-                    DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                    ltc_state.timer = 0;
-                } else {
-                    DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                    ltc_state.timer = ltc_state.commandDataTransferTime+10;
-                }
-
-                if (BS_MAX_SUPPORTED_CELLS > 15) {
-                    ltc_state.substate = LTC_READ_VOLTAGE_REGISTER_F_RDCVF_READVOLTAGE;
-                } else {
-                    ltc_state.substate = LTC_EXIT_READVOLTAGE;
-                }
-
-                break;
-
-            } else if (ltc_state.substate == LTC_READ_VOLTAGE_REGISTER_F_RDCVF_READVOLTAGE) {
-
-                if (LTC_RX_PECCheck(ltc_RXPECbuffer) != E_OK) {
-                    DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_NOK, 0, NULL_PTR);
-                } else {
-                    DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_OK, 0, NULL_PTR);
-                    LTC_SaveRXtoVoltagebuffer(4, ltc_RXPECbuffer);
-                }
-
-                SPI_SetTransmitOngoing();
-                retVal = LTC_RX((uint8_t*)(ltc_cmdRDCVD), ltc_RXPECbuffer);
+            if (ltc_state->substate == LTC_READ_VOLTAGE_REGISTER_A_RDCVA_READVOLTAGE) {
+
+                // read all register groups in one burst, the SPI interrupt starts the next read command
+                ltc_state->check_spi_flag = TRUE;
+                ltc_voltagePending[ltc_state->instanceID] = (uint8_t)((1u << LTC_VOLTAGE_REGISTER_GROUPS)-1);
+                ltc_state->errStatus.errPECRetryCnt = 0;
+                retVal = LTC_RX_VoltageRegisters(ltc_state);
                 if (retVal != E_OK) {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                    ltc_state.timer = 0;
+                    ltc_state->timer = 0;
                 } else {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                    ltc_state.timer = ltc_state.commandDataTransferTime+10;
+                    ltc_state->timer = LTC_VOLTAGE_REGISTER_GROUPS*ltc_state->commandDataTransferTime+10;
                 }
-                    ltc_state.substate = LTC_EXIT_READVOLTAGE;
+                ltc_state->substate = LTC_EXIT_READVOLTAGE;
 
                 break;
 
-            } else if (ltc_state.substate == LTC_EXIT_READVOLTAGE) {
+            } else if (ltc_state->substate == LTC_EXIT_READVOLTAGE) {
 
-                if (LTC_RX_PECCheck(ltc_RXPECbuffer) != E_OK) {
-                    DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_NOK, 0, NULL_PTR);
+                if (SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
+                    // deadline expired before the burst completed, the receive buffers are not parsed
+                    (void)SPI_AbortChain(ltc_state->spiHandle);
+                    (void)LTC_ChainSPIStatus(ltc_state, E_NOT_OK);
+                    DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
+                    ltc_state->check_spi_flag = FALSE;
                 } else {
-                    DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_OK, 0, NULL_PTR);
-                    if (BS_MAX_SUPPORTED_CELLS == 12) {
-                        LTC_SaveRXtoVoltagebuffer(3, ltc_RXPECbuffer);
-                    } else if (BS_MAX_SUPPORTED_CELLS == 15) {
-                        LTC_SaveRXtoVoltagebuffer(4, ltc_RXPECbuffer);
-                    } else if (BS_MAX_SUPPORTED_CELLS == 18) {
-                        LTC_SaveRXtoVoltagebuffer(5, ltc_RXPECbuffer);
+                    // only the groups not yet received with valid PEC, after a re-read the others are unchanged
+                    for (i=0; i < LTC_VOLTAGE_REGISTER_GROUPS; i++) {
+                        if ((ltc_voltagePending[ltc_state->instanceID] & (1u << i)) == 0) {
+                            continue;
+                        }
+                        if (LTC_RX_PECCheck(ltc_state, ltc_voltageRXPECbuffer[ltc_state->instanceID][i]) != E_OK) {
+                            DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_NOK, 0, NULL_PTR);
+                        } else {
+                            DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_OK, 0, NULL_PTR);
+                            LTC_SaveRXtoVoltagebuffer(ltc_state, i, ltc_voltageRXPECbuffer[ltc_state->instanceID][i]);
+                            ltc_voltagePending[ltc_state->instanceID] &= (uint8_t)~(1u << i);
+                        }
+                    }
+
+                    if ((ltc_voltagePending[ltc_state->instanceID] != 0) && (ltc_state->errStatus.errPECRetryCnt < LTC_PEC_MAX_REREADS)) {
+                        // read only the failed register groups again instead of restarting the measurement
+                        ltc_state->errStatus.errPECRetryCnt++;
+                        ltc_state->ErrRetryCounter++;
+                        ltc_state->check_spi_flag = TRUE;
+                        nrOfRereads = LTC_RX_VoltageRegisterReread(ltc_state);
+                        if (nrOfRereads != 0) {
+                            ltc_state->timer = nrOfRereads*ltc_state->commandDataTransferTime+10;
+                            break;
+                        }
+                        DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
+                        ltc_state->check_spi_flag = FALSE;
                     }
                 }
 
-                ltc_cellvoltage.previous_timestamp = ltc_cellvoltage.timestamp;
-                ltc_cellvoltage.timestamp = MCU_GetTimeStamp();
-                LTC_SaveVoltages();
+                if (ltc_voltagePending[ltc_state->instanceID] != 0) {
+                    ltc_state->errStatus.nrOfConsecutiveErrors++;
+                } else {
+                    ltc_state->errStatus.nrOfConsecutiveErrors = 0;
+                }
+
+                // the accumulated statistics are only valid if every daisy-chain added all its cells once
+                if (((ltc_voltage_acc_chains & (1u << ltc_state->instanceID)) != 0) ||
+                        (ltc_voltagePending[ltc_state->instanceID] != 0)) {
+                    ltc_voltage_acc_valid = FALSE;
+                }
+                ltc_voltage_acc_chains |= (uint8_t)(1u << ltc_state->instanceID);
+
+                if (LTC_ChainDone(&ltc_voltage_chains_done, ltc_state->instanceID) == TRUE) {
+                    ltc_cellvoltage.previous_timestamp = ltc_cellvoltage.timestamp;
+                    ltc_cellvoltage.timestamp = MCU_GetTimeStamp();
+                    LTC_SaveVoltages();
+                }
 
-                    ltc_state.state = LTC_STATEMACH_MUXMEASUREMENT;
-                    ltc_state.substate = LTC_STATEMACH_MUXCONFIGURATION_INIT;
-                    ltc_state.timer = 0;
+                    ltc_state->state = LTC_STATEMACH_MUXMEASUREMENT;
+                    ltc_state->substate = LTC_STATEMACH_MUXCONFIGURATION_INIT;
+                    ltc_state->timer = 0;
             }
 
             break;
@@ -907,254 +1136,262 @@ void LTC_Trigger(void) {
         /****************************MULTIPLEXED MEASUREMENT CONFIGURATION***********/
         case LTC_STATEMACH_MUXMEASUREMENT:
 
-            if (ltc_state.substate == LTC_STATEMACH_MUXCONFIGURATION_INIT) {
+            if (ltc_state->substate == LTC_STATEMACH_MUXCONFIGURATION_INIT) {
 
-                ltc_state.adcMode = LTC_GPIO_MEASUREMENT_MODE;
-                ltc_state.adcMeasCh = LTC_ADCMEAS_SINGLECHANNEL_GPIO1;
+                ltc_state->adcMode = LTC_GPIO_MEASUREMENT_MODE;
+                ltc_state->adcMeasCh = LTC_ADCMEAS_SINGLECHANNEL_GPIO1;
 
-                if (ltc_state.muxmeas_seqptr >= ltc_state.muxmeas_seqendptr) {
+                if ((ltc_mux_extrastep[ltc_state->instanceID] == NULL_PTR) && (ltc_state->muxmeas_seqptr >= ltc_state->muxmeas_seqendptr)) {
                     // last step of sequence reached (or no sequence configured)
 
-                    ltc_state.muxmeas_seqptr = ltc_mux_seq.seqptr;
-                    ltc_state.muxmeas_nr_end = ltc_mux_seq.nr_of_steps;
-                    ltc_state.muxmeas_seqendptr = ((LTC_MUX_CH_CFG_s *)ltc_mux_seq.seqptr)+ltc_mux_seq.nr_of_steps;  // last sequence + 1
+                    ltc_state->muxmeas_seqptr = ltc_mux_seq.seqptr;
+                    ltc_state->muxmeas_nr_end = ltc_mux_seq.nr_of_steps;
+                    ltc_state->muxmeas_seqendptr = ((LTC_MUX_CH_CFG_s *)ltc_mux_seq.seqptr)+ltc_mux_seq.nr_of_steps;  // last sequence + 1
 
-                    ltc_celltemperature.previous_timestamp = ltc_celltemperature.timestamp;
-                    ltc_celltemperature.timestamp = MCU_GetTimeStamp();
-                    LTC_SaveTemperatures();
+                    if (LTC_ChainDone(&ltc_temperature_chains_done, ltc_state->instanceID) == TRUE) {
+                        ltc_celltemperature.previous_timestamp = ltc_celltemperature.timestamp;
+                        ltc_celltemperature.timestamp = MCU_GetTimeStamp();
+                        LTC_SaveTemperatures();
 
-                    if (LTC_IsFirstMeasurementCycleFinished() == FALSE) {
-                        LTC_SetFirstMeasurementCycleFinished();
+                        if (LTC_IsFirstMeasurementCycleFinished() == FALSE) {
+                            LTC_SetFirstMeasurementCycleFinished();
+                        }
                     }
 
                 }
 
-                SPI_SetTransmitOngoing();
-                retVal = LTC_SetMuxChannel(ltc_TXBuffer, ltc_TXPECbuffer,
-                                            ltc_state.muxmeas_seqptr->muxID,  /* mux */
-                                            ltc_state.muxmeas_seqptr->muxCh  /* channel */);
+                SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                retVal = LTC_SetMuxChannel(ltc_state, ltc_TXBuffer[ltc_state->instanceID], ltc_TXPECbuffer[ltc_state->instanceID],
+                                            LTC_MuxCurrentStep(ltc_state)->muxID,  /* mux */
+                                            LTC_MuxCurrentStep(ltc_state)->muxCh  /* channel */);
                 if (retVal != E_OK) {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                    ++ltc_state.muxmeas_seqptr;
-                    ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                    ltc_state.substate = LTC_ENTRY;
-                    ltc_state.timer = 0;
+                    LTC_MuxStepDone(ltc_state);
+                    ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                    ltc_state->substate = LTC_ENTRY;
+                    ltc_state->timer = 0;
                 } else {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                    ltc_state.substate = LTC_SEND_CLOCK_STCOMM_MUXMEASUREMENT_CONFIG;
-                    ltc_state.timer = ltc_state.commandDataTransferTime+10;
+                    ltc_state->substate = LTC_SEND_CLOCK_STCOMM_MUXMEASUREMENT_CONFIG;
+                    ltc_state->timer = ltc_state->commandDataTransferTime+10;
                 }
 
                 break;
 
-            } else if (ltc_state.substate == LTC_SEND_CLOCK_STCOMM_MUXMEASUREMENT_CONFIG) {
+            } else if (ltc_state->substate == LTC_SEND_CLOCK_STCOMM_MUXMEASUREMENT_CONFIG) {
 
-                if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                    ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                    ltc_state.substate = LTC_ENTRY;
-                    ltc_state.timer = 0;
+                    ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                    ltc_state->substate = LTC_ENTRY;
+                    ltc_state->timer = 0;
                     break;
                 } else {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                 }
 
-                SPI_SetTransmitOngoing();
-                retVal = LTC_I2CClock(ltc_TXBufferClock, ltc_TXPECBufferClock);
+                SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                retVal = LTC_I2CClock(ltc_state, ltc_TXBufferClock[ltc_state->instanceID], ltc_TXPECBufferClock[ltc_state->instanceID]);
                 if (retVal != E_OK) {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                    ltc_state.timer = 0;
+                    ltc_state->timer = 0;
                 } else {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                    ltc_state.timer = ltc_state.gpioClocksTransferTime+10;
+                    ltc_state->timer = ltc_state->gpioClocksTransferTime+10;
                 }
 
                 if (LTC_GOTO_MUX_CHECK == TRUE) {
-                    ltc_state.substate = LTC_READ_I2C_TRANSMISSION_RESULT_RDCOMM_MUXMEASUREMENT_CONFIG;
+                    ltc_state->substate = LTC_READ_I2C_TRANSMISSION_RESULT_RDCOMM_MUXMEASUREMENT_CONFIG;
                 } else {
-                    ltc_state.substate = LTC_STATEMACH_MUXMEASUREMENT;
+                    ltc_state->substate = LTC_STATEMACH_MUXMEASUREMENT;
                 }
 
                 break;
 
-            } else if (ltc_state.substate == LTC_READ_I2C_TRANSMISSION_RESULT_RDCOMM_MUXMEASUREMENT_CONFIG) {
+            } else if (ltc_state->substate == LTC_READ_I2C_TRANSMISSION_RESULT_RDCOMM_MUXMEASUREMENT_CONFIG) {
 
-                if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                    ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                    ltc_state.substate = LTC_ENTRY;
-                    ltc_state.timer = 0;
+                    ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                    ltc_state->substate = LTC_ENTRY;
+                    ltc_state->timer = 0;
                     break;
                 } else {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                 }
 
-                SPI_SetTransmitOngoing();
-                retVal = LTC_RX((uint8_t*)ltc_cmdRDCOMM, ltc_RXPECbuffer);
+                SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                retVal = LTC_RX(ltc_state, (uint8_t*)ltc_cmdRDCOMM, ltc_RXPECbuffer[ltc_state->instanceID]);
                 if (retVal != E_OK) {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                    ltc_state.timer = 0;
+                    ltc_state->timer = 0;
                 } else {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                    ltc_state.timer = ltc_state.commandDataTransferTime;
+                    ltc_state->timer = ltc_state->commandDataTransferTime;
                 }
 
-                ltc_state.substate = LTC_READ_I2C_TRANSMISSION_CHECK_MUXMEASUREMENT_CONFIG;
+                ltc_state->substate = LTC_READ_I2C_TRANSMISSION_CHECK_MUXMEASUREMENT_CONFIG;
 
                 break;
 
-            } else if (ltc_state.substate == LTC_READ_I2C_TRANSMISSION_CHECK_MUXMEASUREMENT_CONFIG) {
+            } else if (ltc_state->substate == LTC_READ_I2C_TRANSMISSION_CHECK_MUXMEASUREMENT_CONFIG) {
 
-                if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                    ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                    ltc_state.substate = LTC_ENTRY;
-                    ltc_state.timer = 0;
+                    ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                    ltc_state->substate = LTC_ENTRY;
+                    ltc_state->timer = 0;
                     break;
                 } else {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                 }
 
-                if (LTC_RX_PECCheck(ltc_RXPECbuffer) != E_OK) {
+                if (LTC_RX_PECCheck(ltc_state, ltc_RXPECbuffer[ltc_state->instanceID]) != E_OK) {
                     DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_NOK, 0, NULL_PTR);
-                    ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                    ltc_state.substate = LTC_ENTRY;
-                    ltc_state.timer = 0;
+                    ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                    ltc_state->substate = LTC_ENTRY;
+                    ltc_state->timer = 0;
                 } else {
                     DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_OK, 0, NULL_PTR);
 
                     // if CRC OK: check multiplexer answer on i2C bus
-                    if (LTC_I2CCheckACK(ltc_RXPECbuffer, ltc_state.muxmeas_seqptr->muxID) != E_OK) {
+                    if (LTC_I2CCheckACK(ltc_state, ltc_RXPECbuffer[ltc_state->instanceID], LTC_MuxCurrentStep(ltc_state)->muxID) != E_OK) {
                         DIAG_Handler(DIAG_CH_LTC_MUX, DIAG_EVENT_NOK, 0, NULL_PTR);
-                        ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                        ltc_state.substate = LTC_ENTRY;
+                        ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                        ltc_state->substate = LTC_ENTRY;
                     } else {
                         DIAG_Handler(DIAG_CH_LTC_MUX, DIAG_EVENT_OK, 0, NULL_PTR);
-                        ltc_state.substate = LTC_STATEMACH_MUXMEASUREMENT;
+                        ltc_state->substate = LTC_STATEMACH_MUXMEASUREMENT;
                     }
-                    ltc_state.timer = 0;
+                    ltc_state->timer = 0;
 
                 }
                 break;
 
-            } else if (ltc_state.substate == LTC_STATEMACH_MUXMEASUREMENT) {
+            } else if (ltc_state->substate == LTC_STATEMACH_MUXMEASUREMENT) {
 
-                if (ltc_state.muxmeas_seqptr->muxCh == 0xFF) {
+                if (LTC_MuxCurrentStep(ltc_state)->muxCh == 0xFF) {
                     // actual multiplexer is switched off, so do not make a measurement and follow up with next step (mux configuration)
-                    ++ltc_state.muxmeas_seqptr;         // go further with next step of sequence
-                                                        // ltc_state.numberOfMeasuredMux not decremented, this does not count as a measurement */
-                    ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                    ltc_state.substate = LTC_ENTRY;
-                    ltc_state.timer = 0;
+                    LTC_MuxStepDone(ltc_state);                  // go further with next step of sequence
+                                                        // ltc_state->numberOfMeasuredMux not decremented, this does not count as a measurement */
+                    ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                    ltc_state->substate = LTC_ENTRY;
+                    ltc_state->timer = 0;
                     break;
                 } else {
 
                     if (LTC_GOTO_MUX_CHECK == FALSE) {
-                        if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                        if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                            ltc_state.substate = LTC_ENTRY;
-                            ltc_state.timer = 0;
+                            ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                            ltc_state->substate = LTC_ENTRY;
+                            ltc_state->timer = 0;
                             break;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                         }
                     }
 
-                    ltc_state.check_spi_flag = FALSE;
+                    ltc_state->check_spi_flag = FALSE;
                     // user multiplexer type -> connected to GPIO2!
-                    if (ltc_state.muxmeas_seqptr->muxID == 1 || ltc_state.muxmeas_seqptr->muxID == 2) {
-                        retVal = LTC_StartGPIOMeasurement(ltc_state.adcMode, LTC_ADCMEAS_SINGLECHANNEL_GPIO2);
+                    if (LTC_MuxCurrentStep(ltc_state)->muxID == 1 || LTC_MuxCurrentStep(ltc_state)->muxID == 2) {
+                        retVal = LTC_StartGPIOMeasurement(ltc_state, ltc_state->adcMode, LTC_ADCMEAS_SINGLECHANNEL_GPIO2);
                     } else {
-                        retVal = LTC_StartGPIOMeasurement(ltc_state.adcMode, LTC_ADCMEAS_SINGLECHANNEL_GPIO1);
+                        retVal = LTC_StartGPIOMeasurement(ltc_state, ltc_state->adcMode, LTC_ADCMEAS_SINGLECHANNEL_GPIO1);
                     }
                 }
                 if (retVal != E_OK) {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                    ltc_state.timer = 0;
+                    ltc_state->timer = 0;
                 } else {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                    ltc_state.timer = ltc_state.commandTransferTime + LTC_Get_MeasurementTCycle(ltc_state.adcMode, ltc_state.adcMeasCh);  // wait, ADAX-Command
+                    ltc_state->timer = ltc_state->commandTransferTime + LTC_Get_MeasurementTCycle(ltc_state->adcMode, ltc_state->adcMeasCh);  // wait, ADAX-Command
                 }
 
-                ltc_state.substate = LTC_STATEMACH_READMUXMEASUREMENT;
+                ltc_state->substate = LTC_STATEMACH_READMUXMEASUREMENT;
 
                 break;
 
-            } else if (ltc_state.substate == LTC_STATEMACH_READMUXMEASUREMENT) {
+            } else if (ltc_state->substate == LTC_STATEMACH_READMUXMEASUREMENT) {
 
-                ltc_state.check_spi_flag = TRUE;
+                ltc_state->check_spi_flag = TRUE;
 
-                SPI_SetTransmitOngoing();
-                retVal = LTC_RX((uint8_t*)(ltc_cmdRDAUXA), ltc_RXPECbuffer);
+                SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                retVal = LTC_RX(ltc_state, (uint8_t*)(ltc_cmdRDAUXA), ltc_RXPECbuffer[ltc_state->instanceID]);
                 if (retVal != E_OK) {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                    ltc_state.timer = 0;
+                    ltc_state->timer = 0;
                 } else {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                    ltc_state.timer = ltc_state.commandDataTransferTime+10;
+                    ltc_state->timer = ltc_state->commandDataTransferTime+10;
                 }
-                    ltc_state.substate = LTC_STATEMACH_STOREMUXMEASUREMENT;
+                    ltc_state->substate = LTC_STATEMACH_STOREMUXMEASUREMENT;
 
                 break;
 
-            } else if (ltc_state.substate == LTC_STATEMACH_STOREMUXMEASUREMENT) {
+            } else if (ltc_state->substate == LTC_STATEMACH_STOREMUXMEASUREMENT) {
 
-                if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                    ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                    ltc_state.substate = LTC_ENTRY;
-                    ltc_state.timer = 0;
+                    ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                    ltc_state->substate = LTC_ENTRY;
+                    ltc_state->timer = 0;
                     break;
                 } else {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                 }
 
-                if (LTC_RX_PECCheck(ltc_RXPECbuffer) != E_OK) {
+                if (LTC_RX_PECCheck(ltc_state, ltc_RXPECbuffer[ltc_state->instanceID]) != E_OK) {
                     DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_NOK, 0, NULL_PTR);
                 } else {
                     DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_OK, 0, NULL_PTR);
-                    LTC_SaveMuxMeasurement(ltc_RXPECbuffer, ltc_state.muxmeas_seqptr);
+                    LTC_SaveMuxMeasurement(ltc_state, ltc_RXPECbuffer[ltc_state->instanceID], LTC_MuxCurrentStep(ltc_state));
                 }
 
-                ++ltc_state.muxmeas_seqptr;
+                if (ltc_mux_extrastep[ltc_state->instanceID] != NULL_PTR) {
+                    // publish the additional read right away, the sequence publishes once per pass
+                    ltc_celltemperature.previous_timestamp = ltc_celltemperature.timestamp;
+                    ltc_celltemperature.timestamp = MCU_GetTimeStamp();
+                    LTC_SaveTemperatures();
+                }
+                LTC_MuxStepDone(ltc_state);
 
-                ltc_state.timer = 0;
-                if (ltc_state.balance_control_done == TRUE) {
-                    statereq = LTC_TransferStateRequest(&tmpbusID, &tmpadcMode, &tmpadcMeasCh);
+                ltc_state->timer = 0;
+                if (ltc_state->balance_control_done == TRUE) {
+                    statereq = LTC_TransferStateRequest(ltc_state, &tmpbusID, &tmpadcMode, &tmpadcMeasCh);
                     if (statereq == LTC_STATE_USER_IO_WRITE_REQUEST) {
-                        ltc_state.state = LTC_STATEMACH_USER_IO_CONTROL;
-                        ltc_state.substate = LTC_USER_IO_SET_OUTPUT_REGISTER;
-                        ltc_state.balance_control_done = FALSE;
+                        ltc_state->state = LTC_STATEMACH_USER_IO_CONTROL;
+                        ltc_state->substate = LTC_USER_IO_SET_OUTPUT_REGISTER;
+                        ltc_state->balance_control_done = FALSE;
                     } else if (statereq == LTC_STATE_USER_IO_READ_REQUEST) {
-                        ltc_state.state = LTC_STATEMACH_USER_IO_FEEDBACK;
-                        ltc_state.substate = LTC_USER_IO_READ_INPUT_REGISTER;
-                        ltc_state.balance_control_done = FALSE;
+                        ltc_state->state = LTC_STATEMACH_USER_IO_FEEDBACK;
+                        ltc_state->substate = LTC_USER_IO_READ_INPUT_REGISTER;
+                        ltc_state->balance_control_done = FALSE;
                     } else if (statereq == LTC_STATE_EEPROM_READ_REQUEST) {
-                        ltc_state.state = LTC_STATEMACH_EEPROM_READ;
-                        ltc_state.substate = LTC_EEPROM_READ_DATA1;
-                        ltc_state.balance_control_done = FALSE;
+                        ltc_state->state = LTC_STATEMACH_EEPROM_READ;
+                        ltc_state->substate = LTC_EEPROM_READ_DATA1;
+                        ltc_state->balance_control_done = FALSE;
                     } else if (statereq == LTC_STATE_EEPROM_WRITE_REQUEST) {
-                        ltc_state.state = LTC_STATEMACH_EEPROM_WRITE;
-                        ltc_state.substate = LTC_EEPROM_WRITE_DATA1;
-                        ltc_state.balance_control_done = FALSE;
+                        ltc_state->state = LTC_STATEMACH_EEPROM_WRITE;
+                        ltc_state->substate = LTC_EEPROM_WRITE_DATA1;
+                        ltc_state->balance_control_done = FALSE;
                     } else if (statereq == LTC_STATE_TEMP_SENS_READ_REQUEST) {
-                        ltc_state.state = LTC_STATEMACH_TEMP_SENS_READ;
-                        ltc_state.substate = LTC_TEMP_SENS_SEND_DATA1;
-                        ltc_state.balance_control_done = FALSE;
+                        ltc_state->state = LTC_STATEMACH_TEMP_SENS_READ;
+                        ltc_state->substate = LTC_TEMP_SENS_SEND_DATA1;
+                        ltc_state->balance_control_done = FALSE;
                     } else if (statereq == LTC_STATEMACH_BALANCEFEEDBACK_REQUEST) {
-                        ltc_state.state = LTC_STATEMACH_BALANCEFEEDBACK;
-                        ltc_state.substate = LTC_ENTRY;
-                        ltc_state.balance_control_done = FALSE;
+                        ltc_state->state = LTC_STATEMACH_BALANCEFEEDBACK;
+                        ltc_state->substate = LTC_ENTRY;
+                        ltc_state->balance_control_done = FALSE;
                     } else {
-                        ltc_state.state = LTC_STATEMACH_BALANCECONTROL;
-                        ltc_state.substate = LTC_CONFIG_BALANCECONTROL;
-                        ltc_state.balance_control_done = TRUE;
+                        ltc_state->state = LTC_STATEMACH_BALANCECONTROL;
+                        ltc_state->substate = LTC_CONFIG_BALANCECONTROL;
+                        ltc_state->balance_control_done = TRUE;
                     }
                 } else {
-                    ltc_state.state = LTC_STATEMACH_BALANCECONTROL;
-                    ltc_state.substate = LTC_CONFIG_BALANCECONTROL;
-                    ltc_state.balance_control_done = TRUE;
+                    ltc_state->state = LTC_STATEMACH_BALANCECONTROL;
+                    ltc_state->substate = LTC_CONFIG_BALANCECONTROL;
+                    ltc_state->balance_control_done = TRUE;
                 }
 
                 break;
@@ -1166,67 +1403,67 @@ void LTC_Trigger(void) {
         /****************************BALANCE CONTROL*********************************/
         case LTC_STATEMACH_BALANCECONTROL:
 
-            if (ltc_state.substate == LTC_CONFIG_BALANCECONTROL) {
+            if (ltc_state->substate == LTC_CONFIG_BALANCECONTROL) {
 
-                SPI_SetTransmitOngoing();
-                retVal = LTC_BalanceControl(0);
+                SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                retVal = LTC_BalanceControl(ltc_state, 0);
                 if (retVal != E_OK) {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                    ltc_state.timer = 0;
+                    ltc_state->timer = 0;
                 } else {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                    ltc_state.timer = ltc_state.commandDataTransferTime;
+                    ltc_state->timer = ltc_state->commandDataTransferTime;
                 }
-                ltc_state.substate = LTC_CONFIG2_BALANCECONTROL;
+                ltc_state->substate = LTC_CONFIG2_BALANCECONTROL;
 
                 break;
 
-            } else if (ltc_state.substate == LTC_CONFIG2_BALANCECONTROL) {
+            } else if (ltc_state->substate == LTC_CONFIG2_BALANCECONTROL) {
 
-                if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                    ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                    ltc_state.substate = LTC_ENTRY;
-                    ltc_state.timer = 0;
+                    ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                    ltc_state->substate = LTC_ENTRY;
+                    ltc_state->timer = 0;
                     break;
                 } else {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                 }
 
                 if (BS_NR_OF_BAT_CELLS_PER_MODULE > 12) {
-                    SPI_SetTransmitOngoing();
-                    retVal = LTC_BalanceControl(1);
+                    SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                    retVal = LTC_BalanceControl(ltc_state, 1);
                     if (retVal != E_OK) {
                         DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                        ltc_state.timer = 0;
+                        ltc_state->timer = 0;
                     } else {
                         DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                        ltc_state.timer = ltc_state.commandDataTransferTime;
+                        ltc_state->timer = ltc_state->commandDataTransferTime;
                     }
-                    ltc_state.substate = LTC_CONFIG2_BALANCECONTROL_END;
+                    ltc_state->substate = LTC_CONFIG2_BALANCECONTROL_END;
                 } else {
-                    ltc_state.timer = 0;
-                    ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                    ltc_state.substate = LTC_ENTRY;
+                    ltc_state->timer = 0;
+                    ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                    ltc_state->substate = LTC_ENTRY;
                 }
 
                 break;
 
-            } else if (ltc_state.substate == LTC_CONFIG2_BALANCECONTROL_END) {
+            } else if (ltc_state->substate == LTC_CONFIG2_BALANCECONTROL_END) {
 
-                if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                    ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                    ltc_state.substate = LTC_ENTRY;
-                    ltc_state.timer = 0;
+                    ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                    ltc_state->substate = LTC_ENTRY;
+                    ltc_state->timer = 0;
                     break;
                 } else {
                     DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                 }
 
-                ltc_state.timer = 0;
-                ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                ltc_state.substate = LTC_ENTRY;
+                ltc_state->timer = 0;
+                ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                ltc_state->substate = LTC_ENTRY;
 
                 break;
             }
@@ -1235,59 +1472,59 @@ void LTC_Trigger(void) {
             /****************************BALANCE FEEDBACK*********************************/
             case LTC_STATEMACH_BALANCEFEEDBACK:
 
-                 if (ltc_state.substate == LTC_ENTRY) {
+                 if (ltc_state->substate == LTC_ENTRY) {
 
-                    ltc_state.adcMode = LTC_ADCMODE_NORMAL_DCP0;
-                    ltc_state.adcMeasCh = LTC_ADCMEAS_SINGLECHANNEL_GPIO3;
+                    ltc_state->adcMode = LTC_ADCMODE_NORMAL_DCP0;
+                    ltc_state->adcMeasCh = LTC_ADCMEAS_SINGLECHANNEL_GPIO3;
 
-                    ltc_state.check_spi_flag = FALSE;
-                    retVal = LTC_StartGPIOMeasurement(ltc_state.adcMode, ltc_state.adcMeasCh);
+                    ltc_state->check_spi_flag = FALSE;
+                    retVal = LTC_StartGPIOMeasurement(ltc_state, ltc_state->adcMode, ltc_state->adcMeasCh);
                     if (retVal != E_OK) {
                         DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                        ltc_state.timer = 0;
+                        ltc_state->timer = 0;
                     } else {
                         DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                        ltc_state.timer = ltc_state.commandDataTransferTime + LTC_Get_MeasurementTCycle(ltc_state.adcMode, ltc_state.adcMeasCh);;
+                        ltc_state->timer = ltc_state->commandDataTransferTime + LTC_Get_MeasurementTCycle(ltc_state->adcMode, ltc_state->adcMeasCh);;
                     }
-                    ltc_state.substate = LTC_READ_FEEDBACK_BALANCECONTROL;
+                    ltc_state->substate = LTC_READ_FEEDBACK_BALANCECONTROL;
                     break;
 
-                } else if (ltc_state.substate == LTC_READ_FEEDBACK_BALANCECONTROL) {
+                } else if (ltc_state->substate == LTC_READ_FEEDBACK_BALANCECONTROL) {
 
-                    ltc_state.check_spi_flag = TRUE;
-                    SPI_SetTransmitOngoing();
-                    retVal = LTC_RX((uint8_t*)ltc_cmdRDAUXA, ltc_RXPECbuffer);  // read AUXA register
+                    ltc_state->check_spi_flag = TRUE;
+                    SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                    retVal = LTC_RX(ltc_state, (uint8_t*)ltc_cmdRDAUXA, ltc_RXPECbuffer[ltc_state->instanceID]);  // read AUXA register
                     if (retVal != E_OK) {
                         DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                        ltc_state.timer = 0;
+                        ltc_state->timer = 0;
                     } else {
                         DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                        ltc_state.timer = ltc_state.commandDataTransferTime;
+                        ltc_state->timer = ltc_state->commandDataTransferTime;
                     }
-                    ltc_state.substate = LTC_SAVE_FEEDBACK_BALANCECONTROL;
+                    ltc_state->substate = LTC_SAVE_FEEDBACK_BALANCECONTROL;
 
-                } else if (ltc_state.substate == LTC_SAVE_FEEDBACK_BALANCECONTROL) {
+                } else if (ltc_state->substate == LTC_SAVE_FEEDBACK_BALANCECONTROL) {
 
-                    if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                    if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                         DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                        ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                        ltc_state.substate = LTC_ENTRY;
-                        ltc_state.timer = 0;
+                        ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                        ltc_state->substate = LTC_ENTRY;
+                        ltc_state->timer = 0;
                         break;
                     } else {
                         DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                     }
 
-                    if (LTC_RX_PECCheck(ltc_RXPECbuffer) != E_OK) {
+                    if (LTC_RX_PECCheck(ltc_state, ltc_RXPECbuffer[ltc_state->instanceID]) != E_OK) {
                         DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_NOK, 0, NULL_PTR);
                     } else {
                         DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_OK, 0, NULL_PTR);
-                        LTC_SaveBalancingFeedback(ltc_RXPECbuffer);
+                        LTC_SaveBalancingFeedback(ltc_state, ltc_RXPECbuffer[ltc_state->instanceID]);
                     }
 
-                    ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                    ltc_state.substate = LTC_ENTRY;
-                    ltc_state.timer = 0;
+                    ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                    ltc_state->substate = LTC_ENTRY;
+                    ltc_state->timer = 0;
 
                     break;
                 }
@@ -1297,155 +1534,155 @@ void LTC_Trigger(void) {
                 /****************************BOARD TEMPERATURE SENSOR*********************************/
                 case LTC_STATEMACH_TEMP_SENS_READ:
 
-                    if (ltc_state.substate == LTC_TEMP_SENS_SEND_DATA1) {
+                    if (ltc_state->substate == LTC_TEMP_SENS_SEND_DATA1) {
 
-                        ltc_state.check_spi_flag = TRUE;
-                        SPI_SetTransmitOngoing();
-                        retVal = LTC_Send_I2C_Command(ltc_TXBuffer, ltc_TXPECbuffer, (uint8_t*)ltc_I2CcmdTempSens0);
+                        ltc_state->check_spi_flag = TRUE;
+                        SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                        retVal = LTC_Send_I2C_Command(ltc_state, ltc_TXBuffer[ltc_state->instanceID], ltc_TXPECbuffer[ltc_state->instanceID], (uint8_t*)ltc_I2CcmdTempSens0);
 
                         if (retVal != E_OK) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ++ltc_state.muxmeas_seqptr;
-                            ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                            ltc_state.substate = LTC_ENTRY;
-                            ltc_state.timer = 0;
+                            ++ltc_state->muxmeas_seqptr;
+                            ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                            ltc_state->substate = LTC_ENTRY;
+                            ltc_state->timer = 0;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                            ltc_state.substate = LTC_TEMP_SENS_SEND_CLOCK_STCOMM1;
-                            ltc_state.timer = ltc_state.commandDataTransferTime+10;
+                            ltc_state->substate = LTC_TEMP_SENS_SEND_CLOCK_STCOMM1;
+                            ltc_state->timer = ltc_state->commandDataTransferTime+10;
                         }
 
                         break;
 
-                    } else if (ltc_state.substate == LTC_TEMP_SENS_SEND_CLOCK_STCOMM1) {
+                    } else if (ltc_state->substate == LTC_TEMP_SENS_SEND_CLOCK_STCOMM1) {
 
-                        if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                        if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                            ltc_state.substate = LTC_ENTRY;
-                            ltc_state.timer = 0;
+                            ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                            ltc_state->substate = LTC_ENTRY;
+                            ltc_state->timer = 0;
                             break;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                         }
 
-                        SPI_SetTransmitOngoing();
-                        retVal = LTC_I2CClock(ltc_TXBufferClock, ltc_TXPECBufferClock);
+                        SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                        retVal = LTC_I2CClock(ltc_state, ltc_TXBufferClock[ltc_state->instanceID], ltc_TXPECBufferClock[ltc_state->instanceID]);
                         if (retVal != E_OK) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.timer = 0;
+                            ltc_state->timer = 0;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                            ltc_state.timer = ltc_state.gpioClocksTransferTime+10;
+                            ltc_state->timer = ltc_state->gpioClocksTransferTime+10;
                         }
 
-                        ltc_state.substate = LTC_TEMP_SENS_READ_DATA1;
+                        ltc_state->substate = LTC_TEMP_SENS_READ_DATA1;
                         break;
 
-                    } else if (ltc_state.substate == LTC_TEMP_SENS_READ_DATA1) {
+                    } else if (ltc_state->substate == LTC_TEMP_SENS_READ_DATA1) {
 
-                        if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                        if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                            ltc_state.substate = LTC_ENTRY;
-                            ltc_state.timer = 0;
+                            ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                            ltc_state->substate = LTC_ENTRY;
+                            ltc_state->timer = 0;
                             break;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                         }
 
-                        SPI_SetTransmitOngoing();
-                        retVal = LTC_Send_I2C_Command(ltc_TXBuffer, ltc_TXPECbuffer, (uint8_t*)ltc_I2CcmdTempSens1);
+                        SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                        retVal = LTC_Send_I2C_Command(ltc_state, ltc_TXBuffer[ltc_state->instanceID], ltc_TXPECbuffer[ltc_state->instanceID], (uint8_t*)ltc_I2CcmdTempSens1);
 
                         if (retVal != E_OK) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ++ltc_state.muxmeas_seqptr;
-                            ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                            ltc_state.substate = LTC_ENTRY;
-                            ltc_state.timer = 0;
+                            ++ltc_state->muxmeas_seqptr;
+                            ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                            ltc_state->substate = LTC_ENTRY;
+                            ltc_state->timer = 0;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                            ltc_state.substate = LTC_TEMP_SENS_SEND_CLOCK_STCOMM2;
-                            ltc_state.timer = ltc_state.commandDataTransferTime+10;
+                            ltc_state->substate = LTC_TEMP_SENS_SEND_CLOCK_STCOMM2;
+                            ltc_state->timer = ltc_state->commandDataTransferTime+10;
                         }
 
                         break;
 
-                    } else if (ltc_state.substate == LTC_TEMP_SENS_SEND_CLOCK_STCOMM2) {
+                    } else if (ltc_state->substate == LTC_TEMP_SENS_SEND_CLOCK_STCOMM2) {
 
-                        if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                        if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                            ltc_state.substate = LTC_ENTRY;
-                            ltc_state.timer = 0;
+                            ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                            ltc_state->substate = LTC_ENTRY;
+                            ltc_state->timer = 0;
                             break;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                         }
 
-                        SPI_SetTransmitOngoing();
-                        retVal = LTC_I2CClock(ltc_TXBufferClock, ltc_TXPECBufferClock);
+                        SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                        retVal = LTC_I2CClock(ltc_state, ltc_TXBufferClock[ltc_state->instanceID], ltc_TXPECBufferClock[ltc_state->instanceID]);
                         if (retVal != E_OK) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.timer = 0;
+                            ltc_state->timer = 0;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                            ltc_state.timer = ltc_state.gpioClocksTransferTime+10;
+                            ltc_state->timer = ltc_state->gpioClocksTransferTime+10;
                         }
 
-                        ltc_state.substate = LTC_TEMP_SENS_READ_I2C_TRANSMISSION_RESULT_RDCOMM;
+                        ltc_state->substate = LTC_TEMP_SENS_READ_I2C_TRANSMISSION_RESULT_RDCOMM;
                         break;
 
 
 
-                    }  else if (ltc_state.substate == LTC_TEMP_SENS_READ_I2C_TRANSMISSION_RESULT_RDCOMM) {
+                    }  else if (ltc_state->substate == LTC_TEMP_SENS_READ_I2C_TRANSMISSION_RESULT_RDCOMM) {
 
-                        if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                        if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                            ltc_state.substate = LTC_ENTRY;
-                            ltc_state.timer = 0;
+                            ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                            ltc_state->substate = LTC_ENTRY;
+                            ltc_state->timer = 0;
                             break;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                         }
 
-                        SPI_SetTransmitOngoing();
-                        retVal = LTC_RX((uint8_t*)ltc_cmdRDCOMM, ltc_RXPECbuffer);
+                        SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                        retVal = LTC_RX(ltc_state, (uint8_t*)ltc_cmdRDCOMM, ltc_RXPECbuffer[ltc_state->instanceID]);
                         if (retVal != E_OK) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.timer = 0;
+                            ltc_state->timer = 0;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                            ltc_state.timer = ltc_state.commandDataTransferTime;
+                            ltc_state->timer = ltc_state->commandDataTransferTime;
                         }
 
-                        ltc_state.substate = LTC_TEMP_SENS_SAVE_TEMP;
+                        ltc_state->substate = LTC_TEMP_SENS_SAVE_TEMP;
 
                         break;
 
-                    } else if (ltc_state.substate == LTC_TEMP_SENS_SAVE_TEMP) {
+                    } else if (ltc_state->substate == LTC_TEMP_SENS_SAVE_TEMP) {
 
-                        if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                        if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                            ltc_state.substate = LTC_ENTRY;
-                            ltc_state.timer = 0;
+                            ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                            ltc_state->substate = LTC_ENTRY;
+                            ltc_state->timer = 0;
                             break;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                         }
 
-                        if (LTC_RX_PECCheck(ltc_RXPECbuffer) != E_OK) {
+                        if (LTC_RX_PECCheck(ltc_state, ltc_RXPECbuffer[ltc_state->instanceID]) != E_OK) {
                             DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_NOK, 0, NULL_PTR);
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_OK, 0, NULL_PTR);
-                            LTC_TempSensSaveTemp(ltc_RXPECbuffer);
+                            LTC_TempSensSaveTemp(ltc_state, ltc_RXPECbuffer[ltc_state->instanceID]);
                         }
 
-                        ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                        ltc_state.substate = LTC_ENTRY;
-                        ltc_state.timer = 0;
+                        ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                        ltc_state->substate = LTC_ENTRY;
+                        ltc_state->timer = 0;
 
                         break;
                     }
@@ -1455,50 +1692,50 @@ void LTC_Trigger(void) {
                 /****************************MULTIPLEXED MEASUREMENT CONFIGURATION***********/
                 case LTC_STATEMACH_USER_IO_CONTROL:
 
-                    if (ltc_state.substate == LTC_USER_IO_SET_OUTPUT_REGISTER) {
+                    if (ltc_state->substate == LTC_USER_IO_SET_OUTPUT_REGISTER) {
 
-                        ltc_state.check_spi_flag = TRUE;
-                        SPI_SetTransmitOngoing();
-                        retVal = LTC_SetPortExpander(ltc_TXBuffer, ltc_TXPECbuffer);
+                        ltc_state->check_spi_flag = TRUE;
+                        SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                        retVal = LTC_SetPortExpander(ltc_state, ltc_TXBuffer[ltc_state->instanceID], ltc_TXPECbuffer[ltc_state->instanceID]);
 
                         if (retVal != E_OK) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ++ltc_state.muxmeas_seqptr;
-                            ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                            ltc_state.substate = LTC_ENTRY;
-                            ltc_state.timer = 0;
+                            ++ltc_state->muxmeas_seqptr;
+                            ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                            ltc_state->substate = LTC_ENTRY;
+                            ltc_state->timer = 0;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                            ltc_state.substate = LTC_SEND_CLOCK_STCOMM_MUXMEASUREMENT_CONFIG;
-                            ltc_state.timer = ltc_state.commandDataTransferTime+10;
+                            ltc_state->substate = LTC_SEND_CLOCK_STCOMM_MUXMEASUREMENT_CONFIG;
+                            ltc_state->timer = ltc_state->commandDataTransferTime+10;
                         }
 
                         break;
 
-                    } else if (ltc_state.substate == LTC_SEND_CLOCK_STCOMM_MUXMEASUREMENT_CONFIG) {
+                    } else if (ltc_state->substate == LTC_SEND_CLOCK_STCOMM_MUXMEASUREMENT_CONFIG) {
 
-                        if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                        if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                            ltc_state.substate = LTC_ENTRY;
-                            ltc_state.timer = 0;
+                            ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                            ltc_state->substate = LTC_ENTRY;
+                            ltc_state->timer = 0;
                             break;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                         }
 
-                        ltc_state.check_spi_flag = FALSE;
-                        retVal = LTC_I2CClock(ltc_TXBufferClock, ltc_TXPECBufferClock);
+                        ltc_state->check_spi_flag = FALSE;
+                        retVal = LTC_I2CClock(ltc_state, ltc_TXBufferClock[ltc_state->instanceID], ltc_TXPECBufferClock[ltc_state->instanceID]);
                         if (retVal != E_OK) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.timer = 0;
+                            ltc_state->timer = 0;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                            ltc_state.timer = ltc_state.gpioClocksTransferTime;
+                            ltc_state->timer = ltc_state->gpioClocksTransferTime;
                         }
 
-                        ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                        ltc_state.substate = LTC_ENTRY;
+                        ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                        ltc_state->substate = LTC_ENTRY;
 
                         break;
                         }
@@ -1507,100 +1744,100 @@ void LTC_Trigger(void) {
             /****************************MULTIPLEXED MEASUREMENT CONFIGURATION***********/
             case LTC_STATEMACH_USER_IO_FEEDBACK:
 
-                if (ltc_state.substate == LTC_USER_IO_READ_INPUT_REGISTER) {
+                if (ltc_state->substate == LTC_USER_IO_READ_INPUT_REGISTER) {
 
-                    ltc_state.check_spi_flag = TRUE;
-                    SPI_SetTransmitOngoing();
-                    retVal = LTC_Send_I2C_Command(ltc_TXBuffer, ltc_TXPECbuffer, (uint8_t*)ltc_I2CcmdPortExpander1);
+                    ltc_state->check_spi_flag = TRUE;
+                    SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                    retVal = LTC_Send_I2C_Command(ltc_state, ltc_TXBuffer[ltc_state->instanceID], ltc_TXPECbuffer[ltc_state->instanceID], (uint8_t*)ltc_I2CcmdPortExpander1);
 
                     if (retVal != E_OK) {
                         DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                        ++ltc_state.muxmeas_seqptr;
-                        ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                        ltc_state.substate = LTC_ENTRY;
-                        ltc_state.timer = 0;
+                        ++ltc_state->muxmeas_seqptr;
+                        ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                        ltc_state->substate = LTC_ENTRY;
+                        ltc_state->timer = 0;
                     } else {
                         DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                        ltc_state.substate = LTC_USER_IO_SEND_CLOCK_STCOMM;
-                        ltc_state.timer = ltc_state.commandDataTransferTime+10;
+                        ltc_state->substate = LTC_USER_IO_SEND_CLOCK_STCOMM;
+                        ltc_state->timer = ltc_state->commandDataTransferTime+10;
                     }
 
                     break;
 
-                } else if (ltc_state.substate == LTC_USER_IO_SEND_CLOCK_STCOMM) {
+                } else if (ltc_state->substate == LTC_USER_IO_SEND_CLOCK_STCOMM) {
 
-                    if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                    if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                         DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                        ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                        ltc_state.substate = LTC_ENTRY;
-                        ltc_state.timer = 0;
+                        ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                        ltc_state->substate = LTC_ENTRY;
+                        ltc_state->timer = 0;
                         break;
                     } else {
                         DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                     }
 
-                    ltc_state.check_spi_flag = FALSE;
-                    retVal = LTC_I2CClock(ltc_TXBufferClock, ltc_TXPECBufferClock);
+                    ltc_state->check_spi_flag = FALSE;
+                    retVal = LTC_I2CClock(ltc_state, ltc_TXBufferClock[ltc_state->instanceID], ltc_TXPECBufferClock[ltc_state->instanceID]);
                     if (retVal != E_OK) {
                         DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                        ltc_state.timer = 0;
+                        ltc_state->timer = 0;
                     } else {
                         DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                        ltc_state.timer = ltc_state.gpioClocksTransferTime;
+                        ltc_state->timer = ltc_state->gpioClocksTransferTime;
                     }
 
-                    ltc_state.substate = LTC_USER_IO_READ_I2C_TRANSMISSION_RESULT_RDCOMM;
+                    ltc_state->substate = LTC_USER_IO_READ_I2C_TRANSMISSION_RESULT_RDCOMM;
 
                     break;
 
-                    } else if (ltc_state.substate == LTC_USER_IO_READ_I2C_TRANSMISSION_RESULT_RDCOMM) {
+                    } else if (ltc_state->substate == LTC_USER_IO_READ_I2C_TRANSMISSION_RESULT_RDCOMM) {
 
-                        if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                        if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                            ltc_state.substate = LTC_ENTRY;
-                            ltc_state.timer = 0;
+                            ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                            ltc_state->substate = LTC_ENTRY;
+                            ltc_state->timer = 0;
                             break;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                         }
 
-                        SPI_SetTransmitOngoing();
-                        retVal = LTC_RX((uint8_t*)ltc_cmdRDCOMM, ltc_RXPECbuffer);
+                        SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                        retVal = LTC_RX(ltc_state, (uint8_t*)ltc_cmdRDCOMM, ltc_RXPECbuffer[ltc_state->instanceID]);
                         if (retVal != E_OK) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.timer = 0;
+                            ltc_state->timer = 0;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                            ltc_state.timer = ltc_state.commandDataTransferTime;
+                            ltc_state->timer = ltc_state->commandDataTransferTime;
                         }
 
-                        ltc_state.substate = LTC_USER_IO_SAVE_DATA;
+                        ltc_state->substate = LTC_USER_IO_SAVE_DATA;
 
                         break;
 
-                    } else if (ltc_state.substate == LTC_USER_IO_SAVE_DATA) {
+                    } else if (ltc_state->substate == LTC_USER_IO_SAVE_DATA) {
 
-                        if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                        if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                            ltc_state.substate = LTC_ENTRY;
-                            ltc_state.timer = 0;
+                            ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                            ltc_state->substate = LTC_ENTRY;
+                            ltc_state->timer = 0;
                             break;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                         }
 
-                        if (LTC_RX_PECCheck(ltc_RXPECbuffer) != E_OK) {
+                        if (LTC_RX_PECCheck(ltc_state, ltc_RXPECbuffer[ltc_state->instanceID]) != E_OK) {
                             DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_NOK, 0, NULL_PTR);
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_OK, 0, NULL_PTR);
-                            LTC_PortExpanderSaveValues(ltc_RXPECbuffer);
+                            LTC_PortExpanderSaveValues(ltc_state, ltc_RXPECbuffer[ltc_state->instanceID]);
                         }
 
-                        ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                        ltc_state.substate = LTC_ENTRY;
-                        ltc_state.timer = 0;
+                        ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                        ltc_state->substate = LTC_ENTRY;
+                        ltc_state->timer = 0;
 
                         break;
                     }
@@ -1610,151 +1847,151 @@ void LTC_Trigger(void) {
                 /****************************EEPROM READ*********************************/
                 case LTC_STATEMACH_EEPROM_READ:
 
-                    if (ltc_state.substate == LTC_EEPROM_READ_DATA1) {
+                    if (ltc_state->substate == LTC_EEPROM_READ_DATA1) {
 
-                        ltc_state.check_spi_flag = TRUE;
-                        SPI_SetTransmitOngoing();
-                        retVal = LTC_SendEEPROMReadCommand(ltc_TXBuffer, ltc_TXPECbuffer, 0);
+                        ltc_state->check_spi_flag = TRUE;
+                        SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                        retVal = LTC_SendEEPROMReadCommand(ltc_state, ltc_TXBuffer[ltc_state->instanceID], ltc_TXPECbuffer[ltc_state->instanceID], 0);
 
                         if (retVal != E_OK) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ++ltc_state.muxmeas_seqptr;
-                            ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                            ltc_state.substate = LTC_ENTRY;
-                            ltc_state.timer = 0;
+                            ++ltc_state->muxmeas_seqptr;
+                            ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                            ltc_state->substate = LTC_ENTRY;
+                            ltc_state->timer = 0;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                            ltc_state.substate = LTC_EEPROM_SEND_CLOCK_STCOMM1;
-                            ltc_state.timer = ltc_state.commandDataTransferTime+10;
+                            ltc_state->substate = LTC_EEPROM_SEND_CLOCK_STCOMM1;
+                            ltc_state->timer = ltc_state->commandDataTransferTime+10;
                         }
 
                         break;
 
-                    } else if (ltc_state.substate == LTC_EEPROM_SEND_CLOCK_STCOMM1) {
+                    } else if (ltc_state->substate == LTC_EEPROM_SEND_CLOCK_STCOMM1) {
 
-                        if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                        if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                            ltc_state.substate = LTC_ENTRY;
-                            ltc_state.timer = 0;
+                            ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                            ltc_state->substate = LTC_ENTRY;
+                            ltc_state->timer = 0;
                             break;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                         }
 
-                        SPI_SetTransmitOngoing();
-                        retVal = LTC_I2CClock(ltc_TXBufferClock, ltc_TXPECBufferClock);
+                        SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                        retVal = LTC_I2CClock(ltc_state, ltc_TXBufferClock[ltc_state->instanceID], ltc_TXPECBufferClock[ltc_state->instanceID]);
                         if (retVal != E_OK) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.timer = 0;
+                            ltc_state->timer = 0;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                            ltc_state.timer = ltc_state.gpioClocksTransferTime+10;
+                            ltc_state->timer = ltc_state->gpioClocksTransferTime+10;
                         }
 
-                        ltc_state.substate = LTC_EEPROM_READ_DATA2;
+                        ltc_state->substate = LTC_EEPROM_READ_DATA2;
                         break;
 
-                    } else if (ltc_state.substate == LTC_EEPROM_READ_DATA2) {
+                    } else if (ltc_state->substate == LTC_EEPROM_READ_DATA2) {
 
-                        if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                        if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                            ltc_state.substate = LTC_ENTRY;
-                            ltc_state.timer = 0;
+                            ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                            ltc_state->substate = LTC_ENTRY;
+                            ltc_state->timer = 0;
                             break;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                         }
 
-                        SPI_SetTransmitOngoing();
-                        retVal = LTC_SendEEPROMReadCommand(ltc_TXBuffer, ltc_TXPECbuffer, 1);
+                        SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                        retVal = LTC_SendEEPROMReadCommand(ltc_state, ltc_TXBuffer[ltc_state->instanceID], ltc_TXPECbuffer[ltc_state->instanceID], 1);
 
                         if (retVal != E_OK) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.timer = 0;
+                            ltc_state->timer = 0;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                            ltc_state.timer = ltc_state.commandDataTransferTime+10;
+                            ltc_state->timer = ltc_state->commandDataTransferTime+10;
                         }
 
-                        ltc_state.substate = LTC_EEPROM_SEND_CLOCK_STCOMM2;
+                        ltc_state->substate = LTC_EEPROM_SEND_CLOCK_STCOMM2;
 
                         break;
 
-                    } else if (ltc_state.substate == LTC_EEPROM_SEND_CLOCK_STCOMM2) {
+                    } else if (ltc_state->substate == LTC_EEPROM_SEND_CLOCK_STCOMM2) {
 
-                        if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                        if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                            ltc_state.substate = LTC_ENTRY;
-                            ltc_state.timer = 0;
+                            ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                            ltc_state->substate = LTC_ENTRY;
+                            ltc_state->timer = 0;
                             break;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                         }
 
-                        SPI_SetTransmitOngoing();
-                        retVal = LTC_I2CClock(ltc_TXBufferClock, ltc_TXPECBufferClock);
+                        SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                        retVal = LTC_I2CClock(ltc_state, ltc_TXBufferClock[ltc_state->instanceID], ltc_TXPECBufferClock[ltc_state->instanceID]);
                         if (retVal != E_OK) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.timer = 0;
+                            ltc_state->timer = 0;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                            ltc_state.timer = ltc_state.gpioClocksTransferTime+10;
+                            ltc_state->timer = ltc_state->gpioClocksTransferTime+10;
                         }
 
-                        ltc_state.substate = LTC_EEPROM_READ_I2C_TRANSMISSION_RESULT_RDCOMM;
+                        ltc_state->substate = LTC_EEPROM_READ_I2C_TRANSMISSION_RESULT_RDCOMM;
                         break;
 
-                    }  else if (ltc_state.substate == LTC_EEPROM_READ_I2C_TRANSMISSION_RESULT_RDCOMM) {
+                    }  else if (ltc_state->substate == LTC_EEPROM_READ_I2C_TRANSMISSION_RESULT_RDCOMM) {
 
-                        if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                        if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                            ltc_state.substate = LTC_ENTRY;
-                            ltc_state.timer = 0;
+                            ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                            ltc_state->substate = LTC_ENTRY;
+                            ltc_state->timer = 0;
                             break;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                         }
 
-                        SPI_SetTransmitOngoing();
-                        retVal = LTC_RX((uint8_t*)ltc_cmdRDCOMM, ltc_RXPECbuffer);
+                        SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                        retVal = LTC_RX(ltc_state, (uint8_t*)ltc_cmdRDCOMM, ltc_RXPECbuffer[ltc_state->instanceID]);
                         if (retVal != E_OK) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.timer = 0;
+                            ltc_state->timer = 0;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                            ltc_state.timer = ltc_state.commandDataTransferTime+10;
+                            ltc_state->timer = ltc_state->commandDataTransferTime+10;
                         }
 
-                        ltc_state.substate = LTC_EEPROM_SAVE_READ;
+                        ltc_state->substate = LTC_EEPROM_SAVE_READ;
 
                         break;
 
-                    } else if (ltc_state.substate == LTC_EEPROM_SAVE_READ) {
+                    } else if (ltc_state->substate == LTC_EEPROM_SAVE_READ) {
 
-                        if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                        if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                            ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                            ltc_state.substate = LTC_ENTRY;
-                            ltc_state.timer = 0;
+                            ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                            ltc_state->substate = LTC_ENTRY;
+                            ltc_state->timer = 0;
                             break;
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                         }
 
-                        if (LTC_RX_PECCheck(ltc_RXPECbuffer) != E_OK) {
+                        if (LTC_RX_PECCheck(ltc_state, ltc_RXPECbuffer[ltc_state->instanceID]) != E_OK) {
                             DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_NOK, 0, NULL_PTR);
                         } else {
                             DIAG_Handler(DIAG_CH_LTC_PEC, DIAG_EVENT_OK, 0, NULL_PTR);
-                            LTC_EEPROMSaveReadValue(ltc_RXPECbuffer);
+                            LTC_EEPROMSaveReadValue(ltc_state, ltc_RXPECbuffer[ltc_state->instanceID]);
                         }
 
-                        ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                        ltc_state.substate = LTC_ENTRY;
-                        ltc_state.timer = 0;
+                        ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                        ltc_state->substate = LTC_ENTRY;
+                        ltc_state->timer = 0;
 
                         break;
 
@@ -1765,118 +2002,118 @@ void LTC_Trigger(void) {
                     /****************************EEPROM READ*********************************/
                     case LTC_STATEMACH_EEPROM_WRITE:
 
-                        if (ltc_state.substate == LTC_EEPROM_WRITE_DATA1) {
+                        if (ltc_state->substate == LTC_EEPROM_WRITE_DATA1) {
 
-                            ltc_state.check_spi_flag = TRUE;
-                            SPI_SetTransmitOngoing();
-                            retVal = LTC_SendEEPROMWriteCommand(ltc_TXBuffer, ltc_TXPECbuffer, 0);
+                            ltc_state->check_spi_flag = TRUE;
+                            SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                            retVal = LTC_SendEEPROMWriteCommand(ltc_state, ltc_TXBuffer[ltc_state->instanceID], ltc_TXPECbuffer[ltc_state->instanceID], 0);
 
                             if (retVal != E_OK) {
                                 DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                                ++ltc_state.muxmeas_seqptr;
-                                ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                                ltc_state.substate = LTC_ENTRY;
-                                ltc_state.timer = 0;
+                                ++ltc_state->muxmeas_seqptr;
+                                ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                                ltc_state->substate = LTC_ENTRY;
+                                ltc_state->timer = 0;
                             } else {
                                 DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                                ltc_state.substate = LTC_EEPROM_SEND_CLOCK_STCOMM3;
-                                ltc_state.timer = ltc_state.commandDataTransferTime+10;
+                                ltc_state->substate = LTC_EEPROM_SEND_CLOCK_STCOMM3;
+                                ltc_state->timer = ltc_state->commandDataTransferTime+10;
                             }
 
                             break;
 
-                        } else if (ltc_state.substate == LTC_EEPROM_SEND_CLOCK_STCOMM3) {
+                        } else if (ltc_state->substate == LTC_EEPROM_SEND_CLOCK_STCOMM3) {
 
-                            if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                            if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                                 DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                                ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                                ltc_state.substate = LTC_ENTRY;
-                                ltc_state.timer = 0;
+                                ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                                ltc_state->substate = LTC_ENTRY;
+                                ltc_state->timer = 0;
                                 break;
                             } else {
                                 DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                             }
 
-                            SPI_SetTransmitOngoing();
-                            retVal = LTC_I2CClock(ltc_TXBufferClock, ltc_TXPECBufferClock);
+                            SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                            retVal = LTC_I2CClock(ltc_state, ltc_TXBufferClock[ltc_state->instanceID], ltc_TXPECBufferClock[ltc_state->instanceID]);
                             if (retVal != E_OK) {
                                 DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                                ltc_state.timer = 0;
+                                ltc_state->timer = 0;
                             } else {
                                 DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                                ltc_state.timer = ltc_state.gpioClocksTransferTime+10;
+                                ltc_state->timer = ltc_state->gpioClocksTransferTime+10;
                             }
 
-                            ltc_state.substate = LTC_EEPROM_WRITE_DATA2;
+                            ltc_state->substate = LTC_EEPROM_WRITE_DATA2;
                             break;
 
-                        } else if (ltc_state.substate == LTC_EEPROM_WRITE_DATA2) {
+                        } else if (ltc_state->substate == LTC_EEPROM_WRITE_DATA2) {
 
-                            if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                            if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                                 DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                                ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                                ltc_state.substate = LTC_ENTRY;
-                                ltc_state.timer = 0;
+                                ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                                ltc_state->substate = LTC_ENTRY;
+                                ltc_state->timer = 0;
                                 break;
                             } else {
                                 DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                             }
 
-                            SPI_SetTransmitOngoing();
-                            retVal = LTC_SendEEPROMWriteCommand(ltc_TXBuffer, ltc_TXPECbuffer, 1);
+                            SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                            retVal = LTC_SendEEPROMWriteCommand(ltc_state, ltc_TXBuffer[ltc_state->instanceID], ltc_TXPECbuffer[ltc_state->instanceID], 1);
 
                             if (retVal != E_OK) {
                                 DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                                ltc_state.timer = 0;
+                                ltc_state->timer = 0;
                             } else {
                                 DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                                ltc_state.timer = ltc_state.commandDataTransferTime+10;
+                                ltc_state->timer = ltc_state->commandDataTransferTime+10;
                             }
 
-                            ltc_state.substate = LTC_EEPROM_SEND_CLOCK_STCOMM4;
+                            ltc_state->substate = LTC_EEPROM_SEND_CLOCK_STCOMM4;
 
                             break;
 
-                        } else if (ltc_state.substate == LTC_EEPROM_SEND_CLOCK_STCOMM4) {
+                        } else if (ltc_state->substate == LTC_EEPROM_SEND_CLOCK_STCOMM4) {
 
-                            if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                            if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                                 DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                                ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                                ltc_state.substate = LTC_ENTRY;
-                                ltc_state.timer = 0;
+                                ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                                ltc_state->substate = LTC_ENTRY;
+                                ltc_state->timer = 0;
                                 break;
                             } else {
                                 DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                             }
 
-                            SPI_SetTransmitOngoing();
-                            retVal = LTC_I2CClock(ltc_TXBufferClock, ltc_TXPECBufferClock);
+                            SPI_SetDeviceTransmitOngoing(ltc_state->spiHandle);
+                            retVal = LTC_I2CClock(ltc_state, ltc_TXBufferClock[ltc_state->instanceID], ltc_TXPECBufferClock[ltc_state->instanceID]);
                             if (retVal != E_OK) {
                                 DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                                ltc_state.timer = 0;
+                                ltc_state->timer = 0;
                             } else {
                                 DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
-                                ltc_state.timer = ltc_state.gpioClocksTransferTime+10;
+                                ltc_state->timer = ltc_state->gpioClocksTransferTime+10;
                             }
 
-                            ltc_state.substate = LTC_EEPROM_FINISHED;
+                            ltc_state->substate = LTC_EEPROM_FINISHED;
                             break;
 
-                        }  else if (ltc_state.substate == LTC_EEPROM_FINISHED) {
+                        }  else if (ltc_state->substate == LTC_EEPROM_FINISHED) {
 
-                            if (ltc_state.timer == 0 && SPI_IsTransmitOngoing() == TRUE) {
+                            if (ltc_state->timer == 0 && SPI_IsDeviceTransmitOngoing(ltc_state->spiHandle) == TRUE) {
                                 DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_NOK, 0, NULL_PTR);
-                                ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                                ltc_state.substate = LTC_ENTRY;
-                                ltc_state.timer = 0;
+                                ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                                ltc_state->substate = LTC_ENTRY;
+                                ltc_state->timer = 0;
                                 break;
                             } else {
                                 DIAG_Handler(DIAG_CH_LTC_SPI, DIAG_EVENT_OK, 0, NULL_PTR);
                             }
 
-                            ltc_state.state = LTC_STATEMACH_STARTMEAS;
-                            ltc_state.substate = LTC_ENTRY;
-                            ltc_state.timer = 0;
+                            ltc_state->state = LTC_STATEMACH_STARTMEAS;
+                            ltc_state->substate = LTC_ENTRY;
+                            ltc_state->timer = 0;
 
                             break;
 
@@ -1889,7 +2126,64 @@ void LTC_Trigger(void) {
             break;
     }
 
-    ltc_state.triggerentry--;        // reentrance counter
+    // the state set ltc_state->timer to the time in ms it needs before the next state is processed
+    if (ltc_state->timer == 0) {
+        ltc_state->timer = 1;
+    }
+    if (earlyStep == TRUE) {
+        // the state was processed between two ticks, so one tick more guarantees the full wait time
+        ltc_state->timer++;
+    }
+    ltc_state->nextStepTime = stepTime + ltc_state->timer;
+
+    ltc_state->triggerentry--;        // reentrance counter
+}
+
+
+uint32_t LTC_GetTimeToNextStep(void) {
+
+    int32_t remainingTime = 0;
+    int32_t chainTime = 0;
+    uint32_t now = MCU_GetTimeStamp();
+    uint8_t i = 0;
+
+    // the daisy-chain with the nearest deadline determines when LTC_Trigger() has to be called
+    remainingTime = (int32_t)(ltc_states[0].nextStepTime - now);
+    for (i=1; i < LTC_NR_OF_CHAINS; i++) {
+        chainTime = (int32_t)(ltc_states[i].nextStepTime - now);
+        if (chainTime < remainingTime) {
+            remainingTime = chainTime;
+        }
+    }
+
+    return (remainingTime > 0) ? (uint32_t)remainingTime : 0;
+}
+
+
+/**
+ * @brief   marks the measurement of a daisy-chain as saved and decides if the results are published.
+ *
+ * The daisy-chains save their measurements in the same data blocks. These are published
+ * once every daisy-chain saved its measurement. If a daisy-chain saves a second measurement
+ * before, e.g. because another daisy-chain does not answer, they are published anyway
+ * with the last values of the other daisy-chains.
+ *
+ * @param   *chainsdone     daisy-chains that saved their measurement since the last publication
+ * @param   instanceID      daisy-chain that saved its measurement
+ *
+ * @return  TRUE if the data blocks have to be published, FALSE otherwise
+ */
+static uint8_t LTC_ChainDone(uint8_t *chainsdone, uint8_t instanceID) {
+
+    uint8_t chain = (uint8_t)(1u << instanceID);
+
+    if (((*chainsdone & chain) != 0) || ((*chainsdone | chain) == LTC_ALL_CHAINS_MASK)) {
+        *chainsdone = 0;
+        return TRUE;
+    }
+    *chainsdone |= chain;
+
+    return FALSE;
 }
 
 
@@ -1906,11 +2200,17 @@ void LTC_Trigger(void) {
  *
  * @return  void
  */
-static void LTC_SaveMuxMeasurement(uint8_t *rxBuffer, LTC_MUX_CH_CFG_s  *muxseqptr) {   // pointer to measurement Sequence of Mux- and Channel-Configurations (1,0xFF)...(3,0xFF),(0,1),...(0,7))
+static void LTC_SaveMuxMeasurement(LTC_STATE_s *ltc_state, uint8_t *rxBuffer, LTC_MUX_CH_CFG_s  *muxseqptr) {   // pointer to measurement Sequence of Mux- and Channel-Configurations (1,0xFF)...(3,0xFF),(0,1),...(0,7))
 
     uint16_t i = 0;
     uint16_t val_ui = 0;
-    uint16_t temperature = 0;
+    int16_t temperature = 0;
+    int16_t decitemperature = 0;
+    int16_t mintemperature = 0;
+    int16_t maxtemperature = 0;
+    uint16_t delta = 0;
+    uint16_t maxdelta = 0;
+    uint16_t temp_idx = 0;
     uint8_t sensor_idx = 0;
     uint8_t ch_idx = 0;
 
@@ -1927,21 +2227,177 @@ static void LTC_SaveMuxMeasurement(uint8_t *rxBuffer, LTC_MUX_CH_CFG_s  *muxseqp
 
             if (ch_idx < 2*8) {
                 val_ui =*((uint16_t *)(&rxBuffer[6+1*i*8]));        // raw values, all mux on all LTCs
-                ltc_user_mux.value[i*8*2+ch_idx] = (uint16_t)(((float)(val_ui))*100e-6*1000.0);  // Unit -> in V -> in mV
+                ltc_user_mux.value[(LTC_MODULE_OFFSET(ltc_state)+i)*8*2+ch_idx] = LTC_CONVERT_RAW_TO_MV(val_ui);  // Unit -> in mV
             }
         }
     } else {
         // temperature multiplexer type -> connected to GPIO1!
         for (i=0; i < LTC_N_LTC; i++) {
             val_ui = *((uint16_t *)(&rxBuffer[4+i*8]));
-            temperature = LTC_Convert_MuxVoltages_to_Temperatures( (uint16_t)(((float)(val_ui))*100e-3) );        // Unit Celsius
+            decitemperature = LTC_NTC_RawToDeciCelsius(val_ui);
+            temperature = LTC_NTC_DECICELSIUS_TO_CELSIUS(decitemperature);        // Unit Celsius
             sensor_idx = ltc_muxsensortemperatur_cfg[muxseqptr->muxCh];
             // if wrong configuration: exit and write nothing
             if (sensor_idx >= BS_NR_OF_TEMP_SENSORS_PER_MODULE)
                 return;
-            ltc_celltemperature.temperature[i*(BS_NR_OF_TEMP_SENSORS_PER_MODULE)+sensor_idx] = temperature;
+            temp_idx = (LTC_MODULE_OFFSET(ltc_state)+i)*(BS_NR_OF_TEMP_SENSORS_PER_MODULE)+sensor_idx;
+            ltc_celltemperature.temperature[temp_idx] = temperature;
+
+            delta = (decitemperature > ltc_mux_temperature[temp_idx]) ? decitemperature - ltc_mux_temperature[temp_idx] : ltc_mux_temperature[temp_idx] - decitemperature;
+            ltc_mux_temperature[temp_idx] = decitemperature;
+            if (i == 0) {
+                maxdelta = delta;
+                mintemperature = maxtemperature = decitemperature;
+            } else {
+                if (delta > maxdelta)
+                    maxdelta = delta;
+                if (decitemperature < mintemperature)
+                    mintemperature = decitemperature;
+                if (decitemperature > maxtemperature)
+                    maxtemperature = decitemperature;
+            }
+        }
+        LTC_MuxUpdateWeight(ltc_state, muxseqptr, maxdelta, mintemperature, maxtemperature);
+    }
+}
+
+
+/**
+ * @brief   returns the multiplexer step that is currently measured.
+ *
+ * This is either the additional read of a temperature step selected by the adaptive
+ * scheduling or the current step of the multiplexer sequence.
+ *
+ * @return  pointer to the current multiplexer step
+ */
+static LTC_MUX_CH_CFG_s *LTC_MuxCurrentStep(LTC_STATE_s *ltc_state) {
+    if (ltc_mux_extrastep[ltc_state->instanceID] != NULL_PTR) {
+        return ltc_mux_extrastep[ltc_state->instanceID];
+    }
+    return ltc_state->muxmeas_seqptr;
+}
+
+
+/**
+ * @brief   finishes the current multiplexer step and selects the next one.
+ *
+ * After a step of the sequence, each temperature step gets its weight as credit. The
+ * temperature step of the same multiplexer with the highest credit of at least
+ * LTC_MUX_ADAPTIVE_CREDIT is read once more before the sequence continues. Only one
+ * additional read follows a step of the sequence, so a pass of the sequence takes at
+ * most twice as many steps, while the number of conversions per second is unchanged.
+ * Steps of the user multiplexers and steps that switch off a multiplexer are never
+ * read additionally.
+ *
+ * @return  void
+ */
+static void LTC_MuxStepDone(LTC_STATE_s *ltc_state) {
+    LTC_MUX_CH_CFG_s *done = ltc_state->muxmeas_seqptr;
+    uint8_t nr_of_steps = ltc_mux_seq.nr_of_steps;
+    uint8_t done_idx = 0;
+    uint8_t extra_idx = 0xFF;
+    uint8_t k = 0;
+
+    if (ltc_mux_extrastep[ltc_state->instanceID] != NULL_PTR) {
+        ltc_mux_extrastep[ltc_state->instanceID] = NULL_PTR;
+        return;
+    }
+    ++ltc_state->muxmeas_seqptr;
+
+    if (LTC_MUX_ADAPTIVE == FALSE) {
+        return;
+    }
+
+    done_idx = done - ltc_mux_seq.seqptr;
+    if (nr_of_steps > LTC_MUX_ADAPTIVE_MAX_STEPS) {
+        nr_of_steps = LTC_MUX_ADAPTIVE_MAX_STEPS;
+    }
+
+    for (k=0; k < nr_of_steps; k++) {
+        if (ltc_mux_adaptive[ltc_state->instanceID][k].credit <= 0xFF - ltc_mux_adaptive[ltc_state->instanceID][k].weight) {
+            ltc_mux_adaptive[ltc_state->instanceID][k].credit += ltc_mux_adaptive[ltc_state->instanceID][k].weight;
+        } else {
+            ltc_mux_adaptive[ltc_state->instanceID][k].credit = 0xFF;
         }
     }
+
+    // only a temperature multiplexer that is switched on can be read again
+    if ((done->muxCh == 0xFF) || (done->muxID == 1) || (done->muxID == 2)) {
+        return;
+    }
+
+    for (k=0; k < nr_of_steps; k++) {
+        if ((k != done_idx) && (ltc_mux_seq.seqptr[k].muxID == done->muxID) && (ltc_mux_seq.seqptr[k].muxCh != 0xFF) &&
+                (ltc_mux_adaptive[ltc_state->instanceID][k].credit >= LTC_MUX_ADAPTIVE_CREDIT)) {
+            if ((extra_idx == 0xFF) || (ltc_mux_adaptive[ltc_state->instanceID][k].credit > ltc_mux_adaptive[ltc_state->instanceID][extra_idx].credit)) {
+                extra_idx = k;
+            }
+        }
+    }
+
+    if (extra_idx != 0xFF) {
+        ltc_mux_extrastep[ltc_state->instanceID] = &ltc_mux_seq.seqptr[extra_idx];
+    }
+}
+
+
+/**
+ * @brief   resets the adaptive scheduling of the multiplexer sequence.
+ *
+ * @return  void
+ */
+static void LTC_MuxResetAdaptive(LTC_STATE_s *ltc_state) {
+    uint16_t i = 0;
+
+    for (i=0; i < LTC_MUX_ADAPTIVE_MAX_STEPS; i++) {
+        ltc_mux_adaptive[ltc_state->instanceID][i].weight = 0;
+        ltc_mux_adaptive[ltc_state->instanceID][i].credit = 0;
+        ltc_mux_adaptive[ltc_state->instanceID][i].timestamp = 0;
+    }
+    ltc_mux_extrastep[ltc_state->instanceID] = NULL_PTR;
+}
+
+
+/**
+ * @brief   updates the weight of a temperature step after it was read.
+ *
+ * The weight grows with the rate of change of the temperatures read by the step and with
+ * the distance of the temperatures beyond LTC_MUX_ADAPTIVE_TEMP_HIGH or below
+ * LTC_MUX_ADAPTIVE_TEMP_LOW. The credit of the step is reset, since it was just read.
+ *
+ * @param   muxseqptr       step of the multiplexer sequence that was read
+ * @param   maxdelta        largest change of a temperature since the last read in 0.1 degC
+ * @param   mintemperature  lowest temperature read by the step in 0.1 degC
+ * @param   maxtemperature  highest temperature read by the step in 0.1 degC
+ *
+ * @return  void
+ */
+static void LTC_MuxUpdateWeight(LTC_STATE_s *ltc_state, LTC_MUX_CH_CFG_s *muxseqptr, uint16_t maxdelta, int16_t mintemperature, int16_t maxtemperature) {
+    uint32_t idx = muxseqptr - ltc_mux_seq.seqptr;
+    uint32_t now = MCU_GetTimeStamp();
+    uint32_t weight = 0;
+
+    if (idx >= LTC_MUX_ADAPTIVE_MAX_STEPS) {
+        return;
+    }
+
+    if ((ltc_mux_adaptive[ltc_state->instanceID][idx].timestamp != 0) && (now != ltc_mux_adaptive[ltc_state->instanceID][idx].timestamp)) {
+        // rate of change in 0.1 degC/s
+        weight = ((uint32_t)maxdelta*1000)/(now - ltc_mux_adaptive[ltc_state->instanceID][idx].timestamp)/LTC_MUX_ADAPTIVE_RATE_PER_WEIGHT;
+    }
+    if (maxtemperature > LTC_MUX_ADAPTIVE_TEMP_HIGH) {
+        weight += (maxtemperature - LTC_MUX_ADAPTIVE_TEMP_HIGH)/LTC_MUX_ADAPTIVE_TEMP_PER_WEIGHT;
+    }
+    if (mintemperature < LTC_MUX_ADAPTIVE_TEMP_LOW) {
+        weight += (LTC_MUX_ADAPTIVE_TEMP_LOW - mintemperature)/LTC_MUX_ADAPTIVE_TEMP_PER_WEIGHT;
+    }
+    if (weight > LTC_MUX_ADAPTIVE_MAX_WEIGHT) {
+        weight = LTC_MUX_ADAPTIVE_MAX_WEIGHT;
+    }
+
+    ltc_mux_adaptive[ltc_state->instanceID][idx].weight = weight;
+    ltc_mux_adaptive[ltc_state->instanceID][idx].credit = 0;
+    ltc_mux_adaptive[ltc_state->instanceID][idx].timestamp = (now != 0) ? now : 1;
 }
 
 
@@ -1954,6 +2410,8 @@ static void LTC_SaveMuxMeasurement(uint8_t *rxBuffer, LTC_MUX_CH_CFG_s  *muxseqp
  * There are 6 register to read _(A,B,C,D,E,F) to get all cell voltages.
  * Only one register can be read at a time.
  * This function is called to store the result from the transmission in a buffer.
+ * The voltages are added to the statistics evaluated by LTC_SaveVoltages(), so the
+ * cell voltages do not have to be traversed again once all groups are saved.
  *
  * @param   registerSet    voltage register that was read (voltage register A,B,C,D,E or F)
  * @param   *rxBuffer      buffer containing the data obtained from the SPI transmission
@@ -1961,15 +2419,17 @@ static void LTC_SaveMuxMeasurement(uint8_t *rxBuffer, LTC_MUX_CH_CFG_s  *muxseqp
  * @return  void
  *
  */
-static void LTC_SaveRXtoVoltagebuffer(uint8_t registerSet, uint8_t *rxBuffer) {
+static void LTC_SaveRXtoVoltagebuffer(LTC_STATE_s *ltc_state, uint8_t registerSet, uint8_t *rxBuffer) {
 
     uint16_t i = 0;
     uint16_t j = 0;
     uint16_t i_offset = 0;
     uint16_t voltage_index = 0;
+    uint16_t cell_index = 0;
+    uint16_t first_cell = 0;
+    uint16_t module_cell = 0;
     uint16_t val_ui = 0;
     uint16_t voltage = 0;
-    uint8_t incrementations = 0;
 
     if (registerSet == 0) {
     // RDCVA command -> voltage register group A
@@ -1993,17 +2453,18 @@ static void LTC_SaveRXtoVoltagebuffer(uint8_t registerSet, uint8_t *rxBuffer) {
         return;
     }
 
-    //////////////////////////////////////////////////
-    // reinitialize index counter at begin of cycle
-    if (i_offset == 0) {
-        ltc_used_cells_index = 0;
+    // the cell inputs used before the register group give the index of its first cell in the module,
+    // independent of the order in which the register groups are read or re-read
+    for (j=0; j < i_offset; j++) {
+        if (ltc_voltage_input_used[j] == 1) {
+            first_cell++;
+        }
     }
-    //////////////////////////////////////////////////
 
     /* Retrieve data without command and CRC*/
     for (i=0; i < LTC_N_LTC; i++) {
 
-        incrementations = 0;
+        module_cell = first_cell;
 
         // parse all three voltages (3 * 2bytes) contained in one register
         for (j=0; j < 3; j++) {
@@ -2012,24 +2473,21 @@ static void LTC_SaveRXtoVoltagebuffer(uint8_t registerSet, uint8_t *rxBuffer) {
             voltage_index = j+i_offset;
 
             if (ltc_voltage_input_used[voltage_index] == 1) {
-                val_ui = *((uint16_t *)(&rxBuffer[4+2*j+i*8]));
-                voltage = (uint16_t)(((float)(val_ui))*100e-6*1000.0);        // Unit V -> in mV
-                ltc_cellvoltage.voltage[ltc_used_cells_index+i*(BS_NR_OF_BAT_CELLS_PER_MODULE)] = voltage;
-
-                ltc_used_cells_index++;
-                incrementations++;
-
-                if (ltc_used_cells_index > BS_NR_OF_BAT_CELLS_PER_MODULE) {
+                // more cell inputs used than cells per module
+                if (module_cell >= BS_NR_OF_BAT_CELLS_PER_MODULE) {
                     return;
                 }
 
+                val_ui = *((uint16_t *)(&rxBuffer[4+2*j+i*8]));
+                voltage = LTC_CONVERT_RAW_TO_MV(val_ui);        // Unit -> in mV
+                cell_index = module_cell+(LTC_MODULE_OFFSET(ltc_state)+i)*(BS_NR_OF_BAT_CELLS_PER_MODULE);
+                ltc_cellvoltage.voltage[cell_index] = voltage;
+                STAT_AddU16(&ltc_voltage_acc, voltage, cell_index);
+
+                module_cell++;
             }
 
         }
-        // restore start value for next module
-        if (i < LTC_N_LTC-1) {
-            ltc_used_cells_index -= incrementations;
-        }
     }
 
 }
@@ -2050,49 +2508,49 @@ static void LTC_SaveRXtoVoltagebuffer(uint8_t registerSet, uint8_t *rxBuffer) {
  *
  * @return  mux_error            0 is there was no error, 1 if there was errors
  */
-static uint8_t LTC_I2CCheckACK(uint8_t *DataBufferSPI_RX, int mux) {
+static uint8_t LTC_I2CCheckACK(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_RX, int mux) {
     uint8_t mux_error = E_OK;
     uint16_t i = 0;
 
-    for (i=0; i < BS_NR_OF_MODULES; i++) {
+    for (i=0; i < LTC_NR_OF_MODULES_PER_CHAIN; i++) {
         if (mux == 0) {
             if ((DataBufferSPI_RX[4+1+LTC_NUMBER_OF_LTC_PER_MODULE*i*8] & 0x0F) != 0x07) {    // ACK = 0xX7
                 if (LTC_DISCARD_MUX_CHECK == FALSE) {
-                    LTC_ErrorTable[i].mux0 = 1;
+                    LTC_ErrorTable[LTC_MODULE_OFFSET(ltc_state)+i].mux0 = 1;
                 }
                 mux_error = E_NOT_OK;
             } else {
-                LTC_ErrorTable[i].mux0 = 0;
+                LTC_ErrorTable[LTC_MODULE_OFFSET(ltc_state)+i].mux0 = 0;
             }
         }
         if (mux == 1) {
             if ((DataBufferSPI_RX[4+1+LTC_NUMBER_OF_LTC_PER_MODULE*i*8] & 0x0F) != 0x27) {
                 if (LTC_DISCARD_MUX_CHECK == FALSE) {
-                    LTC_ErrorTable[i].mux1 = 1;
+                    LTC_ErrorTable[LTC_MODULE_OFFSET(ltc_state)+i].mux1 = 1;
                 }
                 mux_error = E_NOT_OK;
             } else {
-                LTC_ErrorTable[i].mux1 = 0;
+                LTC_ErrorTable[LTC_MODULE_OFFSET(ltc_state)+i].mux1 = 0;
             }
         }
         if (mux == 2) {
             if ((DataBufferSPI_RX[4+1+LTC_NUMBER_OF_LTC_PER_MODULE*i*8] & 0x0F) != 0x47) {
                 if (LTC_DISCARD_MUX_CHECK == FALSE) {
-                    LTC_ErrorTable[i].mux2 = 1;
+                    LTC_ErrorTable[LTC_MODULE_OFFSET(ltc_state)+i].mux2 = 1;
                 }
                 mux_error = E_NOT_OK;
             } else {
-                LTC_ErrorTable[i].mux2 = 0;
+                LTC_ErrorTable[LTC_MODULE_OFFSET(ltc_state)+i].mux2 = 0;
             }
         }
         if (mux == 3) {
             if ((DataBufferSPI_RX[4+1+LTC_NUMBER_OF_LTC_PER_MODULE*i*8] & 0x0F) != 0x67) {
                 if (LTC_DISCARD_MUX_CHECK == FALSE) {
-                    LTC_ErrorTable[i].mux3 = 1;
+                    LTC_ErrorTable[LTC_MODULE_OFFSET(ltc_state)+i].mux3 = 1;
                 }
                 mux_error = E_NOT_OK;
             } else {
-                LTC_ErrorTable[i].mux3 = 0;
+                LTC_ErrorTable[LTC_MODULE_OFFSET(ltc_state)+i].mux3 = 0;
             }
         }
     }
@@ -2115,12 +2573,11 @@ static uint8_t LTC_I2CCheckACK(uint8_t *DataBufferSPI_RX, int mux) {
  * @return  retVal  E_OK if dummy byte was sent correctly by SPI, E_NOT_OK otherwise
  *
  */
-static STD_RETURN_TYPE_e LTC_Init(void) {
+static STD_RETURN_TYPE_e LTC_Init(LTC_STATE_s *ltc_state) {
 
     STD_RETURN_TYPE_e statusSPI = E_NOT_OK;
     STD_RETURN_TYPE_e retVal = E_OK;
 
-    uint8_t PEC_Check[6];
     uint16_t PEC_result = 0;
     uint16_t i = 0;
 
@@ -2130,35 +2587,35 @@ static STD_RETURN_TYPE_e LTC_Init(void) {
     for (i=0; i < LTC_N_LTC; i++) {
 
         // FC = disable all pull-downs, REFON = 1
-        ltc_TXBuffer[0+(1*i)*6] = 0xFC;
-        ltc_TXBuffer[1+(1*i)*6] = 0x00;
-        ltc_TXBuffer[2+(1*i)*6] = 0x00;
-        ltc_TXBuffer[3+(1*i)*6] = 0x00;
-        ltc_TXBuffer[4+(1*i)*6] = 0x00;
-        ltc_TXBuffer[5+(1*i)*6] = 0x00;
+        ltc_TXBuffer[ltc_state->instanceID][0+(1*i)*6] = 0xFC;
+        ltc_TXBuffer[ltc_state->instanceID][1+(1*i)*6] = 0x00;
+        ltc_TXBuffer[ltc_state->instanceID][2+(1*i)*6] = 0x00;
+        ltc_TXBuffer[ltc_state->instanceID][3+(1*i)*6] = 0x00;
+        ltc_TXBuffer[ltc_state->instanceID][4+(1*i)*6] = 0x00;
+        ltc_TXBuffer[ltc_state->instanceID][5+(1*i)*6] = 0x00;
     }
 
     // now construct the message to be sent: it contains the wanted data, PLUS the needed PECs
-    ltc_TXPECbuffer[0] = ltc_cmdWRCFG[0];
-    ltc_TXPECbuffer[1] = ltc_cmdWRCFG[1];
-    ltc_TXPECbuffer[2] = ltc_cmdWRCFG[2];
-    ltc_TXPECbuffer[3] = ltc_cmdWRCFG[3];
+    ltc_TXPECbuffer[ltc_state->instanceID][0] = ltc_cmdWRCFG[0];
+    ltc_TXPECbuffer[ltc_state->instanceID][1] = ltc_cmdWRCFG[1];
+    ltc_TXPECbuffer[ltc_state->instanceID][2] = ltc_cmdWRCFG[2];
+    ltc_TXPECbuffer[ltc_state->instanceID][3] = ltc_cmdWRCFG[3];
 
     for (i=0; i < LTC_N_LTC; i++) {
 
-        PEC_Check[0] = ltc_TXPECbuffer[4+i*8] = ltc_TXBuffer[0+i*6];
-        PEC_Check[1] = ltc_TXPECbuffer[5+i*8] = ltc_TXBuffer[1+i*6];
-        PEC_Check[2] = ltc_TXPECbuffer[6+i*8] = ltc_TXBuffer[2+i*6];
-        PEC_Check[3] = ltc_TXPECbuffer[7+i*8] = ltc_TXBuffer[3+i*6];
-        PEC_Check[4] = ltc_TXPECbuffer[8+i*8] = ltc_TXBuffer[4+i*6];
-        PEC_Check[5] = ltc_TXPECbuffer[9+i*8] = ltc_TXBuffer[5+i*6];
+        ltc_TXPECbuffer[ltc_state->instanceID][4+i*8] = ltc_TXBuffer[ltc_state->instanceID][0+i*6];
+        ltc_TXPECbuffer[ltc_state->instanceID][5+i*8] = ltc_TXBuffer[ltc_state->instanceID][1+i*6];
+        ltc_TXPECbuffer[ltc_state->instanceID][6+i*8] = ltc_TXBuffer[ltc_state->instanceID][2+i*6];
+        ltc_TXPECbuffer[ltc_state->instanceID][7+i*8] = ltc_TXBuffer[ltc_state->instanceID][3+i*6];
+        ltc_TXPECbuffer[ltc_state->instanceID][8+i*8] = ltc_TXBuffer[ltc_state->instanceID][4+i*6];
+        ltc_TXPECbuffer[ltc_state->instanceID][9+i*8] = ltc_TXBuffer[ltc_state->instanceID][5+i*6];
 
-        PEC_result = LTC_pec15_calc(6, PEC_Check);
-        ltc_TXPECbuffer[10+i*8]=(uint8_t)((PEC_result>>8)&0xff);
-        ltc_TXPECbuffer[11+i*8]=(uint8_t)(PEC_result&0xff);
+        PEC_result = LTC_pec15_calc6(&ltc_TXBuffer[ltc_state->instanceID][i*6]);
+        ltc_TXPECbuffer[ltc_state->instanceID][10+i*8]=(uint8_t)((PEC_result>>8)&0xff);
+        ltc_TXPECbuffer[ltc_state->instanceID][11+i*8]=(uint8_t)(PEC_result&0xff);
     }  // end for
 
-    statusSPI = LTC_SendData(ltc_TXPECbuffer);
+    statusSPI = LTC_ChainSendData(ltc_state, ltc_TXPECbuffer[ltc_state->instanceID]);
 
     if (statusSPI != E_OK) {
         retVal = E_NOT_OK;
@@ -2183,104 +2640,108 @@ static STD_RETURN_TYPE_e LTC_Init(void) {
  * @return              E_OK if dummy byte was sent correctly by SPI, E_NOT_OK otherwise
  *
  */
-static STD_RETURN_TYPE_e LTC_BalanceControl(uint8_t registerSet) {
+static STD_RETURN_TYPE_e LTC_BalanceControl(LTC_STATE_s *ltc_state, uint8_t registerSet) {
 
     STD_RETURN_TYPE_e retVal = E_OK;
 
     uint16_t i = 0;
     uint16_t j = 0;
+    uint16_t cell_offset = 0;
 
-    LTC_Get_BalancingControlValues();
+    // on failure, the balancing control values are cleared and all cells are configured without balancing
+    (void)LTC_Get_BalancingControlValues();
 
     if (registerSet == 0) {  // cells 1 to 12, WRCFG
 
-        for (j=0; j < BS_NR_OF_MODULES; j++) {
+        for (j=0; j < LTC_NR_OF_MODULES_PER_CHAIN; j++) {
 
-            i = BS_NR_OF_MODULES-j-1;
+            i = LTC_NR_OF_MODULES_PER_CHAIN-j-1;
+            cell_offset = (LTC_MODULE_OFFSET(ltc_state)+j)*(BS_NR_OF_BAT_CELLS_PER_MODULE);
 
             // FC = disable all pull-downs, REFON = 1 (reference always on), DTEN off, ADCOPT = 0
-            ltc_TXBuffer[0+(i)*6] = 0xFC;
-            ltc_TXBuffer[1+(i)*6] = 0x00;
-            ltc_TXBuffer[2+(i)*6] = 0x00;
-            ltc_TXBuffer[3+(i)*6] = 0x00;
-            ltc_TXBuffer[4+(i)*6] = 0x00;
-            ltc_TXBuffer[5+(i)*6] = 0x00;
-
-            if (ltc_balancing_control.value[j*(BS_NR_OF_BAT_CELLS_PER_MODULE)+0] == 1) {
-                ltc_TXBuffer[4+(i)*6]|=0x01;
+            ltc_TXBuffer[ltc_state->instanceID][0+(i)*6] = 0xFC;
+            ltc_TXBuffer[ltc_state->instanceID][1+(i)*6] = 0x00;
+            ltc_TXBuffer[ltc_state->instanceID][2+(i)*6] = 0x00;
+            ltc_TXBuffer[ltc_state->instanceID][3+(i)*6] = 0x00;
+            ltc_TXBuffer[ltc_state->instanceID][4+(i)*6] = 0x00;
+            ltc_TXBuffer[ltc_state->instanceID][5+(i)*6] = 0x00;
+
+            if (ltc_balancing_control.value[cell_offset+0] == 1) {
+                ltc_TXBuffer[ltc_state->instanceID][4+(i)*6]|=0x01;
             }
-            if (ltc_balancing_control.value[j*(BS_NR_OF_BAT_CELLS_PER_MODULE)+1] == 1) {
-                ltc_TXBuffer[4+(i)*6]|=0x02;
+            if (ltc_balancing_control.value[cell_offset+1] == 1) {
+                ltc_TXBuffer[ltc_state->instanceID][4+(i)*6]|=0x02;
             }
-            if (ltc_balancing_control.value[j*(BS_NR_OF_BAT_CELLS_PER_MODULE)+2] == 1) {
-                ltc_TXBuffer[4+(i)*6]|=0x04;
+            if (ltc_balancing_control.value[cell_offset+2] == 1) {
+                ltc_TXBuffer[ltc_state->instanceID][4+(i)*6]|=0x04;
             }
-            if (ltc_balancing_control.value[j*(BS_NR_OF_BAT_CELLS_PER_MODULE)+3] == 1) {
-                ltc_TXBuffer[4+(i)*6]|=0x08;
+            if (ltc_balancing_control.value[cell_offset+3] == 1) {
+                ltc_TXBuffer[ltc_state->instanceID][4+(i)*6]|=0x08;
             }
-            if (ltc_balancing_control.value[j*(BS_NR_OF_BAT_CELLS_PER_MODULE)+4] == 1) {
-                ltc_TXBuffer[4+(i)*6]|=0x10;
+            if (ltc_balancing_control.value[cell_offset+4] == 1) {
+                ltc_TXBuffer[ltc_state->instanceID][4+(i)*6]|=0x10;
             }
-            if (ltc_balancing_control.value[j*(BS_NR_OF_BAT_CELLS_PER_MODULE)+5] == 1) {
-                ltc_TXBuffer[4+(i)*6]|=0x20;
+            if (ltc_balancing_control.value[cell_offset+5] == 1) {
+                ltc_TXBuffer[ltc_state->instanceID][4+(i)*6]|=0x20;
             }
-            if (ltc_balancing_control.value[j*(BS_NR_OF_BAT_CELLS_PER_MODULE)+6] == 1) {
-                ltc_TXBuffer[4+(i)*6]|=0x40;
+            if (ltc_balancing_control.value[cell_offset+6] == 1) {
+                ltc_TXBuffer[ltc_state->instanceID][4+(i)*6]|=0x40;
             }
-            if (ltc_balancing_control.value[j*(BS_NR_OF_BAT_CELLS_PER_MODULE)+7] == 1) {
-                ltc_TXBuffer[4+(i)*6]|=0x80;
+            if (ltc_balancing_control.value[cell_offset+7] == 1) {
+                ltc_TXBuffer[ltc_state->instanceID][4+(i)*6]|=0x80;
             }
-            if (ltc_balancing_control.value[j*(BS_NR_OF_BAT_CELLS_PER_MODULE)+8] == 1) {
-                ltc_TXBuffer[5+(i)*6]|=0x01;
+            if (ltc_balancing_control.value[cell_offset+8] == 1) {
+                ltc_TXBuffer[ltc_state->instanceID][5+(i)*6]|=0x01;
             }
-            if (ltc_balancing_control.value[j*(BS_NR_OF_BAT_CELLS_PER_MODULE)+9] == 1) {
-                ltc_TXBuffer[5+(i)*6]|=0x02;
+            if (ltc_balancing_control.value[cell_offset+9] == 1) {
+                ltc_TXBuffer[ltc_state->instanceID][5+(i)*6]|=0x02;
             }
-            if (ltc_balancing_control.value[j*(BS_NR_OF_BAT_CELLS_PER_MODULE)+10] == 1) {
-                ltc_TXBuffer[5+(i)*6]|=0x04;
+            if (ltc_balancing_control.value[cell_offset+10] == 1) {
+                ltc_TXBuffer[ltc_state->instanceID][5+(i)*6]|=0x04;
             }
-            if (ltc_balancing_control.value[j*(BS_NR_OF_BAT_CELLS_PER_MODULE)+11] == 1) {
-                ltc_TXBuffer[5+(i)*6]|=0x08;
+            if (ltc_balancing_control.value[cell_offset+11] == 1) {
+                ltc_TXBuffer[ltc_state->instanceID][5+(i)*6]|=0x08;
             }
         }
-        retVal = LTC_TX((uint8_t*)ltc_cmdWRCFG, ltc_TXBuffer, ltc_TXPECbuffer);
+        retVal = LTC_TX(ltc_state, (uint8_t*)ltc_cmdWRCFG, ltc_TXBuffer[ltc_state->instanceID], ltc_TXPECbuffer[ltc_state->instanceID]);
     } else if (registerSet == 1) {  // cells 13 to 15/18 WRCFG2
 
-        for (j=0; j < BS_NR_OF_MODULES; j++) {
+        for (j=0; j < LTC_NR_OF_MODULES_PER_CHAIN; j++) {
 
-            i = BS_NR_OF_MODULES-j-1;
+            i = LTC_NR_OF_MODULES_PER_CHAIN-j-1;
+            cell_offset = (LTC_MODULE_OFFSET(ltc_state)+j)*(BS_NR_OF_BAT_CELLS_PER_MODULE);
 
             // 0x0F = disable pull-downs on GPIO6-9
-            ltc_TXBuffer[0+(i)*6] = 0x0F;
-            ltc_TXBuffer[1+(i)*6] = 0x00;
-            ltc_TXBuffer[2+(i)*6] = 0x00;
-            ltc_TXBuffer[3+(i)*6] = 0x00;
-            ltc_TXBuffer[4+(i)*6] = 0x00;
-            ltc_TXBuffer[5+(i)*6] = 0x00;
-
-            if (ltc_balancing_control.value[j*(BS_NR_OF_BAT_CELLS_PER_MODULE)+12] == 1) {
-                ltc_TXBuffer[0+(i)*6] |= 0x10;
+            ltc_TXBuffer[ltc_state->instanceID][0+(i)*6] = 0x0F;
+            ltc_TXBuffer[ltc_state->instanceID][1+(i)*6] = 0x00;
+            ltc_TXBuffer[ltc_state->instanceID][2+(i)*6] = 0x00;
+            ltc_TXBuffer[ltc_state->instanceID][3+(i)*6] = 0x00;
+            ltc_TXBuffer[ltc_state->instanceID][4+(i)*6] = 0x00;
+            ltc_TXBuffer[ltc_state->instanceID][5+(i)*6] = 0x00;
+
+            if (ltc_balancing_control.value[cell_offset+12] == 1) {
+                ltc_TXBuffer[ltc_state->instanceID][0+(i)*6] |= 0x10;
             }
-            if (ltc_balancing_control.value[j*(BS_NR_OF_BAT_CELLS_PER_MODULE)+13] == 1) {
-                ltc_TXBuffer[0+(i)*6] |= 0x20;
+            if (ltc_balancing_control.value[cell_offset+13] == 1) {
+                ltc_TXBuffer[ltc_state->instanceID][0+(i)*6] |= 0x20;
             }
-            if (ltc_balancing_control.value[j*(BS_NR_OF_BAT_CELLS_PER_MODULE)+14] == 1) {
-                ltc_TXBuffer[0+(i)*6] |= 0x40;
+            if (ltc_balancing_control.value[cell_offset+14] == 1) {
+                ltc_TXBuffer[ltc_state->instanceID][0+(i)*6] |= 0x40;
             }
             if (BS_NR_OF_BAT_CELLS_PER_MODULE > 15) {
 
-                if (ltc_balancing_control.value[j*(BS_NR_OF_BAT_CELLS_PER_MODULE)+15] == 1) {
-                    ltc_TXBuffer[0+(i)*6] |= 0x80;
+                if (ltc_balancing_control.value[cell_offset+15] == 1) {
+                    ltc_TXBuffer[ltc_state->instanceID][0+(i)*6] |= 0x80;
                 }
-                if (ltc_balancing_control.value[j*(BS_NR_OF_BAT_CELLS_PER_MODULE)+16] == 1) {
-                    ltc_TXBuffer[1+(i)*6] |= 0x01;
+                if (ltc_balancing_control.value[cell_offset+16] == 1) {
+                    ltc_TXBuffer[ltc_state->instanceID][1+(i)*6] |= 0x01;
                 }
-                if (ltc_balancing_control.value[j*(BS_NR_OF_BAT_CELLS_PER_MODULE)+17] == 1) {
-                    ltc_TXBuffer[1+(i)*6] |= 0x02;
+                if (ltc_balancing_control.value[cell_offset+17] == 1) {
+                    ltc_TXBuffer[ltc_state->instanceID][1+(i)*6] |= 0x02;
                 }
             }
         }
-        retVal = LTC_TX((uint8_t*)ltc_cmdWRCFG2, ltc_TXBuffer, ltc_TXPECbuffer);
+        retVal = LTC_TX(ltc_state, (uint8_t*)ltc_cmdWRCFG2, ltc_TXBuffer[ltc_state->instanceID], ltc_TXPECbuffer[ltc_state->instanceID]);
     } else {
         return E_NOT_OK;
     }
@@ -2296,10 +2757,10 @@ static STD_RETURN_TYPE_e LTC_BalanceControl(uint8_t registerSet) {
  * @return  void
  *
  */
-static void LTC_ResetErrorTable(void) {
+static void LTC_ResetErrorTable(LTC_STATE_s *ltc_state) {
     uint16_t i = 0;
 
-    for (i=0; i < BS_NR_OF_MODULES; i++) {
+    for (i=LTC_MODULE_OFFSET(ltc_state); i < LTC_MODULE_OFFSET(ltc_state)+LTC_NR_OF_MODULES_PER_CHAIN; i++) {
         LTC_ErrorTable[i].LTC = 0;
         LTC_ErrorTable[i].mux0 = 0;
         LTC_ErrorTable[i].mux1 = 0;
@@ -2373,36 +2834,36 @@ static uint16_t LTC_Get_MeasurementTCycle(LTC_ADCMODE_e adcMode, LTC_ADCMEAS_CHA
  * @return  retVal      E_OK if dummy byte was sent correctly by SPI, E_NOT_OK otherwise
  *
  */
-static STD_RETURN_TYPE_e LTC_StartVoltageMeasurement(LTC_ADCMODE_e adcMode, LTC_ADCMEAS_CHAN_e adcMeasCh) {
+static STD_RETURN_TYPE_e LTC_StartVoltageMeasurement(LTC_STATE_s *ltc_state, LTC_ADCMODE_e adcMode, LTC_ADCMEAS_CHAN_e adcMeasCh) {
 
     STD_RETURN_TYPE_e retVal = E_OK;
 
     if (adcMeasCh == LTC_ADCMEAS_ALLCHANNEL) {
         if (adcMode == LTC_ADCMODE_FAST_DCP0) {
 
-            retVal = LTC_SendCmd(ltc_cmdADCV_fast_DCP0);
+            retVal = LTC_ChainSendCmd(ltc_state, ltc_cmdADCV_fast_DCP0);
         } else if (adcMode == LTC_ADCMODE_NORMAL_DCP0) {
 
-            retVal = LTC_SendCmd(ltc_cmdADCV_normal_DCP0);
+            retVal = LTC_ChainSendCmd(ltc_state, ltc_cmdADCV_normal_DCP0);
         } else if (adcMode == LTC_ADCMODE_FILTERED_DCP0) {
 
-            retVal = LTC_SendCmd(ltc_cmdADCV_filtered_DCP0);
+            retVal = LTC_ChainSendCmd(ltc_state, ltc_cmdADCV_filtered_DCP0);
         } else if (adcMode == LTC_ADCMODE_FAST_DCP1) {
 
-            retVal = LTC_SendCmd(ltc_cmdADCV_fast_DCP1);
+            retVal = LTC_ChainSendCmd(ltc_state, ltc_cmdADCV_fast_DCP1);
         } else if (adcMode == LTC_ADCMODE_NORMAL_DCP1) {
 
-            retVal = LTC_SendCmd(ltc_cmdADCV_normal_DCP1);
+            retVal = LTC_ChainSendCmd(ltc_state, ltc_cmdADCV_normal_DCP1);
         } else if (adcMode == LTC_ADCMODE_FILTERED_DCP1) {
 
-            retVal = LTC_SendCmd(ltc_cmdADCV_filtered_DCP1);
+            retVal = LTC_ChainSendCmd(ltc_state, ltc_cmdADCV_filtered_DCP1);
         } else {
             retVal = E_NOT_OK;
         }
     } else if (adcMeasCh == LTC_ADCMEAS_SINGLECHANNEL_TWOCELLS) {
         if (adcMode == LTC_ADCMODE_FAST_DCP0) {
 
-            retVal = LTC_SendCmd(ltc_cmdADCV_fast_DCP0_twocells);
+            retVal = LTC_ChainSendCmd(ltc_state, ltc_cmdADCV_fast_DCP0_twocells);
         } else {
             retVal = E_NOT_OK;
         }
@@ -2424,7 +2885,7 @@ static STD_RETURN_TYPE_e LTC_StartVoltageMeasurement(LTC_ADCMODE_e adcMode, LTC_
  * @return  retVal      E_OK if dummy byte was sent correctly by SPI, E_NOT_OK otherwise
  *
  */
-static STD_RETURN_TYPE_e LTC_StartGPIOMeasurement(LTC_ADCMODE_e adcMode, LTC_ADCMEAS_CHAN_e  adcMeasCh) {
+static STD_RETURN_TYPE_e LTC_StartGPIOMeasurement(LTC_STATE_s *ltc_state, LTC_ADCMODE_e adcMode, LTC_ADCMEAS_CHAN_e  adcMeasCh) {
 
     STD_RETURN_TYPE_e retVal;
 
@@ -2432,52 +2893,52 @@ static STD_RETURN_TYPE_e LTC_StartGPIOMeasurement(LTC_ADCMODE_e adcMode, LTC_ADC
 
         if (adcMode == LTC_ADCMODE_FAST_DCP0 || adcMode == LTC_ADCMODE_FAST_DCP1) {
 
-            retVal = LTC_SendCmd(ltc_cmdADAX_fast_ALLGPIOS);
+            retVal = LTC_ChainSendCmd(ltc_state, ltc_cmdADAX_fast_ALLGPIOS);
         } else if (adcMode == LTC_ADCMODE_FILTERED_DCP0 || adcMode == LTC_ADCMODE_FILTERED_DCP1) {
 
-            retVal = LTC_SendCmd(ltc_cmdADAX_filtered_ALLGPIOS);
+            retVal = LTC_ChainSendCmd(ltc_state, ltc_cmdADAX_filtered_ALLGPIOS);
         } else {
             /*if(adcMode == LTC_ADCMODE_NORMAL_DCP0 || adcMode == LTC_ADCMODE_NORMAL_DCP1)*/
-            retVal = LTC_SendCmd(ltc_cmdADAX_normal_ALLGPIOS);
+            retVal = LTC_ChainSendCmd(ltc_state, ltc_cmdADAX_normal_ALLGPIOS);
         }
     } else if (adcMeasCh == LTC_ADCMEAS_SINGLECHANNEL_GPIO1) {
         // Single Channel
         if (adcMode == LTC_ADCMODE_FAST_DCP0 || adcMode == LTC_ADCMODE_FAST_DCP1) {
 
-            retVal = LTC_SendCmd(ltc_cmdADAX_fast_GPIO1);
+            retVal = LTC_ChainSendCmd(ltc_state, ltc_cmdADAX_fast_GPIO1);
         } else if (adcMode == LTC_ADCMODE_FILTERED_DCP0 || adcMode == LTC_ADCMODE_FILTERED_DCP1) {
 
-            retVal = LTC_SendCmd(ltc_cmdADAX_filtered_GPIO1);
+            retVal = LTC_ChainSendCmd(ltc_state, ltc_cmdADAX_filtered_GPIO1);
         } else {
             /*if(adcMode == LTC_ADCMODE_NORMAL_DCP0 || adcMode == LTC_ADCMODE_NORMAL_DCP1)*/
 
-            retVal = LTC_SendCmd(ltc_cmdADAX_normal_GPIO1);
+            retVal = LTC_ChainSendCmd(ltc_state, ltc_cmdADAX_normal_GPIO1);
         }
     } else if (adcMeasCh == LTC_ADCMEAS_SINGLECHANNEL_GPIO2) {
         // Single Channel
         if (adcMode == LTC_ADCMODE_FAST_DCP0 || adcMode == LTC_ADCMODE_FAST_DCP1) {
 
-            retVal = LTC_SendCmd(ltc_cmdADAX_fast_GPIO2);
+            retVal = LTC_ChainSendCmd(ltc_state, ltc_cmdADAX_fast_GPIO2);
         } else if (adcMode == LTC_ADCMODE_FILTERED_DCP0 || adcMode == LTC_ADCMODE_FILTERED_DCP1) {
 
-            retVal = LTC_SendCmd(ltc_cmdADAX_filtered_GPIO2);
+            retVal = LTC_ChainSendCmd(ltc_state, ltc_cmdADAX_filtered_GPIO2);
         } else {
             /*if(adcMode == LTC_ADCMODE_NORMAL_DCP0 || adcMode == LTC_ADCMODE_NORMAL_DCP1)*/
 
-            retVal = LTC_SendCmd(ltc_cmdADAX_normal_GPIO2);
+            retVal = LTC_ChainSendCmd(ltc_state, ltc_cmdADAX_normal_GPIO2);
         }
     } else if (adcMeasCh == LTC_ADCMEAS_SINGLECHANNEL_GPIO3) {
         // Single Channel
         if (adcMode == LTC_ADCMODE_FAST_DCP0 || adcMode == LTC_ADCMODE_FAST_DCP1) {
 
-            retVal = LTC_SendCmd(ltc_cmdADAX_fast_GPIO3);
+            retVal = LTC_ChainSendCmd(ltc_state, ltc_cmdADAX_fast_GPIO3);
         } else if (adcMode == LTC_ADCMODE_FILTERED_DCP0 || adcMode == LTC_ADCMODE_FILTERED_DCP1) {
 
-            retVal = LTC_SendCmd(ltc_cmdADAX_filtered_GPIO3);
+            retVal = LTC_ChainSendCmd(ltc_state, ltc_cmdADAX_filtered_GPIO3);
         } else {
             /*if(adcMode == LTC_ADCMODE_NORMAL_DCP0 || adcMode == LTC_ADCMODE_NORMAL_DCP1)*/
 
-            retVal = LTC_SendCmd(ltc_cmdADAX_normal_GPIO3);
+            retVal = LTC_ChainSendCmd(ltc_state, ltc_cmdADAX_normal_GPIO3);
         }
     } else {
         retVal = E_NOT_OK;
@@ -2493,51 +2954,49 @@ static STD_RETURN_TYPE_e LTC_StartGPIOMeasurement(LTC_ADCMODE_e adcMode, LTC_ADC
  * This function computes the PEC (CRC) from the data received by the daisy-chain.
  * It compares it with the PEC sent by the LTCs.
  * If there are errors, the array LTC_ErrorTable is updated to locate the LTCs in daisy-chain
- * that transmitted corrupt data.
+ * that transmitted corrupt data. The PEC error statistics of every LTC (errStatus) are updated.
  *
  * @param   *DataBufferSPI_RX_with_PEC   data obtained from the SPI transmission
  *
- * @return  retVal                       E_OK if PEC check is OK, E_NOT_OK otherwise
+ * @return  retVal                       E_OK if the PEC of all LTCs is OK, E_NOT_OK otherwise
  *
  */
-static STD_RETURN_TYPE_e LTC_RX_PECCheck(uint8_t *DataBufferSPI_RX_with_PEC) {
+static STD_RETURN_TYPE_e LTC_RX_PECCheck(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_RX_with_PEC) {
 
     uint16_t i = 0;
     STD_RETURN_TYPE_e retVal = E_OK;
-    uint8_t PEC_TX[2];
-    uint16_t PEC_result = 0;
-    uint8_t PEC_Check[6] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-
-    // check all PECs and put data without command and PEC in DataBufferSPI_RX (easier to use)
-    for (i=0; i < LTC_N_LTC; i++) {
+    uint32_t now = MCU_GetTimeStamp();
+    uint8_t errorBitmap[(LTC_N_LTC+7)/8];
 
-        PEC_Check[0] = DataBufferSPI_RX_with_PEC[4+i*8];
-        PEC_Check[1] = DataBufferSPI_RX_with_PEC[5+i*8];
-        PEC_Check[2] = DataBufferSPI_RX_with_PEC[6+i*8];
-        PEC_Check[3] = DataBufferSPI_RX_with_PEC[7+i*8];
-        PEC_Check[4] = DataBufferSPI_RX_with_PEC[8+i*8];
-        PEC_Check[5] = DataBufferSPI_RX_with_PEC[9+i*8];
+    // check the PECs of all LTCs in place, bit i of errorBitmap is set if the PEC of LTC i is wrong
+    retVal = LTC_pec15_verify_chain(DataBufferSPI_RX_with_PEC, LTC_N_LTC, errorBitmap);
 
-        PEC_result = LTC_pec15_calc(6, PEC_Check);
-        PEC_TX[0]=(uint8_t)((PEC_result>>8)&0xff);
-        PEC_TX[1]=(uint8_t)(PEC_result&0xff);
+    for (i=0; i < LTC_N_LTC; i++) {
 
         // if calculated PEC not equal to received PEC
-        if ((PEC_TX[0] != DataBufferSPI_RX_with_PEC[10+i*8]) || (PEC_TX[1] != DataBufferSPI_RX_with_PEC[11+i*8])) {
+        if ((errorBitmap[i>>3] & (1u<<(i&7))) != 0) {
 
             // update error table of the corresponding LTC
             if (LTC_DISCARD_PEC == FALSE) {
-                LTC_ErrorTable[i].LTC = 1;
+                LTC_ErrorTable[LTC_MODULE_OFFSET(ltc_state)+i].LTC = 1;
+            }
+            ltc_state->errStatus.errPECCnt[i]++;
+            if (ltc_state->errStatus.errConsecutivePECCnt[i] < UINT16_MAX) {
+                ltc_state->errStatus.errConsecutivePECCnt[i]++;
             }
-            retVal = E_NOT_OK;
 
         } else {
             // update error table of the corresponding LTC
-            LTC_ErrorTable[i].LTC = 0;
-            retVal = E_OK;
+            LTC_ErrorTable[LTC_MODULE_OFFSET(ltc_state)+i].LTC = 0;
+            ltc_state->errStatus.errConsecutivePECCnt[i] = 0;
+            ltc_state->errStatus.lastValidTimestamp[i] = now;
         }
     }
 
+    if (retVal != E_OK) {
+        ltc_state->ErrPECCounter++;
+    }
+
     if (LTC_DISCARD_PEC == TRUE) {
         return E_OK;
     } else {
@@ -2546,6 +3005,25 @@ static STD_RETURN_TYPE_e LTC_RX_PECCheck(uint8_t *DataBufferSPI_RX_with_PEC) {
 }
 
 
+/**
+ * @brief   checks the PEC of the data sent by one LTC of the daisy-chain.
+ *
+ * @param   *DataBufferSPI_RX_with_PEC   data obtained from the SPI transmission
+ * @param   ltc                          position of the LTC in the daisy-chain
+ *
+ * @return  TRUE if the received PEC is equal to the calculated PEC, FALSE otherwise
+ */
+static uint8_t LTC_RX_PECValid(uint8_t *DataBufferSPI_RX_with_PEC, uint16_t ltc) {
+
+    uint16_t PEC_result = LTC_pec15_calc6(&DataBufferSPI_RX_with_PEC[4+ltc*8]);
+
+    if ((((PEC_result>>8)&0xff) != DataBufferSPI_RX_with_PEC[10+ltc*8]) || ((PEC_result&0xff) != DataBufferSPI_RX_with_PEC[11+ltc*8])) {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+
 /**
  * @brief   send command to the LTC daisy-chain and receives data from the LTC daisy-chain.
  *
@@ -2565,7 +3043,7 @@ static STD_RETURN_TYPE_e LTC_RX_PECCheck(uint8_t *DataBufferSPI_RX_with_PEC) {
  * @return  statusSPI                   E_OK if SPI transmission is OK, E_NOT_OK otherwise
  *
  */
-static STD_RETURN_TYPE_e LTC_RX(uint8_t *Command, uint8_t *DataBufferSPI_RX_with_PEC) {
+static STD_RETURN_TYPE_e LTC_RX(LTC_STATE_s *ltc_state, uint8_t *Command, uint8_t *DataBufferSPI_RX_with_PEC) {
 
     STD_RETURN_TYPE_e statusSPI = E_OK;
     uint16_t i = 0;
@@ -2575,15 +3053,15 @@ static STD_RETURN_TYPE_e LTC_RX(uint8_t *Command, uint8_t *DataBufferSPI_RX_with
     // It constructs DataBufferSPI_RX, which contains the received data without PEC (easier to use).
 
     for (i=0; i < LTC_N_BYTES_FOR_DATA_TRANSMISSION; i++) {
-        ltc_TXPECbuffer[i] = 0x00;
+        ltc_TXPECbuffer[ltc_state->instanceID][i] = 0x00;
     }
 
-    ltc_TXPECbuffer[0] = Command[0];
-    ltc_TXPECbuffer[1] = Command[1];
-    ltc_TXPECbuffer[2] = Command[2];
-    ltc_TXPECbuffer[3] = Command[3];
+    ltc_TXPECbuffer[ltc_state->instanceID][0] = Command[0];
+    ltc_TXPECbuffer[ltc_state->instanceID][1] = Command[1];
+    ltc_TXPECbuffer[ltc_state->instanceID][2] = Command[2];
+    ltc_TXPECbuffer[ltc_state->instanceID][3] = Command[3];
 
-    statusSPI = LTC_ReceiveData(ltc_TXPECbuffer, DataBufferSPI_RX_with_PEC);
+    statusSPI = LTC_ChainReceiveData(ltc_state, ltc_TXPECbuffer[ltc_state->instanceID], DataBufferSPI_RX_with_PEC);
 
     if (statusSPI != E_OK) {
 
@@ -2595,6 +3073,81 @@ static STD_RETURN_TYPE_e LTC_RX(uint8_t *Command, uint8_t *DataBufferSPI_RX_with
 
 
 
+/**
+ * @brief   reads all cell voltage register groups of the LTC daisy-chain in one burst.
+ *
+ * The read commands RDCVA...RDCVF (depending on BS_MAX_SUPPORTED_CELLS) are
+ * transferred one after the other by the SPI interrupt. The received data of
+ * register group i is stored in ltc_voltageRXPECbuffer[ltc_state->instanceID][i]. The receive buffers
+ * are cleared before, so that the PEC check fails for groups that were not
+ * received. When the burst is complete, the task set with LTC_SetNotifiedTask()
+ * is notified.
+ *
+ * @return  E_OK if the burst was started, E_NOT_OK otherwise
+ */
+static STD_RETURN_TYPE_e LTC_RX_VoltageRegisters(LTC_STATE_s *ltc_state) {
+
+    uint16_t i = 0;
+    uint16_t j = 0;
+
+    for (i=0; i < LTC_VOLTAGE_REGISTER_GROUPS; i++) {
+        for (j=0; j < LTC_N_BYTES_FOR_DATA_TRANSMISSION; j++) {
+            ltc_voltageTXPECbuffer[ltc_state->instanceID][i][j] = 0x00;
+            ltc_voltageRXPECbuffer[ltc_state->instanceID][i][j] = 0x00;
+        }
+        ltc_voltageTXPECbuffer[ltc_state->instanceID][i][0] = ltc_cmdRDCV[i][0];
+        ltc_voltageTXPECbuffer[ltc_state->instanceID][i][1] = ltc_cmdRDCV[i][1];
+        ltc_voltageTXPECbuffer[ltc_state->instanceID][i][2] = ltc_cmdRDCV[i][2];
+        ltc_voltageTXPECbuffer[ltc_state->instanceID][i][3] = ltc_cmdRDCV[i][3];
+
+        ltc_voltageTransfers[ltc_state->instanceID][i].pTxData = ltc_voltageTXPECbuffer[ltc_state->instanceID][i];
+        ltc_voltageTransfers[ltc_state->instanceID][i].pRxData = ltc_voltageRXPECbuffer[ltc_state->instanceID][i];
+        ltc_voltageTransfers[ltc_state->instanceID][i].Size = LTC_N_BYTES_FOR_DATA_TRANSMISSION;
+    }
+
+    return LTC_ChainSPIStatus(ltc_state, SPI_TransmitReceiveChain(ltc_state->spiHandle, ltc_voltageTransfers[ltc_state->instanceID], LTC_VOLTAGE_REGISTER_GROUPS, ltc_notifiedTask));
+}
+
+
+/**
+ * @brief   re-reads the cell voltage register groups received with PEC error.
+ *
+ * Only the register groups in ltc_voltagePending[ltc_state->instanceID] are read
+ * again, in one burst like LTC_RX_VoltageRegisters(). The re-read is counted for
+ * every LTC that sent one of these groups with a PEC error.
+ *
+ * @param   ltc_state   state of the daisy-chain
+ *
+ * @return  number of register groups re-read, 0 if the burst could not be started
+ */
+static uint8_t LTC_RX_VoltageRegisterReread(LTC_STATE_s *ltc_state) {
+
+    uint16_t i = 0;
+    uint16_t j = 0;
+    uint8_t nr_of_groups = 0;
+
+    for (i=0; i < LTC_VOLTAGE_REGISTER_GROUPS; i++) {
+        if ((ltc_voltagePending[ltc_state->instanceID] & (1u << i)) != 0) {
+            for (j=0; j < LTC_N_LTC; j++) {
+                if (LTC_RX_PECValid(ltc_voltageRXPECbuffer[ltc_state->instanceID][i], j) == FALSE) {
+                    ltc_state->errStatus.errRetryCnt[j]++;
+                }
+            }
+            for (j=0; j < LTC_N_BYTES_FOR_DATA_TRANSMISSION; j++) {
+                ltc_voltageRXPECbuffer[ltc_state->instanceID][i][j] = 0x00;
+            }
+            ltc_voltageRereadTransfers[ltc_state->instanceID][nr_of_groups] = ltc_voltageTransfers[ltc_state->instanceID][i];
+            nr_of_groups++;
+        }
+    }
+
+    if (LTC_ChainSPIStatus(ltc_state, SPI_TransmitReceiveChain(ltc_state->spiHandle, ltc_voltageRereadTransfers[ltc_state->instanceID], nr_of_groups, ltc_notifiedTask)) != E_OK) {
+        return 0;
+    }
+    return nr_of_groups;
+}
+
+
 /**
  * @brief   sends command and data to the LTC daisy-chain.
  *
@@ -2616,12 +3169,11 @@ static STD_RETURN_TYPE_e LTC_RX(uint8_t *Command, uint8_t *DataBufferSPI_RX_with
  * @return                              E_OK if SPI transmission is OK, E_NOT_OK otherwise
  *
  */
-static STD_RETURN_TYPE_e LTC_TX(uint8_t *Command, uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC) {
+static STD_RETURN_TYPE_e LTC_TX(LTC_STATE_s *ltc_state, uint8_t *Command, uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC) {
 
     uint16_t i = 0;
     STD_RETURN_TYPE_e statusSPI = E_NOT_OK;
     uint16_t PEC_result = 0;
-    uint8_t PEC_Check[6] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
 
     // DataBufferSPI_TX contains the data to send.
     // The transmission function calculates the needed PEC.
@@ -2639,19 +3191,19 @@ static STD_RETURN_TYPE_e LTC_TX(uint8_t *Command, uint8_t *DataBufferSPI_TX, uin
     // Calculate PEC of all data (1 PEC value for 6 bytes)
     for (i=0; i < LTC_N_LTC; i++) {
 
-        PEC_Check[0] = DataBufferSPI_TX_with_PEC[4+i*8] = DataBufferSPI_TX[0+i*6];
-        PEC_Check[1] = DataBufferSPI_TX_with_PEC[5+i*8] = DataBufferSPI_TX[1+i*6];
-        PEC_Check[2] = DataBufferSPI_TX_with_PEC[6+i*8] = DataBufferSPI_TX[2+i*6];
-        PEC_Check[3] = DataBufferSPI_TX_with_PEC[7+i*8] = DataBufferSPI_TX[3+i*6];
-        PEC_Check[4] = DataBufferSPI_TX_with_PEC[8+i*8] = DataBufferSPI_TX[4+i*6];
-        PEC_Check[5] = DataBufferSPI_TX_with_PEC[9+i*8] = DataBufferSPI_TX[5+i*6];
+        DataBufferSPI_TX_with_PEC[4+i*8] = DataBufferSPI_TX[0+i*6];
+        DataBufferSPI_TX_with_PEC[5+i*8] = DataBufferSPI_TX[1+i*6];
+        DataBufferSPI_TX_with_PEC[6+i*8] = DataBufferSPI_TX[2+i*6];
+        DataBufferSPI_TX_with_PEC[7+i*8] = DataBufferSPI_TX[3+i*6];
+        DataBufferSPI_TX_with_PEC[8+i*8] = DataBufferSPI_TX[4+i*6];
+        DataBufferSPI_TX_with_PEC[9+i*8] = DataBufferSPI_TX[5+i*6];
 
-        PEC_result = LTC_pec15_calc(6, PEC_Check);
+        PEC_result = LTC_pec15_calc6(&DataBufferSPI_TX[i*6]);
         DataBufferSPI_TX_with_PEC[10+i*8]=(uint8_t)((PEC_result>>8)&0xff);
         DataBufferSPI_TX_with_PEC[11+i*8]=(uint8_t)(PEC_result&0xff);
     }
 
-    statusSPI = LTC_SendData(DataBufferSPI_TX_with_PEC);
+    statusSPI = LTC_ChainSendData(ltc_state, DataBufferSPI_TX_with_PEC);
 
     if (statusSPI != E_OK) {
         return E_NOT_OK;
@@ -2660,6 +3212,92 @@ static STD_RETURN_TYPE_e LTC_TX(uint8_t *Command, uint8_t *DataBufferSPI_TX, uin
     }
 }
 
+/**
+ * @brief   counts a failed SPI transmission for all LTCs of the daisy-chain.
+ *
+ * @param   ltc_state   state of the daisy-chain
+ * @param   statusSPI   result of the SPI function
+ *
+ * @return  statusSPI
+ */
+static STD_RETURN_TYPE_e LTC_ChainSPIStatus(LTC_STATE_s *ltc_state, STD_RETURN_TYPE_e statusSPI) {
+
+    uint16_t i = 0;
+
+    if (statusSPI != E_OK) {
+        for (i=0; i < LTC_N_LTC; i++) {
+            ltc_state->errStatus.errSPICnt[i]++;
+        }
+    }
+    return statusSPI;
+}
+
+
+/**
+ * @brief   sends a dummy byte to wake up the LTC daisy-chain.
+ *
+ * @param   ltc_state   state of the daisy-chain
+ *
+ * @return  E_OK if SPI transmission is OK, E_NOT_OK otherwise
+ */
+static STD_RETURN_TYPE_e LTC_ChainSendWakeUp(LTC_STATE_s *ltc_state) {
+    return LTC_ChainSPIStatus(ltc_state, SPI_Transmit(ltc_state->spiHandle, (uint8_t*)ltc_cmdDummy, 1));
+}
+
+
+/**
+ * @brief   sends a command without data to the LTC daisy-chain.
+ *
+ * @param   ltc_state   state of the daisy-chain
+ * @param   *Command    command with PEC (4 bytes)
+ *
+ * @return  E_OK if SPI transmission is OK, E_NOT_OK otherwise
+ */
+static STD_RETURN_TYPE_e LTC_ChainSendCmd(LTC_STATE_s *ltc_state, const uint8_t *Command) {
+    return LTC_ChainSPIStatus(ltc_state, SPI_Transmit(ltc_state->spiHandle, (uint8_t*)Command, 4));
+}
+
+
+/**
+ * @brief   sends a command and the data for all LTCs to the LTC daisy-chain.
+ *
+ * @param   ltc_state                   state of the daisy-chain
+ * @param   *DataBufferSPI_TX_with_PEC  command and data with PEC, see LTC_TX()
+ *
+ * @return  E_OK if SPI transmission is OK, E_NOT_OK otherwise
+ */
+static STD_RETURN_TYPE_e LTC_ChainSendData(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_TX_with_PEC) {
+    return LTC_ChainSPIStatus(ltc_state, SPI_Transmit(ltc_state->spiHandle, DataBufferSPI_TX_with_PEC, LTC_N_BYTES_FOR_DATA_TRANSMISSION));
+}
+
+
+/**
+ * @brief   sends a command to the LTC daisy-chain and receives the data of all LTCs.
+ *
+ * @param   ltc_state                   state of the daisy-chain
+ * @param   *DataBufferSPI_TX_with_PEC  command with PEC, followed by dummy bytes
+ * @param   *DataBufferSPI_RX_with_PEC  data received from the daisy-chain
+ *
+ * @return  E_OK if SPI transmission is OK, E_NOT_OK otherwise
+ */
+static STD_RETURN_TYPE_e LTC_ChainReceiveData(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_TX_with_PEC, uint8_t *DataBufferSPI_RX_with_PEC) {
+    return LTC_ChainSPIStatus(ltc_state, SPI_TransmitReceive(ltc_state->spiHandle, DataBufferSPI_TX_with_PEC, DataBufferSPI_RX_with_PEC, LTC_N_BYTES_FOR_DATA_TRANSMISSION));
+}
+
+
+/**
+ * @brief   sends the STCOMM command followed by the clock pulses for the I2C communication.
+ *
+ * @param   ltc_state                   state of the daisy-chain
+ * @param   *DataBufferSPI_TX_with_PEC  command with PEC, followed by 9 bytes 0xFF
+ *
+ * @return  E_OK if SPI transmission is OK, E_NOT_OK otherwise
+ */
+static STD_RETURN_TYPE_e LTC_ChainSendI2CCmd(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_TX_with_PEC) {
+    return LTC_ChainSPIStatus(ltc_state, SPI_Transmit(ltc_state->spiHandle, DataBufferSPI_TX_with_PEC, 4+9));
+}
+
+
 /**
  * @brief   configures the data that will be sent to the LTC daisy-chain to configure multiplexer channels.
  *
@@ -2722,13 +3360,17 @@ static void LTC_SetMUXChCommand(uint8_t *DataBufferSPI_TX, uint8_t mux, uint8_t
  *
  * @return       E_OK if SPI transmission is OK, E_NOT_OK otherwise
  */
-static uint8_t LTC_SendEEPROMReadCommand(uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC, uint8_t step) {
+static uint8_t LTC_SendEEPROMReadCommand(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC, uint8_t step) {
 
     STD_RETURN_TYPE_e statusSPI = E_NOT_OK;
 
+    // the address cannot be sent if the slave control data cannot be read
+    if (LTC_SetEEPROMReadCommand(step, DataBufferSPI_TX) != E_OK) {
+        return E_NOT_OK;
+    }
+
     // send WRCOMM to send I2C message to choose channel
-    LTC_SetEEPROMReadCommand(step, DataBufferSPI_TX);
-    statusSPI = LTC_TX((uint8_t*)ltc_cmdWRCOMM, DataBufferSPI_TX, DataBufferSPI_TX_with_PEC);
+    statusSPI = LTC_TX(ltc_state, (uint8_t*)ltc_cmdWRCOMM, DataBufferSPI_TX, DataBufferSPI_TX_with_PEC);
 
     if (statusSPI != E_OK) {
         return E_NOT_OK;
@@ -2746,10 +3388,10 @@ static uint8_t LTC_SendEEPROMReadCommand(uint8_t *DataBufferSPI_TX, uint8_t *Dat
  * @param   *DataBufferSPI_TX      data to be sent to the daisy-chain
  * @param   address                read address (18 bits)
  *
- * @return  void
+ * @return  E_OK if the slave control data was read from the database, E_NOT_OK otherwise
  *
  */
-static void LTC_SetEEPROMReadCommand(uint8_t step, uint8_t *DataBufferSPI_TX) {
+static STD_RETURN_TYPE_e LTC_SetEEPROMReadCommand(uint8_t step, uint8_t *DataBufferSPI_TX) {
 
     uint16_t i = 0;
     uint32_t address = 0;
@@ -2757,7 +3399,9 @@ static void LTC_SetEEPROMReadCommand(uint8_t step, uint8_t *DataBufferSPI_TX) {
     uint8_t address1 = 0;
     uint8_t address2 = 0;
 
-    DB_ReadBlock(&ltc_slave_control, DATA_BLOCK_ID_SLAVE_CONTROL);
+    if (DB_ReadBlock(&ltc_slave_control, DATA_BLOCK_ID_SLAVE_CONTROL) != E_OK) {
+        return E_NOT_OK;
+    }
 
     address = ltc_slave_control.eeprom_read_address_to_use;
 
@@ -2792,6 +3436,8 @@ static void LTC_SetEEPROMReadCommand(uint8_t step, uint8_t *DataBufferSPI_TX) {
 
         }
     }
+
+    return E_OK;
 }
 
 
@@ -2804,14 +3450,17 @@ static void LTC_SetEEPROMReadCommand(uint8_t step, uint8_t *DataBufferSPI_TX) {
  * @return  void
  *
  */
-static void LTC_EEPROMSaveReadValue(uint8_t *rxBuffer) {
+static void LTC_EEPROMSaveReadValue(LTC_STATE_s *ltc_state, uint8_t *rxBuffer) {
 
     uint16_t i = 0;
 
-    DB_ReadBlock(&ltc_slave_control, DATA_BLOCK_ID_SLAVE_CONTROL);
+    // the other values of the slave control data are unknown, the read values are discarded
+    if (DB_ReadBlock(&ltc_slave_control, DATA_BLOCK_ID_SLAVE_CONTROL) != E_OK) {
+        return;
+    }
 
     for (i=0; i < LTC_N_LTC; i++) {
-        ltc_slave_control.eeprom_value_read[i] = (rxBuffer[6+i*8] << 4)|((rxBuffer[7+i*8] >> 4));
+        ltc_slave_control.eeprom_value_read[LTC_MODULE_OFFSET(ltc_state)+i] = (rxBuffer[6+i*8] << 4)|((rxBuffer[7+i*8] >> 4));
     }
 
     ltc_slave_control.eeprom_read_address_last_used = ltc_slave_control.eeprom_read_address_to_use;
@@ -2833,13 +3482,17 @@ static void LTC_EEPROMSaveReadValue(uint8_t *rxBuffer) {
  *
  * @return       E_OK if SPI transmission is OK, E_NOT_OK otherwise
  */
-static uint8_t LTC_SendEEPROMWriteCommand(uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC, uint8_t step) {
+static uint8_t LTC_SendEEPROMWriteCommand(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC, uint8_t step) {
 
     STD_RETURN_TYPE_e statusSPI = E_NOT_OK;
 
+    // address and data cannot be sent if the slave control data cannot be read
+    if (LTC_SetEEPROMWriteCommand(ltc_state, step, DataBufferSPI_TX) != E_OK) {
+        return E_NOT_OK;
+    }
+
     // send WRCOMM to send I2C message to write EEPROM
-    LTC_SetEEPROMWriteCommand(step, DataBufferSPI_TX);
-    statusSPI = LTC_TX((uint8_t*)ltc_cmdWRCOMM, DataBufferSPI_TX, DataBufferSPI_TX_with_PEC);
+    statusSPI = LTC_TX(ltc_state, (uint8_t*)ltc_cmdWRCOMM, DataBufferSPI_TX, DataBufferSPI_TX_with_PEC);
 
     if (statusSPI != E_OK) {
         return E_NOT_OK;
@@ -2857,10 +3510,10 @@ static uint8_t LTC_SendEEPROMWriteCommand(uint8_t *DataBufferSPI_TX, uint8_t *Da
  * @param   *DataBufferSPI_TX      data to be sent to the daisy-chain
  * @param   address                read address (18 bits)
  *
- * @return  void
+ * @return  E_OK if the slave control data was read from the database, E_NOT_OK otherwise
  *
  */
-static void LTC_SetEEPROMWriteCommand(uint8_t step, uint8_t *DataBufferSPI_TX) {
+static STD_RETURN_TYPE_e LTC_SetEEPROMWriteCommand(LTC_STATE_s *ltc_state, uint8_t step, uint8_t *DataBufferSPI_TX) {
 
     uint16_t i = 0;
     uint32_t address = 0;
@@ -2869,7 +3522,9 @@ static void LTC_SetEEPROMWriteCommand(uint8_t step, uint8_t *DataBufferSPI_TX) {
     uint8_t address1 = 0;
     uint8_t address2 = 0;
 
-    DB_ReadBlock(&ltc_slave_control, DATA_BLOCK_ID_SLAVE_CONTROL);
+    if (DB_ReadBlock(&ltc_slave_control, DATA_BLOCK_ID_SLAVE_CONTROL) != E_OK) {
+        return E_NOT_OK;
+    }
 
     address = ltc_slave_control.eeprom_write_address_to_use;
 
@@ -2895,7 +3550,7 @@ static void LTC_SetEEPROMWriteCommand(uint8_t step, uint8_t *DataBufferSPI_TX) {
 
         for (i=0; i < LTC_N_LTC; i++) {
 
-            data = ltc_slave_control.eeprom_value_write[i];
+            data = ltc_slave_control.eeprom_value_write[LTC_MODULE_OFFSET(ltc_state)+i];
 
             DataBufferSPI_TX[0 + i * 6] = LTC_ICOM_BLANK | (data >> 4);        // 0x6 : LTC6804: ICOM START from Master
             DataBufferSPI_TX[1 + i * 6] = LTC_FCOM_MASTER_NACK_STOP | (data << 4);
@@ -2913,6 +3568,7 @@ static void LTC_SetEEPROMWriteCommand(uint8_t step, uint8_t *DataBufferSPI_TX) {
 
     }
 
+    return E_OK;
 }
 
 
@@ -2928,13 +3584,13 @@ static void LTC_SetEEPROMWriteCommand(uint8_t step, uint8_t *DataBufferSPI_TX) {
  *
  * @return       E_OK if SPI transmission is OK, E_NOT_OK otherwise
  */
-static uint8_t LTC_SetMuxChannel(uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC, uint8_t mux, uint8_t channel ) {
+static uint8_t LTC_SetMuxChannel(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC, uint8_t mux, uint8_t channel ) {
 
     STD_RETURN_TYPE_e statusSPI = E_NOT_OK;
 
     // send WRCOMM to send I2C message to choose channel
     LTC_SetMUXChCommand(DataBufferSPI_TX, mux, channel);
-    statusSPI = LTC_TX((uint8_t*)ltc_cmdWRCOMM, DataBufferSPI_TX, DataBufferSPI_TX_with_PEC);
+    statusSPI = LTC_TX(ltc_state, (uint8_t*)ltc_cmdWRCOMM, DataBufferSPI_TX, DataBufferSPI_TX_with_PEC);
 
     if (statusSPI != E_OK) {
         return E_NOT_OK;
@@ -2956,13 +3612,13 @@ static uint8_t LTC_SetMuxChannel(uint8_t *DataBufferSPI_TX, uint8_t *DataBufferS
  *
  * @return       E_OK if SPI transmission is OK, E_NOT_OK otherwise
  */
-static STD_RETURN_TYPE_e LTC_Send_I2C_Command(uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC, uint8_t *cmd_data) {
+static STD_RETURN_TYPE_e LTC_Send_I2C_Command(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC, uint8_t *cmd_data) {
 
     STD_RETURN_TYPE_e statusSPI = E_NOT_OK;
 
     uint16_t i = 0;
 
-    for (i=0; i < BS_NR_OF_MODULES; i++) {
+    for (i=0; i < LTC_NR_OF_MODULES_PER_CHAIN; i++) {
 
         DataBufferSPI_TX[0+i*6] = cmd_data[0];
         DataBufferSPI_TX[1+i*6] = cmd_data[1];
@@ -2975,7 +3631,7 @@ static STD_RETURN_TYPE_e LTC_Send_I2C_Command(uint8_t *DataBufferSPI_TX, uint8_t
     }
 
     // send WRCOMM to send I2C message to choose channel
-    statusSPI = LTC_TX((uint8_t*)ltc_cmdWRCOMM, DataBufferSPI_TX, DataBufferSPI_TX_with_PEC);
+    statusSPI = LTC_TX(ltc_state, (uint8_t*)ltc_cmdWRCOMM, DataBufferSPI_TX, DataBufferSPI_TX_with_PEC);
 
     if (statusSPI != E_OK) {
         return E_NOT_OK;
@@ -2995,20 +3651,23 @@ static STD_RETURN_TYPE_e LTC_Send_I2C_Command(uint8_t *DataBufferSPI_TX, uint8_t
  * @return  void
  *
  */
-static void LTC_TempSensSaveTemp(uint8_t *rxBuffer) {
+static void LTC_TempSensSaveTemp(LTC_STATE_s *ltc_state, uint8_t *rxBuffer) {
 
     uint16_t i = 0;
     uint8_t temp_tmp[2];
     uint16_t val_i = 0;
 
-    DB_ReadBlock(&ltc_slave_control, DATA_BLOCK_ID_SLAVE_CONTROL);
+    // the other values of the slave control data are unknown, the temperatures are discarded
+    if (DB_ReadBlock(&ltc_slave_control, DATA_BLOCK_ID_SLAVE_CONTROL) != E_OK) {
+        return;
+    }
 
     for (i=0; i < LTC_N_LTC; i++) {
         temp_tmp[0] = (rxBuffer[6+i*8] << 4) | ((rxBuffer[7+i*8] >> 4));
         temp_tmp[1] = (rxBuffer[8+i*8] << 4) | ((rxBuffer[9+i*8] >> 4));
         val_i = (temp_tmp[0] << 8) | (temp_tmp[1]);
         val_i = val_i>>8;
-        ltc_slave_control.external_sensor_temperature[i] = val_i;
+        ltc_slave_control.external_sensor_temperature[LTC_MODULE_OFFSET(ltc_state)+i] = val_i;
     }
 
     DB_WriteBlock(&ltc_slave_control, DATA_BLOCK_ID_SLAVE_CONTROL);
@@ -3024,17 +3683,20 @@ static void LTC_TempSensSaveTemp(uint8_t *rxBuffer) {
  *
  * @return       E_OK if SPI transmission is OK, E_NOT_OK otherwise
  */
-static uint8_t LTC_SetPortExpander(uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC ) {
+static uint8_t LTC_SetPortExpander(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC ) {
 
     STD_RETURN_TYPE_e statusSPI = E_NOT_OK;
 
     uint16_t i = 0;
     uint8_t output_data = 0;
 
-    DB_ReadBlock(&ltc_slave_control, DATA_BLOCK_ID_SLAVE_CONTROL);
+    // the output values cannot be sent if the slave control data cannot be read
+    if (DB_ReadBlock(&ltc_slave_control, DATA_BLOCK_ID_SLAVE_CONTROL) != E_OK) {
+        return E_NOT_OK;
+    }
 
-    for (i=0; i < BS_NR_OF_MODULES; i++) {
-        output_data = ltc_slave_control.io_value_out[BS_NR_OF_MODULES-1-i];
+    for (i=0; i < LTC_NR_OF_MODULES_PER_CHAIN; i++) {
+        output_data = ltc_slave_control.io_value_out[LTC_MODULE_OFFSET(ltc_state)+LTC_NR_OF_MODULES_PER_CHAIN-1-i];
 
         DataBufferSPI_TX[0+i*6] = LTC_ICOM_START | 0x04;     // 6: ICOM0 start condition, 4: upper nibble of PCA8574 address
         DataBufferSPI_TX[1+i*6] = 0 | LTC_FCOM_MASTER_NACK;  // 0: lower nibble of PCA8574 address + R/W bit, 8: FCOM0 master NACK
@@ -3047,7 +3709,7 @@ static uint8_t LTC_SetPortExpander(uint8_t *DataBufferSPI_TX, uint8_t *DataBuffe
     }
 
     // send WRCOMM to send I2C message to choose channel
-    statusSPI = LTC_TX((uint8_t*)ltc_cmdWRCOMM, DataBufferSPI_TX, DataBufferSPI_TX_with_PEC);
+    statusSPI = LTC_TX(ltc_state, (uint8_t*)ltc_cmdWRCOMM, DataBufferSPI_TX, DataBufferSPI_TX_with_PEC);
 
     if (statusSPI != E_OK) {
         return E_NOT_OK;
@@ -3066,16 +3728,19 @@ static uint8_t LTC_SetPortExpander(uint8_t *DataBufferSPI_TX, uint8_t *DataBuffe
  * @return  void
  *
  */
-static void LTC_PortExpanderSaveValues(uint8_t *rxBuffer) {
+static void LTC_PortExpanderSaveValues(LTC_STATE_s *ltc_state, uint8_t *rxBuffer) {
     uint16_t i = 0;
     uint8_t val_i;
 
-    DB_ReadBlock(&ltc_slave_control, DATA_BLOCK_ID_SLAVE_CONTROL);
+    // the other values of the slave control data are unknown, the input values are discarded
+    if (DB_ReadBlock(&ltc_slave_control, DATA_BLOCK_ID_SLAVE_CONTROL) != E_OK) {
+        return;
+    }
 
     /* extract data */
     for (i=0; i < LTC_N_LTC; i++) {
         val_i = (rxBuffer[6+i*8] << 4) | ((rxBuffer[7+i*8] >> 4));
-        ltc_slave_control.io_value_in[i] = val_i;
+        ltc_slave_control.io_value_in[LTC_MODULE_OFFSET(ltc_state)+i] = val_i;
     }
 
     DB_WriteBlock(&ltc_slave_control, DATA_BLOCK_ID_SLAVE_CONTROL);
@@ -3093,7 +3758,7 @@ static void LTC_PortExpanderSaveValues(uint8_t *rxBuffer) {
  * @return  statusSPI                   E_OK if clock pulses were sent correctly by SPI, E_NOT_OK otherwise
  *
  */
-static STD_RETURN_TYPE_e LTC_I2CClock(uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC) {
+static STD_RETURN_TYPE_e LTC_I2CClock(LTC_STATE_s *ltc_state, uint8_t *DataBufferSPI_TX, uint8_t *DataBufferSPI_TX_with_PEC) {
 
     uint16_t i = 0;
     STD_RETURN_TYPE_e statusSPI = E_NOT_OK;
@@ -3107,7 +3772,7 @@ static STD_RETURN_TYPE_e LTC_I2CClock(uint8_t *DataBufferSPI_TX, uint8_t *DataBu
     DataBufferSPI_TX_with_PEC[2] = ltc_cmdSTCOMM[2];
     DataBufferSPI_TX_with_PEC[3] = ltc_cmdSTCOMM[3];
 
-    statusSPI = LTC_SendI2CCmd(DataBufferSPI_TX_with_PEC);
+    statusSPI = LTC_ChainSendI2CCmd(ltc_state, DataBufferSPI_TX_with_PEC);
 
     return statusSPI;
 }
@@ -3121,30 +3786,30 @@ static STD_RETURN_TYPE_e LTC_I2CClock(uint8_t *DataBufferSPI_TX, uint8_t *DataBu
  *
  * @return    frequency of the SPI clock
  */
-static uint32_t LTC_GetSPIClock(void) {
+static uint32_t LTC_GetSPIClock(LTC_STATE_s *ltc_state) {
 
     uint32_t SPI_Clock = 0;
 
-    if (LTC_SPI_INSTANCE == SPI2 || LTC_SPI_INSTANCE == SPI3) {
+    if (ltc_state->spiHandle->Instance == SPI2 || ltc_state->spiHandle->Instance == SPI3) {
         // SPI2 and SPI3 are connected to APB1 (PCLK1)
-        // The prescaler setup bits LTC_SPI_PRESCALER corresponds to the bits 5:3 in the SPI_CR1 register
+        // The prescaler setup bits Init.BaudRatePrescaler correspond to the bits 5:3 in the SPI_CR1 register
         // Reference manual p.909
         // The shift by 3 puts the bits 5:3 to the first position
         // Division are made by powers of 2 which corresponds to shifting to the right
         // Then 0 corresponds to divide by 2, 1 corresponds to divide by 4... so 1 has to be added to the value of the configuration bits
 
-        SPI_Clock = HAL_RCC_GetPCLK1Freq()>>( (LTC_SPI_PRESCALER>>3)+1);
+        SPI_Clock = HAL_RCC_GetPCLK1Freq()>>( (ltc_state->spiHandle->Init.BaudRatePrescaler>>3)+1);
     }
 
-    if (LTC_SPI_INSTANCE == SPI1 || LTC_SPI_INSTANCE == SPI4 || LTC_SPI_INSTANCE == SPI5 || LTC_SPI_INSTANCE == SPI6) {
+    if (ltc_state->spiHandle->Instance == SPI1 || ltc_state->spiHandle->Instance == SPI4 || ltc_state->spiHandle->Instance == SPI5 || ltc_state->spiHandle->Instance == SPI6) {
         // SPI1, SPI4, SPI5 and SPI6 are connected to APB2 (PCLK2)
-        // The prescaler setup bits LTC_SPI_PRESCALER corresponds to the bits 5:3 in the SPI_CR1 register
+        // The prescaler setup bits Init.BaudRatePrescaler correspond to the bits 5:3 in the SPI_CR1 register
         // Reference manual p.909
         // The shift by 3 puts the bits 5:3 to the first position
         // Division are made by powers of 2 which corresponds to shifting to the right
         // Then 0 corresponds to divide by 2, 1 corresponds to divide by 4... so 1 has to be added to the value of the configuration bits
 
-        SPI_Clock = HAL_RCC_GetPCLK2Freq()>>( (LTC_SPI_PRESCALER>>3)+1);
+        SPI_Clock = HAL_RCC_GetPCLK2Freq()>>( (ltc_state->spiHandle->Init.BaudRatePrescaler>>3)+1);
     }
 
     return SPI_Clock;
@@ -3161,30 +3826,30 @@ static uint32_t LTC_GetSPIClock(void) {
  * @return  void
  *
  */
-static void LTC_SetTransferTimes(void) {
+static void LTC_SetTransferTimes(LTC_STATE_s *ltc_state) {
 
     uint32_t transferTime_us = 0;
     uint32_t SPI_Clock = 0;
 
-    SPI_Clock = LTC_GetSPIClock();
+    SPI_Clock = LTC_GetSPIClock(ltc_state);
 
     // Transmission of a command and data
     // Multiplication by 1000*1000 to get us
     transferTime_us = ((LTC_N_BYTES_FOR_DATA_TRANSMISSION)*8*1000*1000)/(SPI_Clock);
     transferTime_us = transferTime_us + SPI_WAKEUP_WAIT_TIME;
-    ltc_state.commandDataTransferTime = (transferTime_us/1000)+1;
+    ltc_state->commandDataTransferTime = LTC_TRANSFERTIME_MS(transferTime_us);
 
     // Transmission of a command
     // Multiplication by 1000*1000 to get us
     transferTime_us = ((4)*8*1000*1000)/(SPI_Clock);
     transferTime_us = transferTime_us + SPI_WAKEUP_WAIT_TIME;
-    ltc_state.commandTransferTime = (transferTime_us/1000)+1;
+    ltc_state->commandTransferTime = LTC_TRANSFERTIME_MS(transferTime_us);
 
     // Transmission of a command + 9 clocks
     // Multiplication by 1000*1000 to get us
     transferTime_us = ((4+9)*8*1000*1000)/(SPI_Clock);
     transferTime_us = transferTime_us + SPI_WAKEUP_WAIT_TIME;
-    ltc_state.gpioClocksTransferTime = (transferTime_us/1000)+1;
+    ltc_state->gpioClocksTransferTime = LTC_TRANSFERTIME_MS(transferTime_us);
 }
 
 
@@ -3199,14 +3864,14 @@ static void LTC_SetTransferTimes(void) {
  *
  * @return              result of the state request that was made, taken from LTC_RETURN_TYPE_e
  */
-static LTC_RETURN_TYPE_e LTC_CheckStateRequest(LTC_STATE_REQUEST_e statereq) {
+static LTC_RETURN_TYPE_e LTC_CheckStateRequest(LTC_STATE_s *ltc_state, LTC_STATE_REQUEST_e statereq) {
 
-    if (ltc_state.statereq == LTC_STATE_NO_REQUEST) {
+    if (ltc_state->statereq == LTC_STATE_NO_REQUEST) {
 
         // init only allowed from the uninitialized state
         if (statereq == LTC_STATE_INIT_REQUEST) {
 
-            if (ltc_state.state == LTC_STATEMACH_UNINITIALIZED) {
+            if (ltc_state->state == LTC_STATEMACH_UNINITIALIZED) {
                 return LTC_OK;
             } else {
                 return LTC_ALREADY_INITIALIZED;
@@ -3232,7 +3897,7 @@ extern uint8_t LTC_IsFirstMeasurementCycleFinished(void) {
     uint8_t retval = FALSE;
 
     OS_TaskEnter_Critical();
-    retval    = ltc_state.first_measurement_made;
+    retval    = ltc_states[0].first_measurement_made;
     OS_TaskExit_Critical();
 
     return (retval);
@@ -3245,8 +3910,12 @@ extern uint8_t LTC_IsFirstMeasurementCycleFinished(void) {
  *
  */
 extern void LTC_SetFirstMeasurementCycleFinished(void) {
+    uint8_t i = 0;
+
     OS_TaskEnter_Critical();
-    ltc_state.first_measurement_made = TRUE;
+    for (i=0; i < LTC_NR_OF_CHAINS; i++) {
+        ltc_states[i].first_measurement_made = TRUE;
+    }
     OS_TaskExit_Critical();
 }
 
@@ -3260,8 +3929,14 @@ extern void LTC_SetFirstMeasurementCycleFinished(void) {
  */
 extern STD_RETURN_TYPE_e LTC_GetMuxSequenceState(void) {
     STD_RETURN_TYPE_e retval = FALSE;
+    uint8_t i = 0;
 
-    retval    = ltc_state.ltc_muxcycle_finished;
+    retval    = ltc_states[0].ltc_muxcycle_finished;
+    for (i=1; i < LTC_NR_OF_CHAINS; i++) {
+        if (ltc_states[i].ltc_muxcycle_finished != E_OK) {
+            retval    = ltc_states[i].ltc_muxcycle_finished;
+        }
+    }
 
     return (retval);
 }
@@ -37,6 +37,7 @@
 /*================== Includes =============================================*/
 #include "ltc_cfg.h"
 #include "ltc_defs.h"
+#include "stat.h"
 
 /*================== Macros and Definitions ===============================*/
 
@@ -54,6 +55,17 @@ typedef struct {
     uint8_t mux3;                               /*!<    */
 } LTC_ERRORTABLE_s;
 
+/**
+ * communication error statistics of one LTC, see LTC_GetDeviceErrors()
+ */
+typedef struct {
+    uint32_t errPECCnt;                 /*!< number of register groups received with PEC error            */
+    uint32_t errSPICnt;                 /*!< number of failed SPI transmissions to the daisy-chain of the LTC */
+    uint32_t errRetryCnt;               /*!< number of register groups re-read because of a PEC error     */
+    uint16_t errConsecutivePECCnt;      /*!< PEC errors since the last register group with valid PEC      */
+    uint32_t lastValidTimestamp;        /*!< MCU_GetTimeStamp() of the last valid PEC, 0 if none          */
+} LTC_DEVICE_ERRORS_s;
+
 /*================== Constant and Variable Definitions ====================*/
 
 /*================== Function Prototypes ==================================*/
@@ -62,12 +74,41 @@ typedef struct {
  * @brief   trigger function for the LTC driver state machine.
  *
  * This function contains the sequence of events in the LTC state machine.
- * It must be called time-triggered, every 1ms.
+ * Each state sets the time it needs before the next state is processed, the
+ * state machine only proceeds once this deadline elapsed or, for states
+ * waiting for an SPI transfer, once the transfer is complete.
+ * It can be called time-triggered every 1ms or after LTC_GetTimeToNextStep().
+ * With several daisy-chains (LTC_NR_OF_CHAINS), the state machine of every
+ * daisy-chain is processed in each call.
  *
  * @return  void
  */
 extern void LTC_Trigger(void);
 
+/**
+ * @brief   gets the time until the LTC state machine processes the next state.
+ *
+ * The calling task can sleep for this time, e.g. with ulTaskNotifyTake() to be
+ * woken early by the end of an SPI burst (see LTC_SetNotifiedTask()), before
+ * calling LTC_Trigger() again.
+ *
+ * @return  time in ms until the deadline of the current state, 0 if it elapsed
+ */
+extern uint32_t LTC_GetTimeToNextStep(void);
+
+/**
+ * @brief   sets the task that is notified when a burst of SPI transfers is complete.
+ *
+ * The task calling LTC_Trigger() can wait with ulTaskNotifyTake() for at most
+ * 1ms instead of a fixed delay, so the state machine continues right after
+ * the cell voltages are read.
+ *
+ * @param   taskhandle  FreeRTOS task handle, NULL_PTR if no task is notified
+ *
+ * @return  void
+ */
+extern void LTC_SetNotifiedTask(void *taskhandle);
+
 /**
  * @brief   sets the current state request of the state variable ltc_state.
  *
@@ -94,6 +135,32 @@ extern STD_RETURN_TYPE_e LTC_GetMuxSequenceState(void);
 extern void LTC_SaveAllGPIOs(void);
 extern void LTC_SaveVoltages(void);
 extern void LTC_SaveTemperatures(void);
+
+/**
+ * @brief   gets the statistics of the last cell voltage measurement.
+ *
+ * Besides min, max and mean, which are also written to the database, the statistics
+ * contain the standard deviation of the cell voltages, e.g., as input for the
+ * balancing decision.
+ *
+ * @param   stats   where the statistics are copied to
+ *
+ * @return  E_OK if the statistics were copied, E_NOT_OK if stats is NULL_PTR
+ */
+extern STD_RETURN_TYPE_e LTC_GetCellVoltageStatistics(STAT_U16_RESULT_s *stats);
+
+/**
+ * @brief   gets the communication error statistics of one LTC.
+ *
+ * The statistics are counted since startup for every LTC, the index is the
+ * module number in the database (modules of the daisy-chains one after the other).
+ *
+ * @param   module  index of the LTC, 0 ... BS_NR_OF_MODULES-1
+ * @param   errors  where the statistics are copied to
+ *
+ * @return  E_OK if the statistics were copied, E_NOT_OK if module is out of range or errors is NULL_PTR
+ */
+extern STD_RETURN_TYPE_e LTC_GetDeviceErrors(uint16_t module, LTC_DEVICE_ERRORS_s *errors);
 extern LTC_STATE_REQUEST_e LTC_GetStateRequest(void);
 extern LTC_STATEMACH_e LTC_GetState(void);
 
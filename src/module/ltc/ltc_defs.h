@@ -398,6 +398,16 @@ typedef struct {
     LTC_MUX_CH_CFG_s *seqptr;   /*!< pointer to the multiplexer sequence   */
 } LTC_MUX_SEQUENZ_s;
 
+/**
+ * state of a step of the multiplexer sequence for the adaptive scheduling of the
+ * temperature measurements
+ */
+typedef struct {
+    uint8_t weight;         /*!< urgency of the step, 0 means no additional reads           */
+    uint8_t credit;         /*!< weight accumulated since the step was read last            */
+    uint32_t timestamp;     /*!< time stamp of the last read of the step, 0 if not read yet */
+} LTC_MUX_ADAPTIVE_STEP_s;
+
 /**
  * This struct contains pointer to used data buffers
  */
@@ -425,11 +435,14 @@ typedef struct {
 typedef struct {
     uint32_t * errPECCnt;       // array length: Number of used LTCs
     uint32_t * errSPICnt;       // array length: Number of used LTCs
+    uint32_t * errRetryCnt;     // array length: Number of used LTCs, register groups re-read because of a PEC error of the LTC
+    uint16_t * errConsecutivePECCnt;    // array length: Number of used LTCs, PEC errors since the last valid PEC
+    uint32_t * lastValidTimestamp;      // array length: Number of used LTCs, time stamp of the last valid PEC
     uint8_t * ltcStatus;        // array length: Number of used LTCs
-    uint8_t errPECRetryCnt;
+    uint8_t errPECRetryCnt;     // re-reads of the cell voltage register groups in the current measurement cycle
     uint8_t errSPIRetryCnt;
     uint8_t errOccurred;
-    uint32_t nrOfConsecutiveErrors;
+    uint32_t nrOfConsecutiveErrors;     // consecutive measurement cycles with cell voltage register groups that could not be read
 }LTC_ERROR_s;
 
 /**
@@ -491,6 +504,7 @@ typedef struct {
     LTC_MUX_CH_CFG_s *muxmeas_seqendptr;    /*!< point to the end of the multiplexer sequence                                                */     // pointer to ending point of sequence
     uint8_t muxmeas_nr_end;                 /*!< number of multiplexer channels that have to be measured                                     */     // end number of sequence, where measurement is finished
     SPI_HandleTypeDef *spiHandle;           /*!< pointer to SPI Handle the LTC is connected to                                               */
+    uint8_t spiBusID;                       /*!< chip select of the daisy-chain on spiHandle, see SPI_SetCS()                               */
     LTC_DATAPTR_s ltcData;                  /*!< contains pointer to the local data buffer                                                   */
     uint8_t instanceID;                     /*!< number to distinguish between different ltc states, starting with 0,1,2,3....8              */
     uint8_t nrBatcellsPerModule;            /*!< number of cells per module                                                                  */
@@ -506,6 +520,7 @@ typedef struct {
     STD_RETURN_TYPE_e ltc_muxcycle_finished;/*!< flag that indictes if the measurement sequence of the multiplexers is finished                         */
     STD_RETURN_TYPE_e check_spi_flag;       /*!< indicates if interrupt flag or timer must be considered*/
     STD_RETURN_TYPE_e balance_control_done; /*!< indicates if balance control was done*/
+    uint32_t nextStepTime;                  /*!< time stamp in ms at which the state machine processes the next state */
 } LTC_STATE_s;
 
 /*================== Function Prototypes ==================================*/
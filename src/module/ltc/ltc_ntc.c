@@ -0,0 +1,67 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+
+/**
+ * @file    ltc_ntc.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup DRIVERS
+ * @prefix  LTC
+ *
+ * @brief   Conversion of the multiplexed NTC voltages to temperatures
+ *
+ * The look-up tables in ltc_ntc_lut.h are generated with ltc_ntc_lut.py, which also
+ * reports the deviation of the interpolated result from the NTC characteristic:
+ *
+ *      python ltc_ntc_lut.py --report
+ *
+ */
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "ltc_ntc.h"
+
+#include "ltc_ntc_lut.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+/*================== Function Implementations =============================*/
+
+int16_t LTC_NTC_RawToDeciCelsius(uint16_t raw) {
+    uint16_t index = raw >> LTC_NTC_LUT_SHIFT;
+    int32_t fraction = 0;
+    int32_t difference = 0;
+
+    if (index >= LTC_NTC_LUT_SIZE-1) {
+        return ltc_ntc_lut[LTC_NTC_LUT_SIZE-1];
+    }
+
+    fraction = raw & ((1u << LTC_NTC_LUT_SHIFT) - 1);
+    difference = ltc_ntc_lut[index+1] - ltc_ntc_lut[index];
+
+    return (int16_t)(ltc_ntc_lut[index] + ((difference*fraction + (1 << (LTC_NTC_LUT_SHIFT-1))) >> LTC_NTC_LUT_SHIFT));
+}
@@ -0,0 +1,77 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+
+/**
+ * @file    ltc_ntc.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup DRIVERS
+ * @prefix  LTC
+ *
+ * @brief   Header for the conversion of the multiplexed NTC voltages to temperatures
+ *
+ */
+
+#ifndef LTC_NTC_H_
+#define LTC_NTC_H_
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "ltc_cfg.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * NTC type of the multiplexed temperature sensors, one of the types in ltc_ntc_lut.h.
+ * Can be overridden in ltc_cfg.h, the tables are generated with ltc_ntc_lut.py.
+ */
+#ifndef LTC_NTC_TYPE
+#define LTC_NTC_TYPE                        LTC_NTC_EPCOS_B57861S0103F045
+#endif
+
+/**
+ * converts a temperature in 0.1 degC to degC, rounded to the nearest degC
+ */
+#define LTC_NTC_DECICELSIUS_TO_CELSIUS(t)   ((int16_t)((t) >= 0 ? ((t)+5)/10 : ((t)-5)/10))
+
+/*================== Constant and Variable Definitions ====================*/
+
+
+/*================== Function Prototypes ==================================*/
+
+/**
+ * @brief   converts a raw GPIO value of the LTC (100uV per LSB) to a temperature.
+ *
+ * The NTC characteristic selected with LTC_NTC_TYPE is interpolated linearly between
+ * the breakpoints of a look-up table, integer arithmetic only. Raw values beyond the
+ * table return the temperature of the last breakpoint.
+ *
+ * @param   raw     raw value of the GPIO measurement
+ *
+ * @return  temperature in 0.1 degC
+ */
+extern int16_t LTC_NTC_RawToDeciCelsius(uint16_t raw);
+
+/*================== Function Implementations =============================*/
+
+#endif /* LTC_NTC_H_ */
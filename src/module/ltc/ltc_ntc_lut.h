@@ -0,0 +1,81 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    ltc_ntc_lut.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup DRIVERS
+ * @prefix  LTC
+ *
+ * @brief   NTC look-up tables, generated by ltc_ntc_lut.py, do not edit
+ *
+ * Temperatures in 0.1 degC at raw GPIO codes i*2^LTC_NTC_LUT_SHIFT.
+ * Only included by ltc_ntc.c, the table is selected with LTC_NTC_TYPE.
+ */
+
+#ifndef LTC_NTC_LUT_H_
+#define LTC_NTC_LUT_H_
+
+#define LTC_NTC_EPCOS_B57861S0103F045            0
+#define LTC_NTC_MURATA_NCP18XH103F03RB           1
+
+#define LTC_NTC_LUT_SHIFT                        8
+
+#if LTC_NTC_TYPE == LTC_NTC_EPCOS_B57861S0103F045
+#define LTC_NTC_LUT_SIZE                         119
+static const int16_t ltc_ntc_lut[LTC_NTC_LUT_SIZE] = {
+     1306,  1253,  1202,  1155,  1110,  1068,  1028,   990,   954,   921,
+      889,   859,   831,   804,   778,   755,   732,   710,   690,   671,
+      653,   635,   619,   603,   588,   574,   560,   547,   534,   522,
+      510,   499,   488,   477,   467,   457,   447,   437,   428,   418,
+      409,   400,   391,   382,   373,   365,   356,   347,   339,   330,
+      322,   313,   305,   296,   288,   280,   271,   263,   255,   246,
+      238,   230,   222,   214,   206,   198,   190,   182,   174,   166,
+      158,   150,   143,   135,   127,   120,   112,   104,    97,    89,
+       82,    74,    66,    59,    51,    43,    35,    27,    19,    10,
+        1,    -7,   -17,   -26,   -36,   -46,   -57,   -68,   -80,   -92,
+     -105,  -119,  -133,  -148,  -165,  -182,  -200,  -219,  -240,  -262,
+     -285,  -310,  -336,  -364,  -394,  -426,  -459,  -495,  -533,
+};
+
+#elif LTC_NTC_TYPE == LTC_NTC_MURATA_NCP18XH103F03RB
+#define LTC_NTC_LUT_SIZE                         119
+static const int16_t ltc_ntc_lut[LTC_NTC_LUT_SIZE] = {
+     1250,  1250,  1250,  1250,  1250,  1250,  1250,  1208,  1143,  1088,
+     1039,   995,   956,   920,   888,   857,   829,   803,   778,   755,
+      733,   712,   692,   673,   655,   638,   621,   605,   589,   574,
+      560,   546,   532,   518,   505,   493,   480,   468,   456,   445,
+      434,   422,   411,   401,   390,   380,   369,   359,   349,   340,
+      330,   320,   311,   301,   292,   283,   273,   264,   255,   246,
+      237,   229,   220,   211,   202,   193,   185,   176,   167,   158,
+      150,   141,   132,   124,   115,   106,    97,    88,    79,    70,
+       61,    52,    43,    34,    24,    15,     5,    -5,   -14,   -25,
+      -35,   -45,   -56,   -67,   -78,   -89,  -101,  -113,  -125,  -138,
+     -151,  -165,  -179,  -194,  -209,  -226,  -244,  -262,  -282,  -304,
+     -328,  -355,  -386,  -400,  -400,  -400,  -400,  -400,  -400,
+};
+#else
+#error "unknown LTC_NTC_TYPE"
+#endif
+
+#endif /* LTC_NTC_LUT_H_ */
@@ -0,0 +1,242 @@
+# @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der
+#   angewandten Forschung e.V. All rights reserved.
+#
+# BSD 3-Clause License
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+# 1.  Redistributions of source code must retain the above copyright notice,
+#     this list of conditions and the following disclaimer.
+# 2.  Redistributions in binary form must reproduce the above copyright notice,
+#     this list of conditions and the following disclaimer in the documentation
+#     and/or other materials provided with the distribution.
+# 3.  Neither the name of the copyright holder nor the names of its
+#     contributors may be used to endorse or promote products derived from this
+#     software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+#
+# We kindly request you to use one or more of the following phrases to refer to
+# foxBMS in your hardware, software, documentation or advertising materials:
+#
+# &Prime;This product uses parts of foxBMS&reg;&Prime;
+#
+# &Prime;This product includes parts of foxBMS&reg;&Prime;
+#
+# &Prime;This product is derived from foxBMS&reg;&Prime;
+
+
+"""Generator for the NTC look-up tables of the LTC driver.
+location of this script:
+    /src/module/ltc/ltc_ntc_lut.py
+
+The LTC measures the voltage of the NTC voltage dividers on GPIO1 with
+100uV per LSB. For every NTC type below, this script samples the
+characteristic of the sensor at raw codes that are multiples of
+2^LUT_SHIFT and writes the temperatures in 0.1 degC as int16_t tables to
+ltc_ntc_lut.h. LTC_NTC_RawToDeciCelsius() interpolates linearly between
+the breakpoints with integer arithmetic only.
+
+usage:
+    python ltc_ntc_lut.py [--shift N] [--report] [--output FILE]
+
+--report prints the maximum and mean deviation of the interpolated
+fixed-point result from the characteristic for every raw code up to
+raw_max of the NTC type.
+"""
+
+import argparse
+import math
+import os
+
+#: LSB of the raw GPIO value in V
+RAW_LSB = 100e-6
+
+#: default distance of the breakpoints as power of two of raw codes
+LUT_SHIFT = 8
+
+
+#: license header of the generated C header
+LICENSE_HEADER = """\
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+"""
+
+
+def poly_epcos_b57861s0103f045(v_adc):
+    """5th grade polynomial for EPCOS B57861S0103F045 NTC-Thermistor, 10 kOhm,
+    Series B57861S, 10 kOhm pull-up to VREF2 (3V)"""
+    return (-6.2765 * v_adc**5 + 49.0397 * v_adc**4 - 151.3602 * v_adc**3 +
+            233.2521 * v_adc**2 - 213.4588 * v_adc + 130.5822)
+
+
+def beta_model(r25, beta, r_pullup, v_ref):
+    """returns the characteristic of an NTC to ground with a pull-up
+    resistor to v_ref, described by the beta model"""
+    def temperature(v_adc):
+        if v_adc <= 0.0:
+            return float('inf')
+        if v_adc >= v_ref:
+            return float('-inf')
+        r_ntc = r_pullup * v_adc / (v_ref - v_adc)
+        return 1.0 / (1.0 / 298.15 + math.log(r_ntc / r25) / beta) - 273.15
+    return temperature
+
+
+#: NTC types: name of the C define, characteristic (V -> degC),
+#: raw code range and temperature range the table is clamped to
+NTC_TYPES = [
+    {
+        'name': 'LTC_NTC_EPCOS_B57861S0103F045',
+        'function': poly_epcos_b57861s0103f045,
+        'raw_max': 30000,
+        't_min': -55.0,
+        't_max': 135.0,
+    },
+    {
+        'name': 'LTC_NTC_MURATA_NCP18XH103F03RB',
+        'function': beta_model(10e3, 3380.0, 10e3, 3.0),
+        'raw_max': 30000,
+        't_min': -40.0,
+        't_max': 125.0,
+    },
+]
+
+
+def characteristic(ntc, raw):
+    """temperature of the characteristic in degC, clamped to the range of the NTC type"""
+    temperature = ntc['function'](raw * RAW_LSB)
+    return min(max(temperature, ntc['t_min']), ntc['t_max'])
+
+
+def make_table(ntc, shift):
+    """breakpoints of the table in 0.1 degC"""
+    size = (ntc['raw_max'] + (1 << shift) - 1) // (1 << shift) + 1
+    table = [int(round(characteristic(ntc, i << shift) * 10)) for i in range(size)]
+    for i in range(1, size):
+        if table[i] > table[i - 1]:
+            raise ValueError('%s is not monotonic at raw code %d' % (ntc['name'], i << shift))
+    return table
+
+
+def interpolate(table, shift, raw):
+    """bit exact model of LTC_NTC_RawToDeciCelsius()"""
+    index = raw >> shift
+    if index >= len(table) - 1:
+        return table[-1]
+    fraction = raw & ((1 << shift) - 1)
+    return table[index] + (((table[index + 1] - table[index]) * fraction + (1 << (shift - 1))) >> shift)
+
+
+def report(ntc, table, shift):
+    """deviation of the fixed-point result from the characteristic. Segments
+    that end at a breakpoint clamped to t_min or t_max are reported separately,
+    the kink of the clamped characteristic is not resolved by the table."""
+    errors = {True: [0.0, 0, 0.0, 0], False: [0.0, 0, 0.0, 0]}
+    for raw in range(ntc['raw_max'] + 1):
+        index = min(raw >> shift, len(table) - 2)
+        clamped = any(characteristic(ntc, i << shift) in (ntc['t_min'], ntc['t_max']) for i in (index, index + 1))
+        error = abs(interpolate(table, shift, raw) / 10.0 - characteristic(ntc, raw))
+        entry = errors[clamped]
+        if error > entry[0]:
+            entry[0] = error
+            entry[1] = raw
+        entry[2] += error
+        entry[3] += 1
+    print('%s: %d breakpoints every %d raw codes (%.1f mV), %d bytes' %
+          (ntc['name'], len(table), 1 << shift, (1 << shift) * RAW_LSB * 1000, 2 * len(table)))
+    for clamped, text in ((False, 'in range'), (True, 'clamped segments')):
+        max_error, max_error_raw, sum_error, count = errors[clamped]
+        if count > 0:
+            print('    %-16s max deviation %.3f degC at raw code %d (%.4f V), mean deviation %.3f degC, %d raw codes' %
+                  (text, max_error, max_error_raw, max_error_raw * RAW_LSB, sum_error / count, count))
+
+
+def write_header(filename, tables, shift):
+    """writes the tables as C header"""
+    lines = LICENSE_HEADER.splitlines()
+    lines.append('')
+    lines.append('/**')
+    lines.append(' * @file    ltc_ntc_lut.h')
+    lines.append(' * @author  foxBMS Team')
+    lines.append(' * @date    18.10.2026 (date of creation)')
+    lines.append(' * @ingroup DRIVERS')
+    lines.append(' * @prefix  LTC')
+    lines.append(' *')
+    lines.append(' * @brief   NTC look-up tables, generated by ltc_ntc_lut.py, do not edit')
+    lines.append(' *')
+    lines.append(' * Temperatures in 0.1 degC at raw GPIO codes i*2^LTC_NTC_LUT_SHIFT.')
+    lines.append(' * Only included by ltc_ntc.c, the table is selected with LTC_NTC_TYPE.')
+    lines.append(' */')
+    lines.append('')
+    lines.append('#ifndef LTC_NTC_LUT_H_')
+    lines.append('#define LTC_NTC_LUT_H_')
+    lines.append('')
+    for number, (ntc, table) in enumerate(tables):
+        lines.append('#define %-40s %d' % (ntc['name'], number))
+    lines.append('')
+    lines.append('#define LTC_NTC_LUT_SHIFT                        %d' % shift)
+    for number, (ntc, table) in enumerate(tables):
+        lines.append('')
+        lines.append('%s LTC_NTC_TYPE == %s' % ('#if' if number == 0 else '#elif', ntc['name']))
+        lines.append('#define LTC_NTC_LUT_SIZE                         %d' % len(table))
+        lines.append('static const int16_t ltc_ntc_lut[LTC_NTC_LUT_SIZE] = {')
+        for i in range(0, len(table), 10):
+            lines.append('    ' + ' '.join('%5d,' % value for value in table[i:i + 10]))
+        lines.append('};')
+    lines.append('#else')
+    lines.append('#error "unknown LTC_NTC_TYPE"')
+    lines.append('#endif')
+    lines.append('')
+    lines.append('#endif /* LTC_NTC_LUT_H_ */')
+    with open(filename, 'w') as f:
+        f.write('\n'.join(lines) + '\n')
+
+
+def main():
+    parser = argparse.ArgumentParser(description='generates the NTC look-up tables of the LTC driver')
+    parser.add_argument('--shift', type=int, default=LUT_SHIFT,
+                        help='distance of the breakpoints as power of two of raw codes')
+    parser.add_argument('--report', action='store_true',
+                        help='print the deviation of the tables from the characteristics')
+    parser.add_argument('--output', default=os.path.join(os.path.dirname(os.path.abspath(__file__)), 'ltc_ntc_lut.h'),
+                        help='generated header')
+    args = parser.parse_args()
+
+    tables = [(ntc, make_table(ntc, args.shift)) for ntc in NTC_TYPES]
+    write_header(args.output, tables, args.shift)
+    if args.report:
+        for ntc, table in tables:
+            report(ntc, table, args.shift)
+
+
+if __name__ == '__main__':
+    main()
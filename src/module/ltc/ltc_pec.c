@@ -77,6 +77,51 @@ Copyright 2013 Linear Technology Corp. (LTC)
 
 /*================== Constant and Variable Definitions ====================*/
 
+/*
+    Pre computed table to process two bytes per iteration (slice-by-2)
+
+    The CRC is linear, so the remainder after two bytes d0, d1 is
+    crc15Table2[a0] ^ crc15Table[a1] with the two independent addresses
+    a0 = (remainder >> 7) ^ d0 and a1 = (remainder << 1) ^ d1 (8 bit each).
+    The table is generated from crc15Table with:
+
+    crc15Table2[i] = (crc15Table[i] << 8) ^ crc15Table[(crc15Table[i] >> 7) & 0xFF]
+*/
+static const uint16_t crc15Table2[256] = {  // !<precomputed CRC15 Table for the first byte of a byte pair
+    0x0000, 0xC426, 0x4DD5, 0x89F3, 0x5E33, 0x9A15, 0x13E6, 0xD7C0,
+    0xF9FF, 0x3DD9, 0xB42A, 0x700C, 0xA7CC, 0x63EA, 0xEA19, 0x2E3F,
+    0x3667, 0xF241, 0x7BB2, 0xBF94, 0x6854, 0xAC72, 0x2581, 0xE1A7,
+    0xCF98, 0x0BBE, 0x824D, 0x466B, 0x91AB, 0x558D, 0xDC7E, 0x1858,
+    0x6CCE, 0xA8E8, 0x211B, 0xE53D, 0x32FD, 0xF6DB, 0x7F28, 0xBB0E,
+    0x9531, 0x5117, 0xD8E4, 0x1CC2, 0xCB02, 0x0F24, 0x86D7, 0x42F1,
+    0x5AA9, 0x9E8F, 0x177C, 0xD35A, 0x049A, 0xC0BC, 0x494F, 0x8D69,
+    0xA356, 0x6770, 0xEE83, 0x2AA5, 0xFD65, 0x3943, 0xB0B0, 0x7496,
+    0x1C05, 0xD823, 0x51D0, 0x95F6, 0x4236, 0x8610, 0x0FE3, 0xCBC5,
+    0xE5FA, 0x21DC, 0xA82F, 0x6C09, 0xBBC9, 0x7FEF, 0xF61C, 0x323A,
+    0x2A62, 0xEE44, 0x67B7, 0xA391, 0x7451, 0xB077, 0x3984, 0xFDA2,
+    0xD39D, 0x17BB, 0x9E48, 0x5A6E, 0x8DAE, 0x4988, 0xC07B, 0x045D,
+    0x70CB, 0xB4ED, 0x3D1E, 0xF938, 0x2EF8, 0xEADE, 0x632D, 0xA70B,
+    0x8934, 0x4D12, 0xC4E1, 0x00C7, 0xD707, 0x1321, 0x9AD2, 0x5EF4,
+    0x46AC, 0x828A, 0x0B79, 0xCF5F, 0x189F, 0xDCB9, 0x554A, 0x916C,
+    0xBF53, 0x7B75, 0xF286, 0x36A0, 0xE160, 0x2546, 0xACB5, 0x6893,
+    0x380A, 0xFC2C, 0x75DF, 0xB1F9, 0x6639, 0xA21F, 0x2BEC, 0xEFCA,
+    0xC1F5, 0x05D3, 0x8C20, 0x4806, 0x9FC6, 0x5BE0, 0xD213, 0x1635,
+    0x0E6D, 0xCA4B, 0x43B8, 0x879E, 0x505E, 0x9478, 0x1D8B, 0xD9AD,
+    0xF792, 0x33B4, 0xBA47, 0x7E61, 0xA9A1, 0x6D87, 0xE474, 0x2052,
+    0x54C4, 0x90E2, 0x1911, 0xDD37, 0x0AF7, 0xCED1, 0x4722, 0x8304,
+    0xAD3B, 0x691D, 0xE0EE, 0x24C8, 0xF308, 0x372E, 0xBEDD, 0x7AFB,
+    0x62A3, 0xA685, 0x2F76, 0xEB50, 0x3C90, 0xF8B6, 0x7145, 0xB563,
+    0x9B5C, 0x5F7A, 0xD689, 0x12AF, 0xC56F, 0x0149, 0x88BA, 0x4C9C,
+    0x240F, 0xE029, 0x69DA, 0xADFC, 0x7A3C, 0xBE1A, 0x37E9, 0xF3CF,
+    0xDDF0, 0x19D6, 0x9025, 0x5403, 0x83C3, 0x47E5, 0xCE16, 0x0A30,
+    0x1268, 0xD64E, 0x5FBD, 0x9B9B, 0x4C5B, 0x887D, 0x018E, 0xC5A8,
+    0xEB97, 0x2FB1, 0xA642, 0x6264, 0xB5A4, 0x7182, 0xF871, 0x3C57,
+    0x48C1, 0x8CE7, 0x0514, 0xC132, 0x16F2, 0xD2D4, 0x5B27, 0x9F01,
+    0xB13E, 0x7518, 0xFCEB, 0x38CD, 0xEF0D, 0x2B2B, 0xA2D8, 0x66FE,
+    0x7EA6, 0xBA80, 0x3373, 0xF755, 0x2095, 0xE4B3, 0x6D40, 0xA966,
+    0x8759, 0x437F, 0xCA8C, 0x0EAA, 0xD96A, 0x1D4C, 0x94BF, 0x5099
+};
+
 /*================== Function Prototypes ==================================*/
 
 /*================== Function Implementations =============================*/
@@ -84,9 +129,15 @@ Copyright 2013 Linear Technology Corp. (LTC)
 uint16_t LTC_pec15_calc(uint8_t len, uint8_t *data) {
     uint16_t remainder = 0;
     uint16_t addr = 0;
+    uint16_t i = 0;
 
     remainder = 16;  // initialize the PEC
-    for (uint8_t i = 0; i < len; i++) {  // loops for each byte in data array
+    for (i = 0; (i + 1) < len; i += 2) {  // loops for each pair of bytes in data array
+
+        addr = (uint16_t)(remainder<<1)^(((uint16_t)data[i]<<8)|data[i+1]);  // both table addresses at once
+        remainder = crc15Table2[addr>>8]^(uint16_t)crc15Table[addr&0xff];
+    }
+    if (i < len) {  // last byte of an odd length
 
         addr = ((remainder>>7)^data[i])&0xff;  // calculate PEC table address
         remainder = (remainder<<8)^crc15Table[addr];
@@ -94,8 +145,46 @@ uint16_t LTC_pec15_calc(uint8_t len, uint8_t *data) {
     return(remainder*2);  // The CRC15 has a 0 in the LSB so the remainder must be multiplied by 2
 }
 
-/*================== Public functions =====================================*/
 
-/*================== Static functions =====================================*/
+uint16_t LTC_pec15_calc6(const uint8_t *data) {
+    uint16_t remainder = 16;  // initialize the PEC
+    uint16_t addr = 0;
+
+    addr = (uint16_t)(remainder<<1)^(((uint16_t)data[0]<<8)|data[1]);
+    remainder = crc15Table2[addr>>8]^(uint16_t)crc15Table[addr&0xff];
+    addr = (uint16_t)(remainder<<1)^(((uint16_t)data[2]<<8)|data[3]);
+    remainder = crc15Table2[addr>>8]^(uint16_t)crc15Table[addr&0xff];
+    addr = (uint16_t)(remainder<<1)^(((uint16_t)data[4]<<8)|data[5]);
+    remainder = crc15Table2[addr>>8]^(uint16_t)crc15Table[addr&0xff];
+
+    return (uint16_t)(remainder*2);
+}
+
+
+STD_RETURN_TYPE_e LTC_pec15_verify_chain(const uint8_t *rxBuffer, uint16_t nLtc, uint8_t *errorBitmap) {
+    STD_RETURN_TYPE_e retVal = E_OK;
+    const uint8_t *frame = rxBuffer + 4;  // skip command and command PEC
+    uint16_t PEC_result = 0;
+    uint16_t i = 0;
+
+    for (i = 0; i < nLtc; i++) {
+        PEC_result = LTC_pec15_calc6(frame);
+        if (((uint8_t)(PEC_result>>8) != frame[6]) || ((uint8_t)PEC_result != frame[7])) {
+            retVal = E_NOT_OK;
+            if (errorBitmap != NULL_PTR) {
+                errorBitmap[i>>3] |= (uint8_t)(1u<<(i&7));
+            }
+        } else {
+            if (errorBitmap != NULL_PTR) {
+                errorBitmap[i>>3] &= (uint8_t)~(1u<<(i&7));
+            }
+        }
+        frame += 8;
+    }
 
+    return retVal;
+}
+
+/*================== Public functions =====================================*/
 
+/*================== Static functions =====================================*/
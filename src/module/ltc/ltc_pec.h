@@ -119,6 +119,32 @@ static const unsigned int crc15Table[256] = {  // !<precomputed CRC15 Table
  */
 uint16_t LTC_pec15_calc(uint8_t len, uint8_t *data);
 
+/**
+ * @brief   calculates the PEC of the 6 data bytes of one register group
+ *
+ * Same result as LTC_pec15_calc(6, data), without loop.
+ *
+ * @param   data     Array of 6 data bytes
+ *
+ * @return  retVal   PEC
+ */
+uint16_t LTC_pec15_calc6(const uint8_t *data);
+
+/**
+ * @brief   checks the PECs of a response of the whole daisy-chain in place
+ *
+ * The response starts with the 4 bytes of the command and its PEC, followed
+ * by 6 data bytes and 2 PEC bytes of each LTC.
+ *
+ * @param   rxBuffer     received SPI data
+ * @param   nLtc         number of LTCs in the daisy-chain
+ * @param   errorBitmap  bit i is set if the PEC of LTC i is wrong and cleared otherwise,
+ *                       (nLtc+7)/8 bytes, NULL_PTR if not used
+ *
+ * @return  E_OK if all PECs are correct, E_NOT_OK otherwise
+ */
+STD_RETURN_TYPE_e LTC_pec15_verify_chain(const uint8_t *rxBuffer, uint16_t nLtc, uint8_t *errorBitmap);
+
 /*================== Function Implementations =============================*/
 
 #endif /* LTC_PEC_H_ */
@@ -46,24 +46,75 @@
 #include "mcu.h"
 #include "io.h"
 #include "intermcu.h"
+#include "os.h"
 
 /*================== Macros and Definitions ===============================*/
 
+/**
+ * number of entries of spi_devices[] the driver keeps a transmission state for
+ * (the STM32F4 has up to 6 SPI peripherals)
+ */
+#define SPI_MAX_NR_OF_DEVICES       6
+
+/**
+ * chip select driven for transmissions on a device that is not used by an
+ * Iso-SPI daisy-chain and for the Iso-SPI main interface spi_devices[0] until
+ * SPI_SetDeviceBusID() is called. Can be overridden in spi_cfg.h.
+ */
+#ifndef SPI_DEFAULT_BUSID
+#define SPI_DEFAULT_BUSID           1
+#endif
+
+/**
+ * time in us chip select stays high between two transfers of a sequence started
+ * with SPI_TransmitReceiveChain(). The isoSPI interface of the LTC6804/LTC6811
+ * needs chip select high for at least 0.65us (t5 of the isoSPI timing) to end a
+ * command, the busy-wait in the transfer complete interrupt is rounded up to 1us.
+ * Can be overridden in spi_cfg.h.
+ */
+#ifndef SPI_ISOSPI_CS_HIGH_TIME_US
+#define SPI_ISOSPI_CS_HIGH_TIME_US  1
+#endif
+
+/**
+ * initial transmission state of a device
+ */
+#define SPI_STATE_INIT(isospi_device)   { \
+        .transmit_ongoing       = FALSE, \
+        .counter                = 0, \
+        .busID                  = SPI_DEFAULT_BUSID, \
+        .isospi                 = (isospi_device), \
+        .chain                  = NULL_PTR, \
+        .chain_length           = 0, \
+        .chain_index            = 0, \
+        .chain_taskhandle       = NULL_PTR, \
+    }
+
 /*================== Constant and Variable Definitions ====================*/
 
 /**
- * contains variables used by the SPI driver
+ * contains variables used by the SPI driver, one entry per device of spi_devices[].
+ * spi_devices[0] is the Iso-SPI main interface, further devices are used by an
+ * Iso-SPI daisy-chain once their chip select is set with SPI_SetDeviceBusID().
  *
  */
-static SPI_STATE_s spi_state = {
-    .transmit_ongoing       = FALSE,
-    .counter                = 0,
+static SPI_STATE_s spi_state[SPI_MAX_NR_OF_DEVICES] = {
+    [0] = SPI_STATE_INIT(TRUE),
+    [1] = SPI_STATE_INIT(FALSE),
+    [2] = SPI_STATE_INIT(FALSE),
+    [3] = SPI_STATE_INIT(FALSE),
+    [4] = SPI_STATE_INIT(FALSE),
+    [5] = SPI_STATE_INIT(FALSE),
 };
 
 const uint8_t spi_cmdDummy[1]={0x00};
 
 /*================== Function Prototypes ==================================*/
 
+static SPI_STATE_s *SPI_GetDeviceState(SPI_HandleTypeDef *hspi);
+static SPI_STATE_s *SPI_GetState(SPI_HandleTypeDef *hspi);
+static uint8_t SPI_GetBusID(SPI_HandleTypeDef *hspi);
+static void SPI_ContinueChain(SPI_HandleTypeDef *hspi, SPI_STATE_s *state);
 
 /*================== Function Implementations =============================*/
 
@@ -120,10 +171,16 @@ void SPI_Init(SPI_HandleTypeDef *hspi) {
 
 
 void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi) {
-    if (hspi  ==  &spi_devices[0])        // Iso-SPI Main
+    SPI_STATE_s *state = SPI_GetState(hspi);
+
+    if (state != NULL_PTR)              // Iso-SPI daisy-chains
     {
-        SPI_UnsetCS(1);
-        spi_state.transmit_ongoing = FALSE;
+        SPI_UnsetCS(state->busID);
+        if (state->chain != NULL_PTR) {
+            SPI_ContinueChain(hspi, state);
+        } else {
+            state->transmit_ongoing = FALSE;
+        }
     }
     if (hspi  ==  &spi_devices[1])        // Eeprom
     {
@@ -137,10 +194,12 @@ void HAL_SPI_TxRxCpltCallback(SPI_HandleTypeDef *hspi) {
 
 void HAL_SPI_TxCpltCallback(SPI_HandleTypeDef *hspi)
 {
-    if (hspi  ==  &spi_devices[0])        // Iso-SPI Main
+    SPI_STATE_s *state = SPI_GetState(hspi);
+
+    if (state != NULL_PTR)              // Iso-SPI daisy-chains
     {
-        SPI_UnsetCS(1);
-        spi_state.transmit_ongoing = FALSE;
+        SPI_UnsetCS(state->busID);
+        state->transmit_ongoing = FALSE;
     }
 
     if (hspi  ==  &spi_devices[1])        // Eeprom
@@ -246,16 +305,17 @@ STD_RETURN_TYPE_e SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, uint16_t
 
     HAL_StatusTypeDef statusSPI = HAL_ERROR;
     STD_RETURN_TYPE_e retVal = E_OK;
+    uint8_t busID = SPI_GetBusID(hspi);
 
 #if SPI_TRANSMIT_WAKEUP  ==  1
-    SPI_SetCS(1);
+    SPI_SetCS(busID);
     statusSPI = SPI_SendDummyByte(0x01, hspi);
     if(statusSPI != E_OK)
         return E_NOT_OK;
     SPI_Wait();
 #endif
 
-    SPI_SetCS(1);
+    SPI_SetCS(busID);
     statusSPI = HAL_SPI_Transmit_DMA(hspi, pData, Size);
 
     if(statusSPI != HAL_OK)
@@ -271,16 +331,17 @@ STD_RETURN_TYPE_e SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *pTxData,
 
     HAL_StatusTypeDef statusSPI = HAL_ERROR;
     STD_RETURN_TYPE_e retVal = E_OK;
+    uint8_t busID = SPI_GetBusID(hspi);
 
 #if SPI_TRANSMIT_WAKEUP  ==  1
-    SPI_SetCS(1);
+    SPI_SetCS(busID);
     statusSPI = SPI_SendDummyByte(0x01, hspi);
     if(statusSPI != E_OK)
         return E_NOT_OK;
     SPI_Wait();
 #endif
 
-    SPI_SetCS(1);
+    SPI_SetCS(busID);
     statusSPI = HAL_SPI_TransmitReceive_DMA(hspi, pTxData, pRxData, Size);
     if(statusSPI != HAL_OK)
         retVal = E_NOT_OK;
@@ -289,17 +350,195 @@ STD_RETURN_TYPE_e SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *pTxData,
 
 }
 
+STD_RETURN_TYPE_e SPI_TransmitReceiveChain(SPI_HandleTypeDef *hspi, const SPI_TRANSFER_s *chain, uint8_t nr_of_transfers, void *taskhandle) {
+
+    HAL_StatusTypeDef statusSPI = HAL_ERROR;
+    STD_RETURN_TYPE_e retVal = E_OK;
+    SPI_STATE_s *state = SPI_GetState(hspi);
+
+    if (state == NULL_PTR || chain == NULL_PTR || nr_of_transfers == 0)
+        return E_NOT_OK;
+
+#if SPI_TRANSMIT_WAKEUP  ==  1
+    SPI_SetCS(state->busID);
+    statusSPI = SPI_SendDummyByte(0x01, hspi);
+    if(statusSPI != E_OK)
+        return E_NOT_OK;
+    SPI_Wait();
+#endif
+
+    state->chain = chain;
+    state->chain_length = nr_of_transfers;
+    state->chain_index = 0;
+    state->chain_taskhandle = taskhandle;
+    state->transmit_ongoing = TRUE;
+
+    SPI_SetCS(state->busID);
+    statusSPI = HAL_SPI_TransmitReceive_DMA(hspi, chain[0].pTxData, chain[0].pRxData, chain[0].Size);
+    if(statusSPI != HAL_OK) {
+        SPI_UnsetCS(state->busID);
+        state->chain = NULL_PTR;
+        state->transmit_ongoing = FALSE;
+        retVal = E_NOT_OK;
+    }
+
+    return retVal;
+}
+
+STD_RETURN_TYPE_e SPI_AbortChain(SPI_HandleTypeDef *hspi) {
+
+    STD_RETURN_TYPE_e retVal = E_OK;
+    SPI_STATE_s *state = SPI_GetState(hspi);
+
+    if (state == NULL_PTR)
+        return E_NOT_OK;
+
+    // the transfer complete interrupt must not start the next transfer while the DMA is stopped
+    taskENTER_CRITICAL();
+    if (state->transmit_ongoing == TRUE) {
+        if (HAL_SPI_DMAStop(hspi) != HAL_OK) {
+            retVal = E_NOT_OK;
+        }
+        SPI_UnsetCS(state->busID);
+        state->chain = NULL_PTR;
+        state->transmit_ongoing = FALSE;
+    }
+    taskEXIT_CRITICAL();
+
+    return retVal;
+}
+
 extern STD_RETURN_TYPE_e SPI_IsTransmitOngoing(void) {
+
+    return SPI_IsDeviceTransmitOngoing(&spi_devices[0]);
+}
+
+extern void SPI_SetTransmitOngoing(void) {
+
+    SPI_SetDeviceTransmitOngoing(&spi_devices[0]);
+
+}
+
+extern STD_RETURN_TYPE_e SPI_IsDeviceTransmitOngoing(SPI_HandleTypeDef *hspi) {
     STD_RETURN_TYPE_e retval = FALSE;
+    SPI_STATE_s *state = SPI_GetState(hspi);
 
-    retval    =  spi_state.transmit_ongoing;
+    if (state != NULL_PTR) {
+        retval    =  state->transmit_ongoing;
+    }
 
     return (retval);
 }
 
-extern void SPI_SetTransmitOngoing(void) {
+extern void SPI_SetDeviceTransmitOngoing(SPI_HandleTypeDef *hspi) {
+    SPI_STATE_s *state = SPI_GetState(hspi);
+
+    if (state != NULL_PTR) {
+        state->transmit_ongoing = TRUE;
+    }
+
+}
+
+extern void SPI_SetDeviceBusID(SPI_HandleTypeDef *hspi, uint8_t busID) {
+    SPI_STATE_s *state = SPI_GetDeviceState(hspi);
+
+    if (state != NULL_PTR) {
+        state->busID = busID;
+        state->isospi = TRUE;
+    }
+
+}
+
+/**
+ * @brief   gets the transmission state of a device of spi_devices[].
+ *
+ * @param   hspi: pointer to SPI hardware handle
+ *
+ * @return  pointer to the state of the device, NULL_PTR if hspi is not in spi_devices[]
+ */
+static SPI_STATE_s *SPI_GetDeviceState(SPI_HandleTypeDef *hspi) {
+
+    uint8_t i = 0;
+
+    for (i=0; i < spi_number_of_used_SPI_channels && i < SPI_MAX_NR_OF_DEVICES; i++) {
+        if (hspi == &spi_devices[i]) {
+            return &spi_state[i];
+        }
+    }
+
+    return NULL_PTR;
+}
+
+/**
+ * @brief   gets the transmission state of a device used by an Iso-SPI daisy-chain.
+ *
+ * @param   hspi: pointer to SPI hardware handle
+ *
+ * @return  pointer to the state of the device, NULL_PTR if hspi is not used by an Iso-SPI daisy-chain
+ */
+static SPI_STATE_s *SPI_GetState(SPI_HandleTypeDef *hspi) {
 
-    spi_state.transmit_ongoing = TRUE;
+    SPI_STATE_s *state = SPI_GetDeviceState(hspi);
 
+    if (state != NULL_PTR && state->isospi == FALSE) {
+        state = NULL_PTR;
+    }
+
+    return state;
 }
 
+/**
+ * @brief   gets the chip select driven for transmissions on a device.
+ *
+ * @param   hspi: pointer to SPI hardware handle
+ *
+ * @return  chip select of the Iso-SPI daisy-chain, SPI_DEFAULT_BUSID for other devices
+ */
+static uint8_t SPI_GetBusID(SPI_HandleTypeDef *hspi) {
+
+    SPI_STATE_s *state = SPI_GetState(hspi);
+
+    if (state == NULL_PTR) {
+        return SPI_DEFAULT_BUSID;
+    }
+
+    return state->busID;
+}
+
+/**
+ * @brief   starts the next transfer of a sequence or ends the sequence.
+ *
+ * Called from the transfer complete interrupt of the Iso-SPI interface the sequence runs on.
+ *
+ * @param   hspi: pointer to SPI hardware handle
+ * @param   state: transmission state of hspi
+ *
+ * @return  none(void)
+ */
+static void SPI_ContinueChain(SPI_HandleTypeDef *hspi, SPI_STATE_s *state) {
+
+    HAL_StatusTypeDef statusSPI = HAL_ERROR;
+    const SPI_TRANSFER_s *next = NULL_PTR;
+    BaseType_t higherPriorityTaskWoken = pdFALSE;
+
+    state->chain_index++;
+    if (state->chain_index < state->chain_length) {
+        next = &state->chain[state->chain_index];
+        // chip select was set high by the caller, keep it high for the minimum isoSPI time
+        MCU_Wait_us(SPI_ISOSPI_CS_HIGH_TIME_US);
+        SPI_SetCS(state->busID);
+        statusSPI = HAL_SPI_TransmitReceive_DMA(hspi, next->pTxData, next->pRxData, next->Size);
+        if (statusSPI == HAL_OK) {
+            return;
+        }
+        // abort the sequence, the receive buffers of the remaining transfers are not written
+        SPI_UnsetCS(state->busID);
+    }
+
+    state->chain = NULL_PTR;
+    state->transmit_ongoing = FALSE;
+    if (state->chain_taskhandle != NULL_PTR) {
+        vTaskNotifyGiveFromISR((TaskHandle_t)state->chain_taskhandle, &higherPriorityTaskWoken);
+        portYIELD_FROM_ISR(higherPriorityTaskWoken);
+    }
+}
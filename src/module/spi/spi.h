@@ -40,6 +40,15 @@
 
 /*================== Macros and Definitions ===============================*/
 
+/**
+ * one transfer of a sequence started with SPI_TransmitReceiveChain()
+ */
+typedef struct {
+    uint8_t *pTxData;                       /*!< data to be sent */
+    uint8_t *pRxData;                       /*!< buffer for the received data */
+    uint16_t Size;                          /*!< size of the data to be sent/received */
+} SPI_TRANSFER_s;
+
 /**
  * This structure contains variables relevant for the SPI driver.
  *
@@ -47,6 +56,12 @@
 typedef struct {
     uint8_t transmit_ongoing;               /*!< time in ms before the state machine processes the next state, e.g. in counts of 1ms    */
     uint8_t counter;                        /*!< general purpose counter */
+    uint8_t busID;                          /*!< chip select set low during a transmission, see SPI_SetCS(), 0 if none */
+    uint8_t isospi;                         /*!< TRUE if the device is used by an Iso-SPI daisy-chain, FALSE otherwise */
+    const SPI_TRANSFER_s *chain;            /*!< transfers started with SPI_TransmitReceiveChain(), NULL_PTR if no sequence is ongoing */
+    uint8_t chain_length;                   /*!< number of transfers in chain */
+    uint8_t chain_index;                    /*!< transfer of chain that is ongoing */
+    void *chain_taskhandle;                 /*!< task notified when the last transfer of chain is complete */
 } SPI_STATE_s;
 
 /*================== Constant and Variable Definitions ====================*/
@@ -105,6 +120,40 @@ extern STD_RETURN_TYPE_e SPI_Transmit(SPI_HandleTypeDef *hspi, uint8_t *pData, u
  */
 extern STD_RETURN_TYPE_e SPI_TransmitReceive(SPI_HandleTypeDef *hspi, uint8_t *pTxData, uint8_t *pRxData, uint16_t Size);
 
+/**
+ * @brief   transmits and receives a sequence of transfers through an Iso-SPI interface.
+ *
+ * Chip select is set high after each transfer and the next transfer is started
+ * in the transfer complete interrupt, so the whole sequence, e.g. the read
+ * commands of all cell voltage register groups, is processed in one burst.
+ * SPI_IsDeviceTransmitOngoing() returns TRUE until the last transfer is complete, then
+ * the task is notified with vTaskNotifyGiveFromISR(). Sequences on different
+ * devices run independently of each other.
+ * If a transfer cannot be started, the sequence is aborted and the receive
+ * buffers of the remaining transfers are not written.
+ *
+ * @param   *hspi         pointer to SPI hardware handle, has to be in spi_devices[]
+ * @param   *chain        transfers, have to be valid until the sequence is complete
+ * @param   nr_of_transfers number of transfers in chain
+ * @param   *taskhandle   FreeRTOS task to be notified, NULL_PTR if not used
+ *
+ * @return  E_OK if the first transfer was started, E_NOT_OK otherwise
+ */
+extern STD_RETURN_TYPE_e SPI_TransmitReceiveChain(SPI_HandleTypeDef *hspi, const SPI_TRANSFER_s *chain, uint8_t nr_of_transfers, void *taskhandle);
+
+/**
+ * @brief   aborts the transfer or sequence of transfers ongoing on an Iso-SPI interface.
+ *
+ * Stops the DMA, sets chip select high and ends the sequence started with
+ * SPI_TransmitReceiveChain() without notifying the task. The receive buffers of
+ * the aborted transfers are not valid.
+ *
+ * @param   *hspi         pointer to SPI hardware handle
+ *
+ * @return  E_OK if no transfer is ongoing or it was stopped, E_NOT_OK otherwise
+ */
+extern STD_RETURN_TYPE_e SPI_AbortChain(SPI_HandleTypeDef *hspi);
+
 /**
  * @brief sets Chip Select low to start SPI transmission.
  *
@@ -130,7 +179,25 @@ extern void SPI_UnsetCS(uint8_t busID);
 
 
 /**
- * @brief   gets the SPI transmit status.
+ * @brief   selects the chip select that is driven for transmissions on a device.
+ *
+ * The device is used by an Iso-SPI daisy-chain afterwards: SPI_Transmit(),
+ * SPI_TransmitReceive() and SPI_TransmitReceiveChain() set this chip select low
+ * and the transfer complete interrupt sets it high again. spi_devices[0] is used
+ * by the Iso-SPI main interface with chip select SPI_DEFAULT_BUSID if this function
+ * is not called, other devices keep chip select SPI_DEFAULT_BUSID and are not
+ * handled in the transfer complete interrupt.
+ *
+ * @param   *hspi      pointer to SPI hardware handle, has to be in spi_devices[]
+ * @param   busID      chip select, see SPI_SetCS(), 0 if no chip select is driven
+ *
+ * @return  none(void)
+ */
+extern void SPI_SetDeviceBusID(SPI_HandleTypeDef *hspi, uint8_t busID);
+
+
+/**
+ * @brief   gets the SPI transmit status of the Iso-SPI main interface (spi_devices[0]).
  *
  * @return  retval  TRUE if transmission still ongoing, FALSE otherwise
  *
@@ -139,12 +206,32 @@ extern STD_RETURN_TYPE_e SPI_IsTransmitOngoing(void);
 
 
 /**
- * @brief   sets the SPI transmit status.
+ * @brief   sets the SPI transmit status of the Iso-SPI main interface (spi_devices[0]).
  *
  */
 extern void SPI_SetTransmitOngoing(void);
 
 
+/**
+ * @brief   gets the SPI transmit status of a device.
+ *
+ * @param   *hspi   pointer to SPI hardware handle
+ *
+ * @return  retval  TRUE if transmission still ongoing, FALSE otherwise
+ *
+ */
+extern STD_RETURN_TYPE_e SPI_IsDeviceTransmitOngoing(SPI_HandleTypeDef *hspi);
+
+
+/**
+ * @brief   sets the SPI transmit status of a device.
+ *
+ * @param   *hspi   pointer to SPI hardware handle
+ *
+ */
+extern void SPI_SetDeviceTransmitOngoing(SPI_HandleTypeDef *hspi);
+
+
 
 /*================== Function Implementations =============================*/
 
@@ -0,0 +1,296 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+
+/**
+ * @file    stat.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup UTIL
+ * @prefix  STAT
+ *
+ * @brief   Statistics kernels (min, max, mean, standard deviation)
+ *
+ * Both kernels share one reduction over signed 16bit values. Unsigned values are
+ * mapped to signed values by flipping the sign bit (x - 32768), which keeps the
+ * order of the values and does not change the standard deviation.
+ * On cores with the DSP extension (__ARM_FEATURE_DSP) two values are processed
+ * per 32bit load with the SIMD instructions SSUB16/SEL (min/max and indices),
+ * SMLAD (sum) and SMLALD (sum of squares). Otherwise a portable scalar loop is used.
+ *
+ */
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "stat.h"
+
+#ifdef __ARM_FEATURE_DSP
+#include "stm32f4xx.h"
+#endif
+
+/*================== Macros and Definitions ===============================*/
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+static void STAT_Reduce(const uint16_t *data, uint16_t length, uint16_t signflip, STAT_ACCUMULATOR_s *acc);
+static uint32_t STAT_StdDev(const STAT_ACCUMULATOR_s *acc);
+static uint32_t STAT_Sqrt(uint32_t value);
+
+/*================== Function Implementations =============================*/
+
+/**
+ * @brief   one pass reduction over signed 16bit values.
+ *
+ * The values are data[i] ^ signflip interpreted as int16_t. If the same min or max
+ * occurs more than once, the index of the first occurrence is returned.
+ *
+ * @param   data        array to reduce
+ * @param   length      number of elements, at least 1
+ * @param   signflip    0x8000 for unsigned data, 0 for signed data
+ * @param   acc         accumulator where the result is stored
+ *
+ * @return  void
+ */
+static void STAT_Reduce(const uint16_t *data, uint16_t length, uint16_t signflip, STAT_ACCUMULATOR_s *acc) {
+    uint16_t i = 1;
+    int16_t value = (int16_t)(data[0] ^ signflip);
+
+    acc->min = value;
+    acc->max = value;
+    acc->index_min = 0;
+    acc->index_max = 0;
+    acc->sum = value;
+    acc->sumsq = (int32_t)value*value;
+    acc->count = length;
+
+#ifdef __ARM_FEATURE_DSP
+    /* process a single value first if the pairs would not be word aligned */
+    if ((i < length) && ((((uint32_t)&data[i]) & 0x3u) != 0)) {
+        value = (int16_t)(data[i] ^ signflip);
+        acc->sum += value;
+        acc->sumsq += (int32_t)value*value;
+        if (value < acc->min) {
+            acc->min = value;
+            acc->index_min = i;
+        }
+        if (value > acc->max) {
+            acc->max = value;
+            acc->index_max = i;
+        }
+        i++;
+    }
+
+    if ((length - i) >= 2) {
+        const uint32_t *wordptr = (const uint32_t *)&data[i];
+        uint32_t flip2 = ((uint32_t)signflip << 16) | signflip;
+        uint32_t min2 = ((uint32_t)(uint16_t)acc->min << 16) | (uint16_t)acc->min;
+        uint32_t max2 = ((uint32_t)(uint16_t)acc->max << 16) | (uint16_t)acc->max;
+        uint32_t index_min2 = ((uint32_t)acc->index_min << 16) | acc->index_min;
+        uint32_t index_max2 = ((uint32_t)acc->index_max << 16) | acc->index_max;
+        uint32_t index2 = ((uint32_t)(i + 1) << 16) | i;
+        int32_t sum = 0;
+        int64_t sumsq = 0;
+        uint16_t index_lane = 0;
+        int16_t min_lane = 0;
+        int16_t max_lane = 0;
+
+        for (; (length - i) >= 2; i += 2) {
+            uint32_t value2 = *wordptr++ ^ flip2;
+
+            sum = __SMLAD(value2, 0x00010001u, sum);
+            sumsq = __SMLALD(value2, value2, sumsq);
+
+            /* GE flags set where value >= min: keep min and its index, otherwise take the new value */
+            (void)__SSUB16(value2, min2);
+            min2 = __SEL(min2, value2);
+            index_min2 = __SEL(index_min2, index2);
+
+            /* GE flags set where max >= value: keep max and its index, otherwise take the new value */
+            (void)__SSUB16(max2, value2);
+            max2 = __SEL(max2, value2);
+            index_max2 = __SEL(index_max2, index2);
+
+            index2 += 0x00020002u;
+        }
+
+        acc->sum += sum;
+        acc->sumsq += sumsq;
+
+        /* merge the two lanes, lane 0 holds the even, lane 1 the odd indices */
+        acc->min = (int16_t)(min2 & 0xFFFFu);
+        acc->index_min = (uint16_t)(index_min2 & 0xFFFFu);
+        min_lane = (int16_t)(min2 >> 16);
+        index_lane = (uint16_t)(index_min2 >> 16);
+        if ((min_lane < acc->min) || ((min_lane == acc->min) && (index_lane < acc->index_min))) {
+            acc->min = min_lane;
+            acc->index_min = index_lane;
+        }
+        acc->max = (int16_t)(max2 & 0xFFFFu);
+        acc->index_max = (uint16_t)(index_max2 & 0xFFFFu);
+        max_lane = (int16_t)(max2 >> 16);
+        index_lane = (uint16_t)(index_max2 >> 16);
+        if ((max_lane > acc->max) || ((max_lane == acc->max) && (index_lane < acc->index_max))) {
+            acc->max = max_lane;
+            acc->index_max = index_lane;
+        }
+    }
+#endif
+
+    for (; i < length; i++) {
+        value = (int16_t)(data[i] ^ signflip);
+        acc->sum += value;
+        acc->sumsq += (int32_t)value*value;
+        if (value < acc->min) {
+            acc->min = value;
+            acc->index_min = i;
+        }
+        if (value > acc->max) {
+            acc->max = value;
+            acc->index_max = i;
+        }
+    }
+}
+
+/**
+ * @brief   computes the population standard deviation from an accumulator.
+ *
+ * Uses n^2*var = n*sum(x^2) - sum(x)^2 in 64bit integer arithmetic, which is exact
+ * for up to 65535 values of 16bit.
+ *
+ * @param   acc     accumulator with at least one value
+ *
+ * @return  standard deviation, truncated
+ */
+static uint32_t STAT_StdDev(const STAT_ACCUMULATOR_s *acc) {
+    int64_t numerator = (int64_t)acc->count*acc->sumsq - (int64_t)acc->sum*acc->sum;
+    uint64_t variance = 0;
+
+    if (numerator > 0) {
+        variance = (uint64_t)numerator/((uint64_t)acc->count*acc->count);
+    }
+    return STAT_Sqrt((uint32_t)variance);
+}
+
+/**
+ * @brief   integer square root, rounded down.
+ *
+ * @param   value   radicand
+ *
+ * @return  floor(sqrt(value))
+ */
+static uint32_t STAT_Sqrt(uint32_t value) {
+    uint32_t root = 0;
+    uint32_t bit = 1u << 30;
+
+    while (bit > value) {
+        bit >>= 2;
+    }
+    while (bit != 0) {
+        if (value >= root + bit) {
+            value -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    return root;
+}
+
+
+STD_RETURN_TYPE_e STAT_ReduceU16(const uint16_t *data, uint16_t length, STAT_U16_RESULT_s *result) {
+    STAT_ACCUMULATOR_s acc;
+
+    if ((data == NULL_PTR) || (length == 0)) {
+        return E_NOT_OK;
+    }
+
+    STAT_Reduce(data, length, 0x8000u, &acc);
+
+    return STAT_GetResultU16(&acc, result);
+}
+
+
+STD_RETURN_TYPE_e STAT_ReduceS16(const int16_t *data, uint16_t length, STAT_S16_RESULT_s *result) {
+    STAT_ACCUMULATOR_s acc;
+
+    if ((data == NULL_PTR) || (result == NULL_PTR) || (length == 0)) {
+        return E_NOT_OK;
+    }
+
+    STAT_Reduce((const uint16_t *)data, length, 0, &acc);
+
+    result->min = acc.min;
+    result->max = acc.max;
+    result->index_min = acc.index_min;
+    result->index_max = acc.index_max;
+    result->mean = acc.sum/(int32_t)length;
+    result->stddev = STAT_StdDev(&acc);
+
+    return E_OK;
+}
+
+
+void STAT_InitAccumulator(STAT_ACCUMULATOR_s *acc) {
+    acc->min = 0;
+    acc->max = 0;
+    acc->index_min = 0;
+    acc->index_max = 0;
+    acc->count = 0;
+    acc->sum = 0;
+    acc->sumsq = 0;
+}
+
+
+void STAT_AddU16(STAT_ACCUMULATOR_s *acc, uint16_t value, uint16_t index) {
+    int16_t flipped = (int16_t)(value ^ 0x8000u);
+
+    if ((acc->count == 0) || (flipped < acc->min) || ((flipped == acc->min) && (index < acc->index_min))) {
+        acc->min = flipped;
+        acc->index_min = index;
+    }
+    if ((acc->count == 0) || (flipped > acc->max) || ((flipped == acc->max) && (index < acc->index_max))) {
+        acc->max = flipped;
+        acc->index_max = index;
+    }
+    acc->sum += flipped;
+    acc->sumsq += (int32_t)flipped*flipped;
+    acc->count++;
+}
+
+
+STD_RETURN_TYPE_e STAT_GetResultU16(const STAT_ACCUMULATOR_s *acc, STAT_U16_RESULT_s *result) {
+
+    if ((acc == NULL_PTR) || (result == NULL_PTR) || (acc->count == 0)) {
+        return E_NOT_OK;
+    }
+
+    result->min = (uint16_t)(acc->min + 0x8000);
+    result->max = (uint16_t)(acc->max + 0x8000);
+    result->index_min = acc->index_min;
+    result->index_max = acc->index_max;
+    result->mean = (uint32_t)(((int64_t)acc->sum + 0x8000*(int64_t)acc->count)/acc->count);
+    result->stddev = STAT_StdDev(acc);
+
+    return E_OK;
+}
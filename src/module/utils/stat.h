@@ -0,0 +1,149 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+
+/**
+ * @file    stat.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup UTIL
+ * @prefix  STAT
+ *
+ * @brief   Header for the statistics kernels (min, max, mean, standard deviation)
+ *
+ */
+
+#ifndef STAT_H_
+#define STAT_H_
+
+/*================== Includes =============================================*/
+#include "general.h"
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * result of a reduction over an array of unsigned 16bit values (e.g., cell voltages in mV)
+ */
+typedef struct {
+    uint16_t min;           /*!< smallest value                                     */
+    uint16_t max;           /*!< largest value                                      */
+    uint16_t index_min;     /*!< index of the first occurrence of the smallest value */
+    uint16_t index_max;     /*!< index of the first occurrence of the largest value  */
+    uint32_t mean;          /*!< arithmetic mean, truncated                         */
+    uint32_t stddev;        /*!< population standard deviation, truncated           */
+} STAT_U16_RESULT_s;
+
+/**
+ * result of a reduction over an array of signed 16bit values (e.g., cell temperatures)
+ */
+typedef struct {
+    int16_t min;            /*!< smallest value                                     */
+    int16_t max;            /*!< largest value                                      */
+    uint16_t index_min;     /*!< index of the first occurrence of the smallest value */
+    uint16_t index_max;     /*!< index of the first occurrence of the largest value  */
+    int32_t mean;           /*!< arithmetic mean, truncated towards zero            */
+    uint32_t stddev;        /*!< population standard deviation, truncated           */
+} STAT_S16_RESULT_s;
+
+/**
+ * accumulator for values that are added one at a time, see STAT_AddU16().
+ * Values are stored as signed values, unsigned values with the sign bit flipped.
+ */
+typedef struct {
+    int16_t min;            /*!< smallest value                                     */
+    int16_t max;            /*!< largest value                                      */
+    uint16_t index_min;     /*!< index of the first occurrence of the smallest value */
+    uint16_t index_max;     /*!< index of the first occurrence of the largest value  */
+    uint16_t count;         /*!< number of added values                             */
+    int32_t sum;            /*!< sum of the values                                  */
+    int64_t sumsq;          /*!< sum of the squared values                          */
+} STAT_ACCUMULATOR_s;
+
+/*================== Constant and Variable Definitions ====================*/
+
+
+/*================== Function Prototypes ==================================*/
+
+/**
+ * @brief   computes min, max, their indices, mean and standard deviation of an
+ *          unsigned 16bit array in one pass.
+ *
+ * On cores with the DSP extension two values are processed per 32bit load.
+ *
+ * @param   data    array to reduce
+ * @param   length  number of elements, must be at least 1
+ * @param   result  where the result is stored
+ *
+ * @return  E_OK if the result is valid, E_NOT_OK if data or result is NULL_PTR or length is 0
+ */
+extern STD_RETURN_TYPE_e STAT_ReduceU16(const uint16_t *data, uint16_t length, STAT_U16_RESULT_s *result);
+
+/**
+ * @brief   computes min, max, their indices, mean and standard deviation of a
+ *          signed 16bit array in one pass.
+ *
+ * On cores with the DSP extension two values are processed per 32bit load.
+ *
+ * @param   data    array to reduce
+ * @param   length  number of elements, must be at least 1
+ * @param   result  where the result is stored
+ *
+ * @return  E_OK if the result is valid, E_NOT_OK if data or result is NULL_PTR or length is 0
+ */
+extern STD_RETURN_TYPE_e STAT_ReduceS16(const int16_t *data, uint16_t length, STAT_S16_RESULT_s *result);
+
+/**
+ * @brief   resets an accumulator, no values are added.
+ *
+ * @param   acc     accumulator to reset
+ *
+ * @return  void
+ */
+extern void STAT_InitAccumulator(STAT_ACCUMULATOR_s *acc);
+
+/**
+ * @brief   adds an unsigned 16bit value to an accumulator.
+ *
+ * The values can be added in any order, the index is used to report the first
+ * occurrence of min and max like STAT_ReduceU16() does for an array.
+ *
+ * @param   acc     accumulator
+ * @param   value   value to add
+ * @param   index   index of the value, e.g., in a flat array
+ *
+ * @return  void
+ */
+extern void STAT_AddU16(STAT_ACCUMULATOR_s *acc, uint16_t value, uint16_t index);
+
+/**
+ * @brief   computes the result of an accumulator with unsigned 16bit values.
+ *
+ * @param   acc     accumulator filled with STAT_AddU16()
+ * @param   result  where the result is stored
+ *
+ * @return  E_OK if the result is valid, E_NOT_OK if no values were added
+ */
+extern STD_RETURN_TYPE_e STAT_GetResultU16(const STAT_ACCUMULATOR_s *acc, STAT_U16_RESULT_s *result);
+
+/*================== Function Implementations =============================*/
+
+#endif /* STAT_H_ */
@@ -0,0 +1,712 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    bench.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup TEST
+ * @prefix  BENCH
+ *
+ * @brief   Benchmark and stress test of the database engine on the host
+ *
+ * Producer threads write the data blocks with DB_WriteBlock() (or, if
+ * requested, in place with DB_BorrowWrite() and DB_Commit()), reader threads
+ * copy random blocks with DB_ReadBlock(), one thread runs DATA_Task(). Every
+ * block is owned by one producer. Each write fills the block with a pattern
+ * derived from a sequence number, so readers detect copies that mix two
+ * writes (torn reads) and copies older than one they already got (out of
+ * order reads). Every BENCH_READBACK_PERIOD writes, a producer reads the
+ * block back with DB_ReadBlockAfterWrites(), it has to get the data it just wrote. With -s, the borrowing
+ * producers write all blocks, so DB_BorrowWrite() competes with the writes
+ * of the database task; out of order reads and read-backs are not checked then.
+ *
+ * usage:
+ *      database_bench [-p producers] [-b borrowing producers] [-c readers]
+ *                     [-t duration in ms] [-q queue length] [-s]
+ *
+ * Before, BENCH_CheckDeferredPublish() checks a publish deferred by a reader
+ * while a producer fills the block with DB_BorrowWrite().
+ *
+ * The exit code is 1 if a torn, out of order or stale read was detected, the
+ * deferred publish check failed or the statistics published to
+ * DATA_STATISTICS_BLOCK_ID lack the average latencies.
+ *
+ */
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "database.h"
+
+#include "os.h"
+#include "enginetask.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*================== Macros and Definitions ===============================*/
+/**
+ * number of 32 bit words of a data block
+ */
+#define BENCH_BLOCK_WORDS           (DATA_BENCH_BLOCK_SIZE / 4)
+
+/**
+ * maximum number of threads of each kind
+ */
+#define BENCH_MAX_THREADS           64
+
+/**
+ * maximum number of call latencies kept per thread (reservoir sampling)
+ */
+#define BENCH_MAX_SAMPLES           (1u << 18)
+
+/**
+ * buffers of a producer in addition to the queue length: the data of
+ * DB_WriteBlock() must not change until the database task has processed
+ * the message, which can be up to queue length plus drain budget writes later
+ */
+#define BENCH_EXTRA_BUFFERS         64
+
+/**
+ * number of writes of a producer after which it reads the written block back
+ */
+#define BENCH_READBACK_PERIOD       16
+
+typedef enum {
+    BENCH_OP_WRITE      = 0,    /*!< DB_WriteBlock()                    */
+    BENCH_OP_READ       = 1,    /*!< DB_ReadBlock()                     */
+    BENCH_OP_BORROW     = 2,    /*!< DB_BorrowWrite() and DB_Commit()   */
+    BENCH_OP_READBACK   = 3,    /*!< DB_ReadBlockAfterWrites() after DB_WriteBlock() */
+    BENCH_OP_NR         = 4,
+} BENCH_OP_e;
+
+typedef struct {
+    uint64_t calls;                         /*!< number of calls                    */
+    uint64_t failures;                      /*!< calls that returned an error       */
+    uint32_t nr_of_samples;                 /*!< used entries of samples            */
+    uint32_t *samples;                      /*!< call latencies in ns               */
+} BENCH_OP_STATISTICS_s;
+
+typedef struct {
+    pthread_t thread;
+    uint32_t id;                            /*!< index of the producer or reader    */
+    uint32_t random;                        /*!< state of the random generator      */
+    uint64_t nr_of_torn_reads;
+    uint64_t nr_of_out_of_order_reads;
+    uint64_t nr_of_stale_readbacks;         /*!< read-backs without the data just written */
+    BENCH_OP_STATISTICS_s op[BENCH_OP_NR];
+} BENCH_THREAD_s;
+
+/*================== Constant and Variable Definitions ====================*/
+QueueHandle_t data_queueID = NULL_PTR;
+
+static volatile uint8_t bench_stop = FALSE;
+static volatile uint8_t bench_stop_database = FALSE;
+
+static uint32_t bench_nr_of_producers = 2;
+static uint32_t bench_nr_of_borrowers = 0;
+static uint32_t bench_nr_of_readers = 2;
+static uint32_t bench_duration_ms = 2000;
+static uint32_t bench_queue_length = 8;
+static uint8_t bench_shared_blocks = FALSE;
+
+static BENCH_THREAD_s bench_producer[BENCH_MAX_THREADS];
+static BENCH_THREAD_s bench_reader[BENCH_MAX_THREADS];
+
+static const char *bench_op_name[BENCH_OP_NR] = {
+    "DB_WriteBlock",
+    "DB_ReadBlock",
+    "DB_BorrowWrite/Commit",
+    "DB_ReadBlockAfterWrites",
+};
+
+/*================== Function Prototypes ==================================*/
+static uint64_t BENCH_GetTimeNs(void);
+static uint32_t BENCH_Random(BENCH_THREAD_s *thread);
+static void BENCH_CountCall(BENCH_THREAD_s *thread, BENCH_OP_e op, uint64_t start, STD_RETURN_TYPE_e result);
+static void BENCH_Fill(uint32_t *data, uint32_t seq);
+static uint8_t BENCH_Check(const uint32_t *data);
+static void *BENCH_DatabaseThread(void *arg);
+static uint8_t BENCH_CheckDeferredPublish(DATA_BLOCK_ID_TYPE_e blockID);
+static void *BENCH_ProducerThread(void *arg);
+static void *BENCH_ReaderThread(void *arg);
+static int BENCH_CompareSamples(const void *a, const void *b);
+static void BENCH_PrintOp(BENCH_THREAD_s *threads, uint32_t nr_of_threads, BENCH_OP_e op, double seconds);
+static uint8_t BENCH_PrintStatistics(void);
+
+/*================== Function Implementations =============================*/
+
+/**
+ * @brief   gets CLOCK_MONOTONIC in ns
+ */
+static uint64_t BENCH_GetTimeNs(void) {
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+
+/**
+ * @brief   xorshift32 random generator of a thread
+ */
+static uint32_t BENCH_Random(BENCH_THREAD_s *thread) {
+    thread->random ^= thread->random << 13;
+    thread->random ^= thread->random >> 17;
+    thread->random ^= thread->random << 5;
+    return thread->random;
+}
+
+
+/**
+ * @brief   counts a call and keeps its latency with reservoir sampling
+ *
+ * @param   thread  thread that made the call
+ * @param   op      called operation
+ * @param   start   time before the call in ns
+ * @param   result  E_NOT_OK if the call failed
+ *
+ * @return  void
+ */
+static void BENCH_CountCall(BENCH_THREAD_s *thread, BENCH_OP_e op, uint64_t start, STD_RETURN_TYPE_e result) {
+    BENCH_OP_STATISTICS_s *statistics = &thread->op[op];
+    uint32_t latency = (uint32_t)(BENCH_GetTimeNs() - start);
+    uint64_t index;
+
+    statistics->calls++;
+    if(result != E_OK)
+    {
+        statistics->failures++;
+    }
+    if(statistics->nr_of_samples < BENCH_MAX_SAMPLES)
+    {
+        statistics->samples[statistics->nr_of_samples++] = latency;
+    }
+    else
+    {
+        index = BENCH_Random(thread) % statistics->calls;
+        if(index < BENCH_MAX_SAMPLES)
+        {
+            statistics->samples[index] = latency;
+        }
+    }
+}
+
+
+/**
+ * @brief   fills a data block with the pattern of a sequence number
+ *
+ * @param   data    data block
+ * @param   seq     sequence number, stored in the first word
+ *
+ * @return  void
+ */
+static void BENCH_Fill(uint32_t *data, uint32_t seq) {
+    uint32_t i;
+
+    data[0] = seq;
+    for(i = 1; i < BENCH_BLOCK_WORDS; i++)
+    {
+        data[i] = seq ^ (i * 0x9E3779B9u);
+    }
+}
+
+
+/**
+ * @brief   checks that a data block contains the pattern of the sequence number in its first word
+ *
+ * The initial content of the blocks (all zero) is accepted as sequence number 0.
+ *
+ * @param   data    data block
+ *
+ * @return  TRUE if the block is consistent, FALSE otherwise
+ */
+static uint8_t BENCH_Check(const uint32_t *data) {
+    uint32_t i;
+
+    for(i = 1; i < BENCH_BLOCK_WORDS; i++)
+    {
+        if((data[i] != (data[0] ^ (i * 0x9E3779B9u))) && ((data[0] != 0) || (data[i] != 0)))
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+
+/**
+ * @brief   runs the database task until the benchmark is finished
+ */
+static void *BENCH_DatabaseThread(void *arg) {
+    while(bench_stop_database == FALSE)
+    {
+        DATA_Task();
+    }
+    return NULL_PTR;
+}
+
+
+/**
+ * @brief   checks that a publish deferred by DB_BorrowRead() does not publish a buffer lent by DB_BorrowWrite()
+ *
+ * Runs before the producers and readers start. A reader borrows the block,
+ * a commit is deferred, a producer borrows the inactive buffer and the reader
+ * releases the block while the producer has only written a part of it. Reads
+ * must not get the partly written buffer, and after DB_Commit() they have to
+ * get the data of the producer. The block is cleared again at the end.
+ * Single buffered blocks cannot be borrowed and are not checked.
+ *
+ * @param   blockID     data block used for the check
+ *
+ * @return  TRUE if the check passed, FALSE otherwise
+ */
+static uint8_t BENCH_CheckDeferredPublish(DATA_BLOCK_ID_TYPE_e blockID) {
+    uint32_t data[BENCH_BLOCK_WORDS];
+    uint32_t *dataptr;
+    uint8_t retVal = TRUE;
+
+    if(DB_BorrowRead(blockID) == NULL_PTR)
+    {
+        return TRUE;
+    }
+    dataptr = (uint32_t *)DB_BorrowWrite(blockID);
+    configASSERT(dataptr != NULL_PTR);
+    BENCH_Fill(dataptr, 1);
+    (void)DB_Commit(blockID);
+
+    // the producer has written the first word only when the reader releases the block
+    dataptr = (uint32_t *)DB_BorrowWrite(blockID);
+    configASSERT(dataptr != NULL_PTR);
+    dataptr[0] = 2;
+    (void)DB_Release(blockID);
+    if((DB_ReadBlock(data, blockID) != E_OK) || (BENCH_Check(data) == FALSE))
+    {
+        retVal = FALSE;
+    }
+
+    BENCH_Fill(dataptr, 2);
+    (void)DB_Commit(blockID);
+    if((DB_ReadBlock(data, blockID) != E_OK) || (data[0] != 2) || (BENCH_Check(data) == FALSE))
+    {
+        retVal = FALSE;
+    }
+
+    dataptr = (uint32_t *)DB_BorrowWrite(blockID);
+    configASSERT(dataptr != NULL_PTR);
+    memset(dataptr, 0, DATA_BENCH_BLOCK_SIZE);
+    (void)DB_Commit(blockID);
+
+    printf("deferred publish with borrowed write buffer: %s\n\n", (retVal == TRUE) ? "ok" : "FAILED");
+    return retVal;
+}
+
+
+/**
+ * @brief   writes the blocks owned by a producer as fast as possible
+ *
+ * The blocks are distributed over all producers, producer n owns every block
+ * whose ID modulo the number of producers is n. The first bench_nr_of_producers
+ * producers write with DB_WriteBlock(), the others with DB_BorrowWrite() and
+ * DB_Commit().
+ */
+static void *BENCH_ProducerThread(void *arg) {
+    BENCH_THREAD_s *thread = (BENCH_THREAD_s *)arg;
+    uint32_t nr_of_writers = bench_nr_of_producers + bench_nr_of_borrowers;
+    uint32_t nr_of_buffers = bench_queue_length + BENCH_EXTRA_BUFFERS;
+    uint32_t seq[DATA_BENCH_NR_OF_BLOCKS] = {0};
+    uint32_t readback[BENCH_BLOCK_WORDS];
+    uint32_t (*buffers)[BENCH_BLOCK_WORDS];
+    DATA_STATISTICS_s *statistics;
+    STD_RETURN_TYPE_e result;
+    uint32_t timeouts = 0;
+    uint8_t check;
+    uint32_t buffer = 0;
+    uint32_t blockID = thread->id;
+    uint32_t *dataptr;
+    uint64_t start;
+
+    buffers = calloc(nr_of_buffers, sizeof(buffers[0]));
+    statistics = malloc(sizeof(DATA_STATISTICS_s));
+    if((buffers == NULL_PTR) || (statistics == NULL_PTR) || (blockID >= DATA_BENCH_NR_OF_BLOCKS))
+    {
+        free(buffers);
+        free(statistics);
+        return NULL_PTR;
+    }
+
+    while(bench_stop == FALSE)
+    {
+        if(thread->id < bench_nr_of_producers)
+        {
+            BENCH_Fill(buffers[buffer], ++seq[blockID]);
+            check = ((bench_shared_blocks == FALSE) && ((seq[blockID] % BENCH_READBACK_PERIOD) == 0));
+            if(check == TRUE)
+            {
+                DB_GetStatistics(statistics);
+                timeouts = statistics->nr_of_queue_timeouts;
+            }
+            start = BENCH_GetTimeNs();
+            DB_WriteBlock(buffers[buffer], (DATA_BLOCK_ID_TYPE_e)blockID);
+            BENCH_CountCall(thread, BENCH_OP_WRITE, start, E_OK);
+            buffer = (buffer + 1) % nr_of_buffers;
+            if(check == TRUE)
+            {
+                start = BENCH_GetTimeNs();
+                result = DB_ReadBlockAfterWrites(readback, (DATA_BLOCK_ID_TYPE_e)blockID);
+                BENCH_CountCall(thread, BENCH_OP_READBACK, start, result);
+                DB_GetStatistics(statistics);
+                // a write lost because the queue was full cannot be read back
+                if((result == E_OK) && (readback[0] != seq[blockID]) && (statistics->nr_of_queue_timeouts == timeouts))
+                {
+                    thread->nr_of_stale_readbacks++;
+                }
+            }
+        }
+        else
+        {
+            start = BENCH_GetTimeNs();
+            dataptr = (uint32_t *)DB_BorrowWrite((DATA_BLOCK_ID_TYPE_e)blockID);
+            if(dataptr != NULL_PTR)
+            {
+                BENCH_Fill(dataptr, ++seq[blockID]);
+                BENCH_CountCall(thread, BENCH_OP_BORROW, start, DB_Commit((DATA_BLOCK_ID_TYPE_e)blockID));
+            }
+            else
+            {
+                BENCH_CountCall(thread, BENCH_OP_BORROW, start, E_NOT_OK);
+            }
+        }
+
+        if((bench_shared_blocks == TRUE) && (thread->id >= bench_nr_of_producers))
+        {
+            blockID = (blockID + 1) % DATA_BENCH_NR_OF_BLOCKS;
+        }
+        else
+        {
+            blockID += nr_of_writers;
+            if(blockID >= DATA_BENCH_NR_OF_BLOCKS)
+            {
+                blockID = thread->id;
+            }
+        }
+    }
+
+    /* the buffers may still be referenced by queued messages */
+    while(uxQueueMessagesWaiting(data_queueID) > 0)
+    {
+        vTaskDelay(1);
+    }
+    vTaskDelay(10);
+    free(buffers);
+    free(statistics);
+    return NULL_PTR;
+}
+
+
+/**
+ * @brief   reads random blocks as fast as possible and checks their consistency
+ */
+static void *BENCH_ReaderThread(void *arg) {
+    BENCH_THREAD_s *thread = (BENCH_THREAD_s *)arg;
+    uint32_t lastseq[DATA_BENCH_NR_OF_BLOCKS] = {0};
+    uint32_t data[BENCH_BLOCK_WORDS];
+    STD_RETURN_TYPE_e result;
+    uint32_t blockID;
+    uint64_t start;
+
+    while(bench_stop == FALSE)
+    {
+        blockID = BENCH_Random(thread) % DATA_BENCH_NR_OF_BLOCKS;
+        start = BENCH_GetTimeNs();
+        result = DB_ReadBlock(data, (DATA_BLOCK_ID_TYPE_e)blockID);
+        BENCH_CountCall(thread, BENCH_OP_READ, start, result);
+        if(result == E_OK)
+        {
+            if(BENCH_Check(data) == FALSE)
+            {
+                thread->nr_of_torn_reads++;
+            }
+            else if((bench_shared_blocks == FALSE) && (data[0] < lastseq[blockID]))
+            {
+                thread->nr_of_out_of_order_reads++;
+            }
+            else
+            {
+                lastseq[blockID] = data[0];
+            }
+        }
+    }
+    return NULL_PTR;
+}
+
+
+/**
+ * @brief   compare function of qsort() for latencies
+ */
+static int BENCH_CompareSamples(const void *a, const void *b) {
+    uint32_t x = *(const uint32_t *)a;
+    uint32_t y = *(const uint32_t *)b;
+
+    return (x > y) - (x < y);
+}
+
+
+/**
+ * @brief   prints throughput and latency percentiles of an operation over all threads
+ *
+ * @param   threads         threads to evaluate
+ * @param   nr_of_threads   number of threads
+ * @param   op              operation
+ * @param   seconds         duration of the benchmark
+ *
+ * @return  void
+ */
+static void BENCH_PrintOp(BENCH_THREAD_s *threads, uint32_t nr_of_threads, BENCH_OP_e op, double seconds) {
+    uint64_t calls = 0;
+    uint64_t failures = 0;
+    uint32_t nr_of_samples = 0;
+    uint32_t *samples;
+    uint32_t t;
+
+    for(t = 0; t < nr_of_threads; t++)
+    {
+        calls += threads[t].op[op].calls;
+        failures += threads[t].op[op].failures;
+        nr_of_samples += threads[t].op[op].nr_of_samples;
+    }
+    if(calls == 0)
+    {
+        return;
+    }
+
+    samples = malloc(nr_of_samples * sizeof(uint32_t));
+    if(samples == NULL_PTR)
+    {
+        return;
+    }
+    nr_of_samples = 0;
+    for(t = 0; t < nr_of_threads; t++)
+    {
+        memcpy(&samples[nr_of_samples], threads[t].op[op].samples, threads[t].op[op].nr_of_samples * sizeof(uint32_t));
+        nr_of_samples += threads[t].op[op].nr_of_samples;
+    }
+    qsort(samples, nr_of_samples, sizeof(uint32_t), BENCH_CompareSamples);
+
+    printf("%-24s %12llu %12.0f %10llu %9.2f %9.2f %9.2f %9.2f\n", bench_op_name[op],
+            (unsigned long long)calls, calls / seconds, (unsigned long long)failures,
+            samples[nr_of_samples / 2] / 1000.0,
+            samples[(nr_of_samples * 9ULL) / 10] / 1000.0,
+            samples[(nr_of_samples * 99ULL) / 100] / 1000.0,
+            samples[nr_of_samples - 1] / 1000.0);
+    free(samples);
+}
+
+
+/**
+ * @brief   prints the statistics of the database over all blocks of the benchmark
+ *
+ * Also checks that the statistics published to DATA_STATISTICS_BLOCK_ID
+ * contain the average latencies.
+ *
+ * @return  TRUE if the published statistics are valid, FALSE otherwise
+ */
+static uint8_t BENCH_PrintStatistics(void) {
+    static DATA_STATISTICS_s statistics;
+    static DATA_STATISTICS_s exported;
+    uint8_t retVal = TRUE;
+    DATA_BLOCK_STATISTICS_s *block;
+    uint64_t writes = 0;
+    uint64_t reads = 0;
+    uint64_t retries = 0;
+    uint64_t readfailures = 0;
+    uint64_t dropped = 0;
+    uint64_t coalesced = 0;
+    uint64_t collisions = 0;
+    uint64_t latencysum = 0;
+    uint32_t latencymin = UINT32_MAX;
+    uint32_t latencymax = 0;
+    uint32_t nr_of_exported_writes = 0;
+    uint32_t c;
+
+    DB_GetStatistics(&statistics);
+    for(c = 0; c < DATA_BENCH_NR_OF_BLOCKS; c++)
+    {
+        block = &statistics.block[c];
+        writes += block->nr_of_writes;
+        reads += block->nr_of_reads;
+        retries += block->nr_of_read_retries;
+        readfailures += block->nr_of_read_failures;
+        dropped += block->nr_of_dropped_writes;
+        coalesced += block->nr_of_coalesced_writes;
+        collisions += block->nr_of_collisions;
+        if(block->nr_of_writes > 0)
+        {
+            latencysum += (uint64_t)block->latency_avg * block->nr_of_writes;
+            latencymin = (block->latency_min < latencymin) ? block->latency_min : latencymin;
+            latencymax = (block->latency_max > latencymax) ? block->latency_max : latencymax;
+        }
+    }
+
+    printf("\ndatabase statistics\n");
+    printf("  published writes      %llu\n", (unsigned long long)writes);
+    printf("  coalesced writes      %llu\n", (unsigned long long)coalesced);
+    printf("  dropped writes        %llu (block borrowed by DB_BorrowWrite())\n", (unsigned long long)dropped);
+    printf("  queue timeouts        %lu\n", (unsigned long)statistics.nr_of_queue_timeouts);
+    printf("  queue high-water mark %lu of %lu\n", (unsigned long)statistics.queue_highwatermark, (unsigned long)bench_queue_length);
+    printf("  reads                 %llu, %llu retries, %llu failures\n",
+            (unsigned long long)reads, (unsigned long long)retries, (unsigned long long)readfailures);
+    printf("  read collisions       %llu\n", (unsigned long long)collisions);
+    if(writes > 0)
+    {   // 72 SysTick cycles per us
+        printf("  queue to publish [us] min %.2f avg %.2f max %.2f\n",
+                latencymin / 72.0, (double)latencysum / writes / 72.0, latencymax / 72.0);
+    }
+
+    if(DB_ReadBlock(&exported, DATA_STATISTICS_BLOCK_ID) == E_OK)
+    {
+        for(c = 0; c < DATA_BENCH_NR_OF_BLOCKS; c++)
+        {
+            nr_of_exported_writes += exported.block[c].nr_of_writes;
+            if((exported.block[c].nr_of_writes > 0) && (exported.block[c].latency_avg == 0))
+            {
+                retVal = FALSE;
+            }
+        }
+        printf("  published statistics  %lu writes%s\n", (unsigned long)nr_of_exported_writes,
+                (retVal == TRUE) ? "" : ", average latency missing");
+    }
+    return retVal;
+}
+
+
+int main(int argc, char **argv) {
+    static DATA_STATISTICS_s initialstatistics;
+    pthread_t databasethread;
+    uint64_t start;
+    double seconds;
+    uint64_t torn = 0;
+    uint64_t outoforder = 0;
+    uint64_t stale = 0;
+    uint8_t statisticsvalid;
+    uint8_t deferredpublishvalid;
+    uint32_t nr_of_writers;
+    uint32_t t;
+    uint32_t op;
+    int opt;
+
+    while((opt = getopt(argc, argv, "p:b:c:t:q:s")) != -1)
+    {
+        switch(opt)
+        {
+            case 'p': bench_nr_of_producers = (uint32_t)atoi(optarg); break;
+            case 'b': bench_nr_of_borrowers = (uint32_t)atoi(optarg); break;
+            case 'c': bench_nr_of_readers = (uint32_t)atoi(optarg); break;
+            case 't': bench_duration_ms = (uint32_t)atoi(optarg); break;
+            case 'q': bench_queue_length = (uint32_t)atoi(optarg); break;
+            case 's': bench_shared_blocks = TRUE; break;
+            default:
+                fprintf(stderr, "usage: %s [-p producers] [-b borrowing producers] [-c readers] [-t duration in ms] [-q queue length] [-s]\n", argv[0]);
+                return 2;
+        }
+    }
+    nr_of_writers = bench_nr_of_producers + bench_nr_of_borrowers;
+    if((nr_of_writers == 0) || (nr_of_writers > BENCH_MAX_THREADS) || (nr_of_writers > DATA_BENCH_NR_OF_BLOCKS) ||
+            (bench_nr_of_readers > BENCH_MAX_THREADS) || (bench_queue_length == 0))
+    {
+        fprintf(stderr, "1 to %d producers (at most one per block), up to %d readers and a queue length > 0 are supported\n",
+                (DATA_BENCH_NR_OF_BLOCKS < BENCH_MAX_THREADS) ? DATA_BENCH_NR_OF_BLOCKS : BENCH_MAX_THREADS, BENCH_MAX_THREADS);
+        return 2;
+    }
+
+    data_queueID = xQueueCreate(bench_queue_length, sizeof(DATA_QUEUE_MESSAGE_s));
+    configASSERT(data_queueID != NULL_PTR);
+
+    printf("%d blocks of %d bytes, buffer type %d, queue length %lu\n",
+            DATA_BENCH_NR_OF_BLOCKS, DATA_BENCH_BLOCK_SIZE, DATA_BENCH_BUFFERING, (unsigned long)bench_queue_length);
+    printf("%lu producers, %lu borrowing producers, %lu readers, %lu ms\n\n",
+            (unsigned long)bench_nr_of_producers, (unsigned long)bench_nr_of_borrowers,
+            (unsigned long)bench_nr_of_readers, (unsigned long)bench_duration_ms);
+
+    for(t = 0; t < BENCH_MAX_THREADS; t++)
+    {
+        for(op = 0; op < BENCH_OP_NR; op++)
+        {
+            bench_producer[t].op[op].samples = calloc(BENCH_MAX_SAMPLES, sizeof(uint32_t));
+            bench_reader[t].op[op].samples = calloc(BENCH_MAX_SAMPLES, sizeof(uint32_t));
+            configASSERT((bench_producer[t].op[op].samples != NULL_PTR) && (bench_reader[t].op[op].samples != NULL_PTR));
+        }
+    }
+
+    pthread_create(&databasethread, NULL_PTR, BENCH_DatabaseThread, NULL_PTR);
+    // readers and producers start when the database task has initialized the database
+    while(DB_ReadBlock(&initialstatistics, DATA_STATISTICS_BLOCK_ID) != E_OK)
+    {
+        vTaskDelay(1);
+    }
+    deferredpublishvalid = BENCH_CheckDeferredPublish((DATA_BLOCK_ID_TYPE_e)0);
+    start = BENCH_GetTimeNs();
+    for(t = 0; t < nr_of_writers; t++)
+    {
+        bench_producer[t].id = t;
+        bench_producer[t].random = 0x12345678u + t;
+        pthread_create(&bench_producer[t].thread, NULL_PTR, BENCH_ProducerThread, &bench_producer[t]);
+    }
+    for(t = 0; t < bench_nr_of_readers; t++)
+    {
+        bench_reader[t].id = t;
+        bench_reader[t].random = 0x87654321u + t;
+        pthread_create(&bench_reader[t].thread, NULL_PTR, BENCH_ReaderThread, &bench_reader[t]);
+    }
+
+    vTaskDelay(bench_duration_ms);
+    bench_stop = TRUE;
+    for(t = 0; t < nr_of_writers; t++)
+    {
+        pthread_join(bench_producer[t].thread, NULL_PTR);
+        stale += bench_producer[t].nr_of_stale_readbacks;
+    }
+    for(t = 0; t < bench_nr_of_readers; t++)
+    {
+        pthread_join(bench_reader[t].thread, NULL_PTR);
+        torn += bench_reader[t].nr_of_torn_reads;
+        outoforder += bench_reader[t].nr_of_out_of_order_reads;
+    }
+    seconds = (BENCH_GetTimeNs() - start) / 1e9;
+    bench_stop_database = TRUE;
+    pthread_join(databasethread, NULL_PTR);
+
+    printf("%-24s %12s %12s %10s %9s %9s %9s %9s\n", "call latency [us]", "calls", "calls/s", "failed", "p50", "p90", "p99", "max");
+    BENCH_PrintOp(bench_producer, nr_of_writers, BENCH_OP_WRITE, seconds);
+    BENCH_PrintOp(bench_producer, nr_of_writers, BENCH_OP_BORROW, seconds);
+    BENCH_PrintOp(bench_reader, bench_nr_of_readers, BENCH_OP_READ, seconds);
+    BENCH_PrintOp(bench_producer, nr_of_writers, BENCH_OP_READBACK, seconds);
+    statisticsvalid = BENCH_PrintStatistics();
+
+    printf("\ntorn reads %llu, out of order reads %llu, stale read-backs %llu\n",
+            (unsigned long long)torn, (unsigned long long)outoforder, (unsigned long long)stale);
+    return ((torn == 0) && (outoforder == 0) && (stale == 0) && (statisticsvalid == TRUE) &&
+            (deferredpublishvalid == TRUE)) ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    database_cfg.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup TEST
+ * @prefix  DATA
+ *
+ * @brief   Synthetic database configuration of the host build of the database engine
+ *
+ * The number, size and buffer type of the data blocks are set at compile time,
+ * see the options of the wscript. The blocks are allocated from the internal
+ * arena. An additional block receives the statistics of the database.
+ *
+ */
+
+#ifndef DATABASE_CFG_H_
+#define DATABASE_CFG_H_
+
+/*================== Includes =============================================*/
+#include "general.h"
+
+/*================== Macros and Definitions ===============================*/
+/**
+ * number of data blocks written and read by the benchmark
+ */
+#ifndef DATA_BENCH_NR_OF_BLOCKS
+#define DATA_BENCH_NR_OF_BLOCKS     16
+#endif
+
+/**
+ * size of each data block in bytes, multiple of 4 and at least 8
+ */
+#ifndef DATA_BENCH_BLOCK_SIZE
+#define DATA_BENCH_BLOCK_SIZE       256
+#endif
+
+/**
+ * consistency type of the data blocks, see DATA_BLOCK_CONSISTENCY_TYPE_e
+ */
+#ifndef DATA_BENCH_BUFFERING
+#define DATA_BENCH_BUFFERING        DOUBLE_BUFFERING
+#endif
+
+/**
+ * the blocks of the benchmark are allocated from the internal arena
+ */
+#define DATA_INTERNAL_ARENA_SIZE    (DATA_BENCH_NR_OF_BLOCKS * ((DATA_BENCH_BLOCK_SIZE + 7) & ~7) * 3)
+
+/**
+ * readers and the database task run on different cores of the host
+ */
+#define DATA_MEMORY_BARRIER()       __sync_synchronize()
+
+/**
+ * block the statistics of the database are published to
+ */
+#define DATA_STATISTICS_BLOCK_ID    DATA_BLOCK_ID_STATISTICS
+
+typedef enum {
+    DATA_BLOCK_ID_BENCH_FIRST   = 0,
+    DATA_BLOCK_ID_STATISTICS    = DATA_BENCH_NR_OF_BLOCKS,
+    DATA_MAX_BLOCK_NR,
+} DATA_BLOCK_ID_TYPE_e;
+
+typedef enum {
+    WRITE_ACCESS    = 0,
+    READ_ACCESS     = 1,
+} DATA_BLOCK_ACCESS_TYPE_e;
+
+typedef enum {
+    SINGLE_BUFFERING    = 1,
+    DOUBLE_BUFFERING    = 2,
+    TRIPLE_BUFFERING    = 3,
+} DATA_BLOCK_CONSISTENCY_TYPE_e;
+
+typedef struct {
+    void                            *blockptr;
+    uint16_t                        datalength;
+    DATA_BLOCK_CONSISTENCY_TYPE_e   buffertype;
+} DATA_BASE_HEADER_s;
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+/*================== Function Implementations =============================*/
+
+#endif /* DATABASE_CFG_H_ */
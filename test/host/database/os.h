@@ -0,0 +1,131 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    os.h
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup TEST
+ * @prefix  OS
+ *
+ * @brief   POSIX thread stand-in for the FreeRTOS functions used by the database engine
+ *
+ * Critical sections are emulated by one recursive mutex shared by all threads,
+ * queues by a ring buffer protected by a mutex and two condition variables.
+ * One OS tick is one millisecond.
+ *
+ */
+
+#ifndef OS_H_
+#define OS_H_
+
+/*================== Includes =============================================*/
+#include "general.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/*================== Macros and Definitions ===============================*/
+#define pdFALSE             0
+#define pdTRUE              1
+#define portTICK_RATE_MS    1
+
+#define configASSERT(x) \
+    do { \
+        if(!(x)) { \
+            fprintf(stderr, "%s:%d: assertion failed: %s\n", __FILE__, __LINE__, #x); \
+            abort(); \
+        } \
+    } while(0)
+
+typedef uint32_t TickType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+typedef void * TaskHandle_t;
+typedef struct OS_QUEUE *QueueHandle_t;
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+/**
+ * @brief   creates a queue of fixed size items
+ *
+ * @param   length      maximum number of items in the queue
+ * @param   itemsize    size of one item in bytes
+ *
+ * @return  handle of the queue, NULL_PTR if it could not be created
+ */
+extern QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemsize);
+
+/**
+ * @brief   copies an item to the back of a queue, waits up to ticks for free space
+ *
+ * @return  pdTRUE if the item was queued, pdFALSE on timeout
+ */
+extern BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks);
+
+/**
+ * @brief   copies an item from the front of a queue and removes it, waits up to ticks for an item
+ *
+ * @return  pdTRUE if an item was received, pdFALSE on timeout
+ */
+extern BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks);
+
+/**
+ * @brief   number of items in a queue
+ */
+extern UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue);
+
+/**
+ * @brief   sleeps for the given number of OS ticks
+ */
+extern void vTaskDelay(TickType_t ticks);
+
+/**
+ * @brief   returns a handle of the calling thread
+ */
+extern TaskHandle_t xTaskGetCurrentTaskHandle(void);
+
+/**
+ * @brief   task notifications are not emulated, the call is ignored
+ */
+extern BaseType_t xTaskNotifyGive(TaskHandle_t task);
+
+/**
+ * @brief   returns a value other than 0 if the calling thread is inside a critical section
+ */
+extern uint32_t vPortCheckCriticalSection(void);
+
+/**
+ * @brief   enters the critical section, nested calls are allowed
+ */
+extern void OS_TaskEnter_Critical(void);
+
+/**
+ * @brief   exits the critical section
+ */
+extern void OS_TaskExit_Critical(void);
+
+/*================== Function Implementations =============================*/
+
+#endif /* OS_H_ */
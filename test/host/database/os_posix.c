@@ -0,0 +1,262 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    os_posix.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup TEST
+ * @prefix  OS
+ *
+ * @brief   POSIX thread stand-in for FreeRTOS, the MCU time functions and the diagnosis module
+ *
+ */
+
+/*================== Includes =============================================*/
+#define _GNU_SOURCE
+#include "general.h"
+#include "os.h"
+
+#include "diag.h"
+#include "mcu.h"
+#include <errno.h>
+#include <pthread.h>
+#include <string.h>
+#include <time.h>
+
+/*================== Macros and Definitions ===============================*/
+/**
+ * SysTick cycles per OS tick, the SysTick of the target runs with 72MHz
+ */
+#define OS_SYSTICK_CYCLES_PER_TICK  72000
+
+struct OS_QUEUE {
+    pthread_mutex_t mutex;
+    pthread_cond_t  notempty;
+    pthread_cond_t  notfull;
+    uint8_t         *items;
+    UBaseType_t     length;
+    UBaseType_t     itemsize;
+    UBaseType_t     head;
+    UBaseType_t     count;
+};
+
+/*================== Constant and Variable Definitions ====================*/
+/**
+ * emulates disabled interrupts: only one thread at a time is in a critical section
+ */
+static pthread_mutex_t os_critical_mutex = PTHREAD_RECURSIVE_MUTEX_INITIALIZER_NP;
+
+/**
+ * nesting depth of the critical sections of the calling thread
+ */
+static __thread uint32_t os_critical_nesting = 0;
+
+/**
+ * CLOCK_MONOTONIC at the first call of a time function
+ */
+static struct timespec os_starttime;
+static pthread_once_t os_starttime_once = PTHREAD_ONCE_INIT;
+
+/*================== Function Prototypes ==================================*/
+static void OS_InitStartTime(void);
+static uint64_t OS_GetTimeNs(void);
+static void OS_GetDeadline(TickType_t ticks, struct timespec *deadline);
+
+/*================== Function Implementations =============================*/
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemsize) {
+    QueueHandle_t queue = calloc(1, sizeof(struct OS_QUEUE));
+
+    if(queue == NULL_PTR)
+    {
+        return NULL_PTR;
+    }
+    queue->items = calloc(length, itemsize);
+    if(queue->items == NULL_PTR)
+    {
+        free(queue);
+        return NULL_PTR;
+    }
+    pthread_mutex_init(&queue->mutex, NULL_PTR);
+    pthread_cond_init(&queue->notempty, NULL_PTR);
+    pthread_cond_init(&queue->notfull, NULL_PTR);
+    queue->length = length;
+    queue->itemsize = itemsize;
+    return queue;
+}
+
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void *item, TickType_t ticks) {
+    struct timespec deadline;
+    BaseType_t retVal = pdTRUE;
+
+    OS_GetDeadline(ticks, &deadline);
+    pthread_mutex_lock(&queue->mutex);
+    while((queue->count == queue->length) && (retVal == pdTRUE))
+    {
+        if((ticks == 0) || (pthread_cond_timedwait(&queue->notfull, &queue->mutex, &deadline) == ETIMEDOUT))
+        {
+            retVal = pdFALSE;
+        }
+    }
+    if(retVal == pdTRUE)
+    {
+        memcpy(queue->items + (((queue->head + queue->count) % queue->length) * queue->itemsize), item, queue->itemsize);
+        queue->count++;
+        pthread_cond_signal(&queue->notempty);
+    }
+    pthread_mutex_unlock(&queue->mutex);
+    return retVal;
+}
+
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void *item, TickType_t ticks) {
+    struct timespec deadline;
+    BaseType_t retVal = pdTRUE;
+
+    OS_GetDeadline(ticks, &deadline);
+    pthread_mutex_lock(&queue->mutex);
+    while((queue->count == 0) && (retVal == pdTRUE))
+    {
+        if((ticks == 0) || (pthread_cond_timedwait(&queue->notempty, &queue->mutex, &deadline) == ETIMEDOUT))
+        {
+            retVal = pdFALSE;
+        }
+    }
+    if(retVal == pdTRUE)
+    {
+        memcpy(item, queue->items + (queue->head * queue->itemsize), queue->itemsize);
+        queue->head = (queue->head + 1) % queue->length;
+        queue->count--;
+        pthread_cond_signal(&queue->notfull);
+    }
+    pthread_mutex_unlock(&queue->mutex);
+    return retVal;
+}
+
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+    UBaseType_t count;
+
+    pthread_mutex_lock(&queue->mutex);
+    count = queue->count;
+    pthread_mutex_unlock(&queue->mutex);
+    return count;
+}
+
+
+void vTaskDelay(TickType_t ticks) {
+    struct timespec delay;
+
+    delay.tv_sec = ticks / 1000;
+    delay.tv_nsec = (long)(ticks % 1000) * 1000000L;
+    nanosleep(&delay, NULL_PTR);
+}
+
+
+TaskHandle_t xTaskGetCurrentTaskHandle(void) {
+    return (TaskHandle_t)(uintptr_t)pthread_self();
+}
+
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    return pdTRUE;
+}
+
+
+uint32_t vPortCheckCriticalSection(void) {
+    return os_critical_nesting;
+}
+
+
+void OS_TaskEnter_Critical(void) {
+    pthread_mutex_lock(&os_critical_mutex);
+    os_critical_nesting++;
+}
+
+
+void OS_TaskExit_Critical(void) {
+    configASSERT(os_critical_nesting > 0);
+    os_critical_nesting--;
+    pthread_mutex_unlock(&os_critical_mutex);
+}
+
+
+uint32_t MCU_GetTimeBase(void) {
+    uint64_t ns = OS_GetTimeNs() % 1000000;
+
+    return (OS_SYSTICK_CYCLES_PER_TICK - 1) - (uint32_t)((ns * OS_SYSTICK_CYCLES_PER_TICK) / 1000000);
+}
+
+
+uint32_t MCU_GetTimeStamp(void) {
+    return (uint32_t)(OS_GetTimeNs() / 1000000);
+}
+
+
+void DIAG_SysMonNotify(DIAG_SYSMON_MODULE_ID_e module_id, uint32_t state) {
+}
+
+
+/**
+ * @brief   sets the reference for the time stamps
+ *
+ * @return  void
+ */
+static void OS_InitStartTime(void) {
+    clock_gettime(CLOCK_MONOTONIC, &os_starttime);
+}
+
+
+/**
+ * @brief   gets the time since the first call of a time function
+ *
+ * @return  time in ns
+ */
+static uint64_t OS_GetTimeNs(void) {
+    struct timespec now;
+
+    pthread_once(&os_starttime_once, OS_InitStartTime);
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return ((uint64_t)(now.tv_sec - os_starttime.tv_sec) * 1000000000ULL) + (uint64_t)now.tv_nsec - (uint64_t)os_starttime.tv_nsec;
+}
+
+
+/**
+ * @brief   gets the absolute CLOCK_REALTIME after the given number of OS ticks for pthread_cond_timedwait()
+ *
+ * @param   ticks       timeout in OS ticks
+ * @param   deadline    absolute time of the timeout
+ *
+ * @return  void
+ */
+static void OS_GetDeadline(TickType_t ticks, struct timespec *deadline) {
+    clock_gettime(CLOCK_REALTIME, deadline);
+    deadline->tv_sec += ticks / 1000;
+    deadline->tv_nsec += (long)(ticks % 1000) * 1000000L;
+    if(deadline->tv_nsec >= 1000000000L)
+    {
+        deadline->tv_sec++;
+        deadline->tv_nsec -= 1000000000L;
+    }
+}
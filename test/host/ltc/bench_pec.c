@@ -0,0 +1,292 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    bench_pec.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup TEST
+ * @prefix  BENCH
+ *
+ * @brief   Host test and benchmark of the LTC PEC calculation
+ *
+ * Compares LTC_pec15_calc(), LTC_pec15_calc6() and LTC_pec15_verify_chain()
+ * (src/module/ltc/ltc_pec.c) with the byte-wise PEC calculation of the LTC
+ * datasheet for random data of all lengths and for daisy-chain receive
+ * buffers with corrupted frames. Afterwards the throughput of the byte-wise
+ * reference and of the implementations is printed in MB/s.
+ *
+ * The exit code is 1 if any result differs from the reference.
+ *
+ */
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "ltc_pec.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * number of random data sets per length
+ */
+#define BENCH_NR_OF_SETS            1000
+
+/**
+ * maximum data length checked with LTC_pec15_calc()
+ */
+#define BENCH_MAX_LENGTH            64
+
+/**
+ * number of LTCs in the simulated daisy-chain
+ */
+#define BENCH_NR_OF_LTC             18
+
+/**
+ * size of the simulated receive buffer: command and command PEC, 8 bytes per LTC
+ */
+#define BENCH_RX_SIZE               (4 + 8*BENCH_NR_OF_LTC)
+
+/**
+ * number of receive buffers checked for the throughput
+ */
+#define BENCH_NR_OF_LOOPS           200000
+
+/*================== Constant and Variable Definitions ====================*/
+
+/**
+ * sink for the benchmark results, keeps the compiler from dropping the loops
+ */
+static volatile uint16_t bench_sink = 0;
+
+/*================== Function Prototypes ==================================*/
+
+static uint16_t BENCH_pec15_reference(uint8_t len, const uint8_t *data);
+static void BENCH_FillChain(uint8_t *rxBuffer, uint16_t nLtc);
+static double BENCH_Now(void);
+static double BENCH_MBps(double seconds, double bytes);
+
+/*================== Function Implementations =============================*/
+
+/**
+ * @brief   byte-wise PEC calculation as given in the LTC datasheet
+ *
+ * @param   len     number of bytes
+ * @param   data    data bytes
+ *
+ * @return  PEC of the data
+ */
+static uint16_t BENCH_pec15_reference(uint8_t len, const uint8_t *data) {
+    uint16_t remainder = 16;
+    uint16_t addr = 0;
+    uint8_t i = 0;
+
+    for (i = 0; i < len; i++) {
+        addr = ((remainder>>7)^data[i])&0xff;
+        remainder = (uint16_t)((remainder<<8)^crc15Table[addr]);
+    }
+    return (uint16_t)(remainder*2);
+}
+
+
+/**
+ * @brief   fills a receive buffer with random frames and their correct PECs
+ *
+ * @param   rxBuffer    receive buffer of (4 + 8*nLtc) bytes
+ * @param   nLtc        number of LTCs in the daisy-chain
+ */
+static void BENCH_FillChain(uint8_t *rxBuffer, uint16_t nLtc) {
+    uint8_t *frame = rxBuffer + 4;
+    uint16_t pec = 0;
+    uint16_t i = 0;
+    uint16_t j = 0;
+
+    for (i = 0; i < 4; i++) {
+        rxBuffer[i] = (uint8_t)rand();
+    }
+    for (i = 0; i < nLtc; i++) {
+        for (j = 0; j < 6; j++) {
+            frame[j] = (uint8_t)rand();
+        }
+        pec = BENCH_pec15_reference(6, frame);
+        frame[6] = (uint8_t)(pec>>8);
+        frame[7] = (uint8_t)pec;
+        frame += 8;
+    }
+}
+
+
+/**
+ * @brief   monotonic time in s
+ */
+static double BENCH_Now(void) {
+    struct timespec ts;
+
+    (void)clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec*1e-9;
+}
+
+
+/**
+ * @brief   throughput in MB/s, 0 if the time was too short to measure
+ */
+static double BENCH_MBps(double seconds, double bytes) {
+    return (seconds > 0.0) ? bytes/seconds/1e6 : 0.0;
+}
+
+
+int main(void) {
+    uint8_t data[BENCH_MAX_LENGTH];
+    uint8_t rxBuffer[BENCH_RX_SIZE];
+    uint8_t errorBitmap[(BENCH_NR_OF_LTC+7)/8];
+    uint8_t expected[(BENCH_NR_OF_LTC+7)/8];
+    uint16_t reference = 0;
+    uint16_t pec = 0;
+    uint32_t len = 0;
+    uint32_t set = 0;
+    uint32_t i = 0;
+    uint16_t ltc = 0;
+    STD_RETURN_TYPE_e retVal = E_OK;
+    uint32_t nr_of_checks = 0;
+    uint32_t nr_of_failures = 0;
+    double start = 0.0;
+    double bytes = 0.0;
+    double t_reference = 0.0;
+    double t_calc = 0.0;
+    double t_calc6 = 0.0;
+    double t_chain = 0.0;
+
+    srand(1);
+
+    // LTC_pec15_calc() and LTC_pec15_calc6() against the reference
+    for (len = 0; len <= BENCH_MAX_LENGTH; len++) {
+        for (set = 0; set < BENCH_NR_OF_SETS; set++) {
+            for (i = 0; i < len; i++) {
+                data[i] = (uint8_t)rand();
+            }
+            reference = BENCH_pec15_reference((uint8_t)len, data);
+            pec = LTC_pec15_calc((uint8_t)len, data);
+            nr_of_checks++;
+            if (pec != reference) {
+                if (nr_of_failures < 10) {
+                    printf("LTC_pec15_calc(%u): 0x%04X, reference 0x%04X\n",
+                            (unsigned int)len, (unsigned int)pec, (unsigned int)reference);
+                }
+                nr_of_failures++;
+            }
+            if (len == 6) {
+                pec = LTC_pec15_calc6(data);
+                nr_of_checks++;
+                if (pec != reference) {
+                    if (nr_of_failures < 10) {
+                        printf("LTC_pec15_calc6(): 0x%04X, reference 0x%04X\n",
+                                (unsigned int)pec, (unsigned int)reference);
+                    }
+                    nr_of_failures++;
+                }
+            }
+        }
+    }
+
+    // LTC_pec15_verify_chain() with one random bit flipped in some of the frames
+    for (set = 0; set < BENCH_NR_OF_SETS; set++) {
+        BENCH_FillChain(rxBuffer, BENCH_NR_OF_LTC);
+        memset(expected, 0, sizeof(expected));
+        memset(errorBitmap, (set & 1) ? 0xFF : 0x00, sizeof(errorBitmap));  // all bits must be written
+        for (ltc = 0; ltc < BENCH_NR_OF_LTC; ltc++) {
+            if ((rand() % 4) == 0) {
+                i = 4 + 8*ltc + (uint32_t)(rand() % 8);
+                rxBuffer[i] ^= (uint8_t)(1u<<(rand() % 8));
+                expected[ltc>>3] |= (uint8_t)(1u<<(ltc&7));
+            }
+        }
+        retVal = LTC_pec15_verify_chain(rxBuffer, BENCH_NR_OF_LTC, errorBitmap);
+        nr_of_checks++;
+        for (ltc = 0; ltc < BENCH_NR_OF_LTC; ltc++) {
+            if ((errorBitmap[ltc>>3] & (1u<<(ltc&7))) != (expected[ltc>>3] & (1u<<(ltc&7)))) {
+                if (nr_of_failures < 10) {
+                    printf("LTC_pec15_verify_chain(): set %u, LTC %u wrongly reported\n",
+                            (unsigned int)set, (unsigned int)ltc);
+                }
+                nr_of_failures++;
+            }
+        }
+        for (i = 0; i < sizeof(expected); i++) {
+            if (expected[i] != 0) {
+                break;
+            }
+        }
+        if ((retVal == E_OK) != (i == sizeof(expected))) {
+            if (nr_of_failures < 10) {
+                printf("LTC_pec15_verify_chain(): set %u, wrong return value\n", (unsigned int)set);
+            }
+            nr_of_failures++;
+        }
+    }
+
+    // throughput on the frames of a receive buffer
+    BENCH_FillChain(rxBuffer, BENCH_NR_OF_LTC);
+    bytes = (double)BENCH_NR_OF_LOOPS*BENCH_NR_OF_LTC*6;
+
+    start = BENCH_Now();
+    for (i = 0; i < BENCH_NR_OF_LOOPS; i++) {
+        for (ltc = 0; ltc < BENCH_NR_OF_LTC; ltc++) {
+            bench_sink ^= BENCH_pec15_reference(6, &rxBuffer[4 + 8*ltc]);
+        }
+    }
+    t_reference = BENCH_Now() - start;
+
+    start = BENCH_Now();
+    for (i = 0; i < BENCH_NR_OF_LOOPS; i++) {
+        for (ltc = 0; ltc < BENCH_NR_OF_LTC; ltc++) {
+            bench_sink ^= LTC_pec15_calc(6, &rxBuffer[4 + 8*ltc]);
+        }
+    }
+    t_calc = BENCH_Now() - start;
+
+    start = BENCH_Now();
+    for (i = 0; i < BENCH_NR_OF_LOOPS; i++) {
+        for (ltc = 0; ltc < BENCH_NR_OF_LTC; ltc++) {
+            bench_sink ^= LTC_pec15_calc6(&rxBuffer[4 + 8*ltc]);
+        }
+    }
+    t_calc6 = BENCH_Now() - start;
+
+    start = BENCH_Now();
+    for (i = 0; i < BENCH_NR_OF_LOOPS; i++) {
+        bench_sink ^= (uint16_t)LTC_pec15_verify_chain(rxBuffer, BENCH_NR_OF_LTC, errorBitmap);
+    }
+    t_chain = BENCH_Now() - start;
+
+    printf("checks:                    %u\n", (unsigned int)nr_of_checks);
+    printf("failures:                  %u\n", (unsigned int)nr_of_failures);
+    printf("byte-wise reference:       %8.1f MB/s\n", BENCH_MBps(t_reference, bytes));
+    printf("LTC_pec15_calc(6, ...):    %8.1f MB/s\n", BENCH_MBps(t_calc, bytes));
+    printf("LTC_pec15_calc6():         %8.1f MB/s\n", BENCH_MBps(t_calc6, bytes));
+    printf("LTC_pec15_verify_chain():  %8.1f MB/s\n", BENCH_MBps(t_chain, bytes));
+
+    return (nr_of_failures == 0) ? 0 : 1;
+}
@@ -0,0 +1,113 @@
+/**
+ *
+ * @copyright &copy; 2010 - 2018, Fraunhofer-Gesellschaft zur Foerderung der angewandten Forschung e.V. All rights reserved.
+ *
+ * BSD 3-Clause License
+ * Redistribution and use in source and binary forms, with or without modification, are permitted provided that the following conditions are met:
+ * 1.  Redistributions of source code must retain the above copyright notice, this list of conditions and the following disclaimer.
+ * 2.  Redistributions in binary form must reproduce the above copyright notice, this list of conditions and the following disclaimer in the documentation and/or other materials provided with the distribution.
+ * 3.  Neither the name of the copyright holder nor the names of its contributors may be used to endorse or promote products derived from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * We kindly request you to use one or more of the following phrases to refer to foxBMS in your hardware, software, documentation or advertising materials:
+ *
+ * &Prime;This product uses parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product includes parts of foxBMS&reg;&Prime;
+ *
+ * &Prime;This product is derived from foxBMS&reg;&Prime;
+ *
+ */
+
+/**
+ * @file    test_ltc_conv.c
+ * @author  foxBMS Team
+ * @date    18.10.2026 (date of creation)
+ * @ingroup TEST
+ * @prefix  TEST
+ *
+ * @brief   Exhaustive test of the conversion of raw LTC values to mV on the host
+ *
+ * Compares LTC_CONVERT_RAW_TO_MV() with the floating point conversion it
+ * replaced, (uint16_t)((float)raw*100e-6*1000.0), for all 65536 raw values.
+ * Both are measured against the exact value raw*0.1mV. The results are not
+ * bit-identical: the floating point conversion truncates, the integer
+ * conversion rounds to the nearest mV.
+ *
+ * The exit code is 1 if the integer conversion is further from the exact
+ * value than the floating point conversion for any raw value or if its
+ * error exceeds 0.5mV.
+ *
+ */
+
+/*================== Includes =============================================*/
+#include "general.h"
+#include "ltc_conv.h"
+
+#include <math.h>
+#include <stdio.h>
+
+/*================== Macros and Definitions ===============================*/
+
+/**
+ * maximum error of the integer conversion in mV
+ */
+#define TEST_MAX_ERROR_MV           0.5
+
+/*================== Constant and Variable Definitions ====================*/
+
+/*================== Function Prototypes ==================================*/
+
+/*================== Function Implementations =============================*/
+
+int main(void) {
+
+    uint32_t raw = 0;
+    uint16_t val_ui = 0;
+    uint16_t voltage_int = 0;
+    uint16_t voltage_float = 0;
+    double exact = 0.0;
+    double error_int = 0.0;
+    double error_float = 0.0;
+    double maxerror_int = 0.0;
+    double maxerror_float = 0.0;
+    uint32_t nr_of_differences = 0;
+    uint32_t nr_of_failures = 0;
+
+    for (raw=0; raw <= UINT16_MAX; raw++) {
+        val_ui = (uint16_t)raw;
+        exact = (double)val_ui*0.1;
+        voltage_int = LTC_CONVERT_RAW_TO_MV(val_ui);
+        voltage_float = (uint16_t)(((float)(val_ui))*100e-6*1000.0);
+
+        error_int = fabs((double)voltage_int - exact);
+        error_float = fabs((double)voltage_float - exact);
+        if (error_int > maxerror_int) {
+            maxerror_int = error_int;
+        }
+        if (error_float > maxerror_float) {
+            maxerror_float = error_float;
+        }
+        if (voltage_int != voltage_float) {
+            nr_of_differences++;
+        }
+
+        // a small tolerance, exact is not representable for most raw values
+        if (error_int > error_float + 1e-9 || error_int > TEST_MAX_ERROR_MV + 1e-9) {
+            if (nr_of_failures < 10) {
+                printf("raw %u: integer %u mV, float %u mV, exact %.1f mV\n",
+                        (unsigned int)val_ui, (unsigned int)voltage_int, (unsigned int)voltage_float, exact);
+            }
+            nr_of_failures++;
+        }
+    }
+
+    printf("raw values:            %u\n", (unsigned int)raw);
+    printf("different results:     %u\n", (unsigned int)nr_of_differences);
+    printf("max error integer:     %.2f mV\n", maxerror_int);
+    printf("max error float:       %.2f mV\n", maxerror_float);
+    printf("failures:              %u\n", (unsigned int)nr_of_failures);
+
+    return (nr_of_failures == 0) ? 0 : 1;
+}